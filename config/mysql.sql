@@ -49,7 +49,7 @@ CREATE TABLE `mt_internal_setting` (
   `value` varchar(255) NOT NULL,
   PRIMARY KEY  (`key`)
 ) ENGINE=MyISAM CHARSET=utf8;
-INSERT INTO `mt_internal_setting` VALUES ('db_version','5');
+INSERT INTO `mt_internal_setting` VALUES ('db_version','6');
 CREATE TABLE `mt_autoscan` (
   `id` int(11) NOT NULL auto_increment,
   `obj_id` int(11) default NULL,
@@ -72,8 +72,10 @@ CREATE TABLE `mt_metadata` (
   `item_id` int(11) NOT NULL,
   `property_name` varchar(255) NOT NULL,
   `property_value` text NOT NULL,
+  `property_sort_key` bigint(20) default NULL,
   PRIMARY KEY `id` (`id`),
   KEY `metadata_item_id` (`item_id`),
+  KEY `metadata_sort_key` (`property_name`,`property_sort_key`),
   CONSTRAINT `mt_metadata_idfk1` FOREIGN KEY (`item_id`) REFERENCES `mt_cds_object` (`id`) ON DELETE CASCADE ON UPDATE CASCADE
 ) ENGINE=MyISAM CHARSET=utf8;
 /*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
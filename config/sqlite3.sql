@@ -32,7 +32,7 @@ CREATE TABLE "mt_internal_setting" (
   "key" varchar(40) primary key NOT NULL,
   "value" varchar(255) NOT NULL
 );
-INSERT INTO "mt_internal_setting" VALUES('db_version', '5');
+INSERT INTO "mt_internal_setting" VALUES('db_version', '6');
 CREATE TABLE "mt_autoscan" (
   "id" integer primary key,
   "obj_id" integer default NULL,
@@ -53,6 +53,7 @@ CREATE TABLE "mt_metadata" (
   "item_id" integer NOT NULL,
   "property_name" varchar(255) NOT NULL,
   "property_value" text NOT NULL,
+  "property_sort_key" integer default NULL,
   CONSTRAINT "mt_metadata_idfk1" FOREIGN KEY ("item_id") REFERENCES "mt_cds_object" ("id") ON DELETE CASCADE ON UPDATE CASCADE
 );
 CREATE INDEX mt_cds_object_ref_id ON mt_cds_object(ref_id);
@@ -64,4 +65,5 @@ CREATE INDEX mt_internal_setting_key ON mt_internal_setting(key);
 CREATE UNIQUE INDEX mt_autoscan_obj_id ON mt_autoscan(obj_id);
 CREATE INDEX mt_cds_object_service_id ON mt_cds_object(service_id);
 CREATE INDEX mt_metadata_item_id ON mt_metadata(item_id);
+CREATE INDEX mt_metadata_sort_key ON mt_metadata(property_name,property_sort_key);
 COMMIT;
@@ -9,6 +9,7 @@ const editLoadMock = new MockResponder('edit_load');
 const filesMock = new MockResponder('files');
 const itemsMock = new MockResponder('items');
 const removeMock = new MockResponder('remove');
+const streamsMock = new MockResponder('streams');
 const voidMock = new MockResponder('void');
 
 module.exports = function (app) {
@@ -44,6 +45,9 @@ module.exports = function (app) {
       case 'remove':
         res.send(require(removeMock.getResponse(req.query.object_id, req.query.all)));
         break;
+      case 'streams':
+        res.send(require(streamsMock.getResponse()));
+        break;
       case 'void':
         res.send(require(voidMock.getResponse((req.query.updates || ''))));
         break;
@@ -2,6 +2,7 @@ import {Items} from "../../../web/js/gerbera-items.module";
 import {GerberaApp} from '../../../web/js/gerbera-app.module';
 import {Updates} from "../../../web/js/gerbera-updates.module";
 import {Menu} from '../../../web/js/gerbera-menu.module';
+import {Streams} from '../../../web/js/gerbera-streams.module';
 import {Tree} from "../../../web/js/gerbera-tree.module";
 import {Trail} from "../../../web/js/gerbera-trail.module";
 import mockConfig from './fixtures/config';
@@ -15,6 +16,8 @@ describe('Gerbera Menu', () => {
       fixture.setBase('test/client/fixtures');
       fixture.load('index.html');
       spyOn(Updates, 'getUpdates');
+      spyOn(Streams, 'start');
+      spyOn(Streams, 'stop');
       ajaxSpy = spyOn($, 'ajax');
       GerberaApp.serverConfig = mockConfig.config;
     });
@@ -71,6 +74,25 @@ describe('Gerbera Menu', () => {
       expect(Tree.destroy).toHaveBeenCalled();
       expect(Trail.destroy).toHaveBeenCalled();
     });
+
+    it('on click of home menu, starts polling the streams', async () => {
+      spyOn(GerberaApp, 'isLoggedIn').and.returnValue(true);
+
+      await Menu.initialize();
+      $('#nav-home').click();
+
+      expect(Streams.start).toHaveBeenCalled();
+    });
+
+    it('on click of Database stops polling the streams', async () => {
+      spyOn(Tree, 'selectType');
+      spyOn(GerberaApp, 'isLoggedIn').and.returnValue(true);
+
+      await Menu.initialize();
+      $('#nav-db').click();
+
+      expect(Streams.stop).toHaveBeenCalled();
+    });
   });
   describe('disable()', () => {
     beforeEach(() => {
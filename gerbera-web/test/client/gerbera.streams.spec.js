@@ -0,0 +1,76 @@
+import {Streams} from "../../../web/js/gerbera-streams.module";
+import {Auth} from "../../../web/js/gerbera-auth.module";
+import {GerberaApp} from "../../../web/js/gerbera-app.module";
+import streamsList from './fixtures/streams-list';
+
+describe('Gerbera Streams', () => {
+  'use strict';
+
+  beforeEach(() => {
+    fixture.setBase('test/client/fixtures');
+    fixture.load('index.html');
+  });
+
+  afterEach(() => {
+    fixture.cleanup();
+  });
+
+  describe('loadStreams()', () => {
+    let ajaxSpy;
+
+    beforeEach(() => {
+      ajaxSpy = spyOn($, 'ajax').and.callFake(() => {
+        return Promise.resolve(streamsList);
+      });
+    });
+
+    afterEach(() => {
+      ajaxSpy.and.callThrough();
+    });
+
+    it('calls the server for the list of streams', async () => {
+      spyOn(Auth, 'getSessionId').and.returnValue('SESSION_ID');
+      spyOn(GerberaApp, 'isLoggedIn').and.returnValue(true);
+      spyOn(Streams, 'showStreams');
+
+      await Streams.loadStreams();
+
+      expect(ajaxSpy.calls.count()).toBe(1);
+      expect(ajaxSpy.calls.mostRecent().args[0].data).toEqual({
+        req_type: 'streams',
+        sid: 'SESSION_ID'
+      });
+      expect(Streams.showStreams).toHaveBeenCalledWith(streamsList);
+    });
+
+    it('does not call the server when logged out', async () => {
+      spyOn(GerberaApp, 'isLoggedIn').and.returnValue(false);
+
+      await Streams.loadStreams();
+
+      expect(ajaxSpy.calls.count()).toBe(0);
+    });
+  });
+
+  describe('showStreams()', () => {
+    it('lists every stream with its rate', async () => {
+      await Streams.showStreams(streamsList);
+
+      const rows = $('#streams tbody tr');
+      expect(rows.length).toBe(2);
+      expect(rows.eq(0).children('td').eq(0).text()).toBe('192.168.1.20');
+      expect(rows.eq(0).children('td').eq(1).text()).toBe('Big Buck Bunny');
+      expect(rows.eq(0).children('td').eq(2).text()).toBe('50.0 MiB');
+      expect(rows.eq(0).children('td').eq(3).text()).toBe('10.0 Mbit/s');
+      expect($('#streams').css('display')).not.toBe('none');
+    });
+
+    it('hides the list when nothing is streamed', async () => {
+      await Streams.showStreams(streamsList);
+      await Streams.showStreams({success: true, streams: {stream: []}});
+
+      expect($('#streams tbody tr').length).toBe(0);
+      expect($('#streams').css('display')).toBe('none');
+    });
+  });
+});
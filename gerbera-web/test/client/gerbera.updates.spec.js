@@ -343,6 +343,53 @@ describe('Gerbera Updates', function () {
       Updates.addTaskInterval();
     });
   });
+  describe('waitForUpdates()', () => {
+    let ajaxSpy;
+
+    beforeEach(() => {
+      spyOn(Auth, 'getSessionId').and.returnValue('SESSION_ID');
+      spyOn(GerberaApp, 'isLoggedIn').and.returnValue(true);
+      spyOn(GerberaApp, 'getType').and.returnValue('db');
+      spyOn(window, 'setTimeout');
+      spyOn(Updates, 'updateTreeByIds');
+      GerberaApp.serverConfig = {'poll-interval': 2000, 'long-poll-timeout': 30};
+    });
+
+    afterEach(() => {
+      GerberaApp.serverConfig = {};
+    });
+
+    it('does not wait when long polling is disabled', async () => {
+      ajaxSpy = spyOn($, 'ajax');
+      GerberaApp.serverConfig = {'poll-interval': 2000, 'long-poll-timeout': 0};
+
+      await Updates.waitForUpdates();
+
+      expect(ajaxSpy).not.toHaveBeenCalled();
+    });
+
+    it('waits for updates and reloads the changed containers', async () => {
+      ajaxSpy = spyOn($, 'ajax').and.returnValue(Promise.resolve(updateIds));
+
+      await Updates.waitForUpdates();
+
+      expect(ajaxSpy.calls.mostRecent().args[0]['data']).toEqual({
+        req_type: 'void',
+        sid: 'SESSION_ID',
+        updates: 'wait'
+      });
+      expect(Updates.updateTreeByIds).toHaveBeenCalledWith(updateIds);
+      expect(window.setTimeout).toHaveBeenCalledWith(Updates.waitForUpdates, 0);
+    });
+
+    it('waits the poll interval when the server is busy', async () => {
+      ajaxSpy = spyOn($, 'ajax').and.returnValue(Promise.resolve(updatesWithPendingUpdates));
+
+      await Updates.waitForUpdates();
+
+      expect(window.setTimeout).toHaveBeenCalledWith(Updates.waitForUpdates, 2000);
+    });
+  });
   describe('updateTreeByIds()', () => {
     let response;
 
@@ -226,6 +226,8 @@ void AutoscanInotify::threadProc()
                         if (mask & IN_ISDIR)
                             monitorUnmonitorRecursive(path, false, adir, false);
                     }
+                    if (!(mask & (IN_ISDIR | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)))
+                        content->updateSidecars(path);
                 }
                 if (mask & IN_IGNORED) {
                     removeWatchMoves(wd);
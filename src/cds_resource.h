@@ -48,6 +48,10 @@
 
 #define RESOURCE_OPTION_FOURCC "4cc"
 
+/// \brief location of the file behind a resource, i.e. a sidecar file that
+/// was found next to the item
+#define RESOURCE_OPTION_PATH "pth"
+
 class CdsResource {
 protected:
     int handlerType;
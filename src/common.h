@@ -68,6 +68,7 @@
 #define D_HTTP_TRANSFER_MODE_STREAMING "Streaming"
 #define D_HTTP_TRANSFER_MODE_INTERACTIVE "Interactive"
 #define D_HTTP_CONTENT_FEATURES_HEADER "contentFeatures.dlna.org"
+#define D_HTTP_TIME_SEEK_RANGE_HEADER "TimeSeekRange.dlna.org"
 
 #define D_PROFILE "DLNA.ORG_PN"
 #define D_CONVERSION_INDICATOR "DLNA.ORG_CI"
@@ -166,14 +167,16 @@
 // connection manager
 #define DESC_CM_SERVICE_TYPE "urn:schemas-upnp-org:service:ConnectionManager:1"
 #define DESC_CM_SERVICE_ID "urn:upnp-org:serviceId:ConnectionManager"
-#define DESC_CM_SCPD_URL "cm.xml"
+#define DESC_CM_SCPD_FILE "cm.xml"
+#define DESC_CM_SCPD_URL "/" SERVER_VIRTUAL_DIR "/" DESC_CM_SCPD_FILE
 #define DESC_CM_CONTROL_URL "/upnp/control/cm"
 #define DESC_CM_EVENT_URL "/upnp/event/cm"
 
 // content directory
 #define DESC_CDS_SERVICE_TYPE "urn:schemas-upnp-org:service:ContentDirectory:1"
 #define DESC_CDS_SERVICE_ID "urn:upnp-org:serviceId:ContentDirectory"
-#define DESC_CDS_SCPD_URL "cds.xml"
+#define DESC_CDS_SCPD_FILE "cds.xml"
+#define DESC_CDS_SCPD_URL "/" SERVER_VIRTUAL_DIR "/" DESC_CDS_SCPD_FILE
 #define DESC_CDS_CONTROL_URL "/upnp/control/cds"
 #define DESC_CDS_EVENT_URL "/upnp/event/cds"
 
@@ -193,7 +196,8 @@
 // media receiver registrar (xbox 360)
 #define DESC_MRREG_SERVICE_TYPE "urn:microsoft.com:service:X_MS_MediaReceiverRegistrar:1"
 #define DESC_MRREG_SERVICE_ID "urn:microsoft.com:serviceId:X_MS_MediaReceiverRegistrar"
-#define DESC_MRREG_SCPD_URL "mr_reg.xml"
+#define DESC_MRREG_SCPD_FILE "mr_reg.xml"
+#define DESC_MRREG_SCPD_URL "/" SERVER_VIRTUAL_DIR "/" DESC_MRREG_SCPD_FILE
 #define DESC_MRREG_CONTROL_URL "/upnp/control/mr_reg"
 #define DESC_MRREG_EVENT_URL "/upnp/event/mr_reg"
 
@@ -220,6 +224,8 @@
 #define DEFAULT_UI_SHOW_TOOLTIPS_VALUE YES
 #define DEFAULT_POLL_WHEN_IDLE_VALUE NO
 #define DEFAULT_POLL_INTERVAL 2
+#define DEFAULT_LONG_POLL_TIMEOUT 30
+#define DEFAULT_MAX_LONG_POLLS 4
 #define DEFAULT_ACCOUNTS_EN_VALUE NO
 #define DEFAULT_ACCOUNT_USER "gerbera"
 #define DEFAULT_ACCOUNT_PASSWORD "gerbera"
@@ -236,6 +242,22 @@
 #define DEFAULT_JS_DIR "js"
 #define DEFAULT_HIDDEN_FILES_VALUE NO
 #define DEFAULT_UPNP_STRING_LIMIT (-1)
+#define DEFAULT_BLOCK_IO_ENABLED NO
+#define DEFAULT_BLOCK_IO_MIN_SIZE 16777216
+#define DEFAULT_BLOCK_IO_BLOCK_SIZE 1048576
+#define MIN_BLOCK_IO_BLOCK_SIZE 65536
+#define DEFAULT_RESOURCE_CACHE_ENABLED YES
+#define DEFAULT_RESOURCE_CACHE_MEMORY_SIZE 8388608
+#define DEFAULT_RESOURCE_CACHE_DISK_SIZE 67108864
+#define DEFAULT_RESOURCE_CACHE_DIR "resource-cache"
+#define DEFAULT_RESOURCE_CACHE_MAX_AGE 3600
+#define MIME_CACHE_ENTRIES 10000
+#define DEFAULT_BANDWIDTH_TOTAL_RATE 0
+#define DEFAULT_BANDWIDTH_CLIENT_RATE 0
+#define DEFAULT_BANDWIDTH_BURST 1048576
+#define DEFAULT_SCALED_IMAGES_ENABLED YES
+#define DEFAULT_SCALED_IMAGES_QUALITY 85
+#define DEFAULT_SCALED_IMAGES_PREGENERATE NO
 #define DEFAULT_SESSION_TIMEOUT 30
 #define SESSION_TIMEOUT_CHECK_INTERVAL (5 * 60)
 #define DEFAULT_PRES_URL_APPENDTO_ATTR "none"
@@ -262,6 +284,15 @@
 #define CFG_DEFAULT_UPDATE_AT_START 10 // seconds
 #endif
 #define DEFAULT_TRANSCODING_ENABLED NO
+#define DEFAULT_TRANSCODING_OUTPUT "pipe"
+#define DEFAULT_TRANSCODING_CACHE_ENABLED NO
+#define DEFAULT_TRANSCODING_CACHE_SIZE 4096 // MiB
+#define DEFAULT_TRANSCODING_CACHE_DIR "transcode-cache"
+#define DEFAULT_TRANSCODING_MAX_JOBS 0
+#define DEFAULT_TRANSCODING_QUEUE 8
+#define DEFAULT_TRANSCODING_QUEUE_TIMEOUT 10
+#define DEFAULT_TRANSCODING_NICE 0
+#define DEFAULT_TRANSCODING_IO_CLASS "none"
 #define DEFAULT_AUDIO_BUFFER_SIZE 1048576
 #define DEFAULT_AUDIO_CHUNK_SIZE 131072
 #define DEFAULT_AUDIO_FILL_SIZE 262144
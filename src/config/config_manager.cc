@@ -391,6 +391,22 @@ void ConfigManager::load(const fs::path& filename, const fs::path& userHome)
     NEW_INT_OPTION(temp_int);
     SET_INT_OPTION(CFG_SERVER_UI_POLL_INTERVAL);
 
+    temp_int = getIntOption("/server/ui/attribute::long-poll-timeout",
+        DEFAULT_LONG_POLL_TIMEOUT);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter for "
+                                 "<ui long-poll-timeout=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_UI_LONG_POLL_TIMEOUT);
+
+    temp_int = getIntOption("/server/ui/attribute::max-long-polls",
+        DEFAULT_MAX_LONG_POLLS);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter for "
+                                 "<ui max-long-polls=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_UI_MAX_LONG_POLLS);
+
     temp_int = getIntOption("/server/ui/items-per-page/attribute::default",
         DEFAULT_ITEMS_PER_PAGE_2);
     if (temp_int < 1)
@@ -722,6 +738,99 @@ void ConfigManager::load(const fs::path& filename, const fs::path& userHome)
     NEW_INT_OPTION(temp_int);
     SET_INT_OPTION(CFG_SERVER_UPNP_TITLE_AND_DESC_STRING_LIMIT);
 
+    temp = getOption("/server/block-io/attribute::enabled",
+        DEFAULT_BLOCK_IO_ENABLED);
+    if (!validateYesNo(temp))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <block-io enabled=\"\" /> attribute");
+    NEW_BOOL_OPTION(temp == "yes");
+    SET_BOOL_OPTION(CFG_SERVER_BLOCK_IO_ENABLED);
+
+    temp_int = getIntOption("/server/block-io/attribute::min-size",
+        DEFAULT_BLOCK_IO_MIN_SIZE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <block-io min-size=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_BLOCK_IO_MIN_SIZE);
+
+    temp_int = getIntOption("/server/block-io/attribute::block-size",
+        DEFAULT_BLOCK_IO_BLOCK_SIZE);
+    if (temp_int < MIN_BLOCK_IO_BLOCK_SIZE)
+        throw std::runtime_error(fmt::format("Error in config file: incorrect parameter "
+                                             "for <block-io block-size=\"\" /> attribute, "
+                                             "must be at least {}",
+            MIN_BLOCK_IO_BLOCK_SIZE));
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_BLOCK_IO_BLOCK_SIZE);
+
+    tmpEl = getElement("/server/block-io");
+    NEW_STRARR_OPTION(createArrayFromNode(tmpEl, "mimetype", "prefix"));
+    SET_STRARR_OPTION(CFG_SERVER_BLOCK_IO_MIMETYPE_LIST);
+
+    temp = getOption("/server/resource-cache/attribute::enabled",
+        DEFAULT_RESOURCE_CACHE_ENABLED);
+    if (!validateYesNo(temp))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <resource-cache enabled=\"\" /> attribute");
+    NEW_BOOL_OPTION(temp == "yes");
+    SET_BOOL_OPTION(CFG_SERVER_RESOURCE_CACHE_ENABLED);
+
+    temp_int = getIntOption("/server/resource-cache/attribute::memory-size",
+        DEFAULT_RESOURCE_CACHE_MEMORY_SIZE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <resource-cache memory-size=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_RESOURCE_CACHE_MEMORY_SIZE);
+
+    temp_int = getIntOption("/server/resource-cache/attribute::disk-size",
+        DEFAULT_RESOURCE_CACHE_DISK_SIZE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <resource-cache disk-size=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_RESOURCE_CACHE_DISK_SIZE);
+
+    temp = getOption("/server/resource-cache/attribute::dir",
+        DEFAULT_RESOURCE_CACHE_DIR);
+    if (!temp.empty() && temp.front() != '/')
+        temp = fs::path(getOption(CFG_SERVER_HOME)) / temp;
+    NEW_OPTION(temp);
+    SET_OPTION(CFG_SERVER_RESOURCE_CACHE_DIR);
+
+    temp_int = getIntOption("/server/resource-cache/attribute::max-age",
+        DEFAULT_RESOURCE_CACHE_MAX_AGE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <resource-cache max-age=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_RESOURCE_CACHE_MAX_AGE);
+
+    temp_int = getIntOption("/server/bandwidth/attribute::total-rate",
+        DEFAULT_BANDWIDTH_TOTAL_RATE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <bandwidth total-rate=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_BANDWIDTH_TOTAL_RATE);
+
+    temp_int = getIntOption("/server/bandwidth/attribute::client-rate",
+        DEFAULT_BANDWIDTH_CLIENT_RATE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <bandwidth client-rate=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_BANDWIDTH_CLIENT_RATE);
+
+    temp_int = getIntOption("/server/bandwidth/attribute::burst",
+        DEFAULT_BANDWIDTH_BURST);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <bandwidth burst=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_SERVER_BANDWIDTH_BURST);
+
 #ifdef HAVE_JS
     temp = getOption("/import/scripting/playlist-script",
         prefix_dir / DEFAULT_JS_DIR / DEFAULT_PLAYLISTS_SCRIPT);
@@ -900,6 +1009,80 @@ void ConfigManager::load(const fs::path& filename, const fs::path& userHome)
 
 #endif //HAVE_CURL
 
+    temp = getOption("/transcoding/attribute::output",
+        DEFAULT_TRANSCODING_OUTPUT);
+    if (temp != "pipe" && temp != "fifo")
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <transcoding output=\"\"> attribute, "
+                                 "allowed values are pipe and fifo");
+    NEW_OPTION(temp);
+    SET_OPTION(CFG_TRANSCODING_OUTPUT);
+
+    temp = getOption("/transcoding/cache/attribute::enabled",
+        DEFAULT_TRANSCODING_CACHE_ENABLED);
+    if (!validateYesNo(temp))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <cache enabled=\"\" /> attribute");
+    NEW_BOOL_OPTION(temp == "yes");
+    SET_BOOL_OPTION(CFG_TRANSCODING_CACHE_ENABLED);
+
+    temp_int = getIntOption("/transcoding/cache/attribute::size",
+        DEFAULT_TRANSCODING_CACHE_SIZE);
+    if (temp_int <= 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <cache size=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_TRANSCODING_CACHE_SIZE);
+
+    temp = getOption("/transcoding/cache/attribute::dir",
+        DEFAULT_TRANSCODING_CACHE_DIR);
+    if (!temp.empty() && temp.front() != '/')
+        temp = fs::path(getOption(CFG_SERVER_HOME)) / temp;
+    NEW_OPTION(temp);
+    SET_OPTION(CFG_TRANSCODING_CACHE_DIR);
+
+    temp_int = getIntOption("/transcoding/scheduler/attribute::max-jobs",
+        DEFAULT_TRANSCODING_MAX_JOBS);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scheduler max-jobs=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_TRANSCODING_SCHEDULER_MAX_JOBS);
+
+    temp_int = getIntOption("/transcoding/scheduler/attribute::queue",
+        DEFAULT_TRANSCODING_QUEUE);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scheduler queue=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_TRANSCODING_SCHEDULER_QUEUE);
+
+    temp_int = getIntOption("/transcoding/scheduler/attribute::queue-timeout",
+        DEFAULT_TRANSCODING_QUEUE_TIMEOUT);
+    if (temp_int < 0)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scheduler queue-timeout=\"\" /> attribute");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_TRANSCODING_SCHEDULER_QUEUE_TIMEOUT);
+
+    temp_int = getIntOption("/transcoding/scheduler/attribute::nice",
+        DEFAULT_TRANSCODING_NICE);
+    if (temp_int < 0 || temp_int > 19)
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scheduler nice=\"\" /> attribute, "
+                                 "must be between 0 and 19");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_TRANSCODING_SCHEDULER_NICE);
+
+    temp = getOption("/transcoding/scheduler/attribute::io-class",
+        DEFAULT_TRANSCODING_IO_CLASS);
+    if (temp != "none" && temp != "best-effort" && temp != "idle")
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scheduler io-class=\"\" /> attribute, "
+                                 "allowed values are none, best-effort and idle");
+    NEW_OPTION(temp);
+    SET_OPTION(CFG_TRANSCODING_SCHEDULER_IO_CLASS);
+
     el = getElement("/server/custom-http-headers");
     NEW_STRARR_OPTION(createArrayFromNode(el, "add", "header"));
     SET_STRARR_OPTION(CFG_SERVER_CUSTOM_HTTP_HEADERS);
@@ -916,6 +1099,33 @@ void ConfigManager::load(const fs::path& filename, const fs::path& userHome)
 
 #endif // HAVE_LIBEXIF
 
+#ifdef HAVE_LIBJPEG
+    temp = getOption("/import/scaled-images/attribute::enabled",
+        DEFAULT_SCALED_IMAGES_ENABLED);
+    if (!validateYesNo(temp))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scaled-images enabled=\"\" /> attribute");
+    NEW_BOOL_OPTION(temp == "yes");
+    SET_BOOL_OPTION(CFG_IMPORT_SCALED_IMAGES_ENABLED);
+
+    temp_int = getIntOption("/import/scaled-images/attribute::quality",
+        DEFAULT_SCALED_IMAGES_QUALITY);
+    if ((temp_int < 1) || (temp_int > 100))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scaled-images quality=\"\" /> attribute, "
+                                 "must be between 1 and 100");
+    NEW_INT_OPTION(temp_int);
+    SET_INT_OPTION(CFG_IMPORT_SCALED_IMAGES_QUALITY);
+
+    temp = getOption("/import/scaled-images/attribute::pregenerate",
+        DEFAULT_SCALED_IMAGES_PREGENERATE);
+    if (!validateYesNo(temp))
+        throw std::runtime_error("Error in config file: incorrect parameter "
+                                 "for <scaled-images pregenerate=\"\" /> attribute");
+    NEW_BOOL_OPTION(temp == "yes");
+    SET_BOOL_OPTION(CFG_IMPORT_SCALED_IMAGES_PREGENERATE);
+#endif // HAVE_LIBJPEG
+
 #ifdef HAVE_EXIV2
 
     el = getElement("/import/library-options/exiv2/auxdata");
@@ -1415,7 +1625,7 @@ std::shared_ptr<TranscodingProfileList> ConfigManager::createTranscodingProfileL
 
     auto mtype_profile = element.child("mimetype-profile-mappings");
     if (mtype_profile != nullptr) {
-        for (pugi::xml_node child : element.children()) {
+        for (pugi::xml_node child : mtype_profile.children()) {
             if (std::string(child.name()) == "transcode") {
                 std::string mt = child.attribute("mimetype").as_string();
                 std::string pname = child.attribute("using").as_string();
@@ -1433,7 +1643,7 @@ std::shared_ptr<TranscodingProfileList> ConfigManager::createTranscodingProfileL
     if (profiles == nullptr)
         return list;
 
-    for (pugi::xml_node child : element.children()) {
+    for (pugi::xml_node child : profiles.children()) {
         if (std::string(child.name()) != "profile")
             continue;
 
@@ -1560,6 +1770,24 @@ std::shared_ptr<TranscodingProfileList> ConfigManager::createTranscodingProfileL
             }
         }
 
+        sub = child.child("bitrate");
+        if (sub != nullptr) {
+            param_int = sub.text().as_int();
+            if (param_int <= 0)
+                throw std::runtime_error("Error in config file: incorrect "
+                                         "parameter for <bitrate> tag");
+            prof->setBitrate(param_int);
+        }
+
+        sub = child.child("max-jobs");
+        if (sub != nullptr) {
+            param_int = sub.text().as_int();
+            if (param_int < 0)
+                throw std::runtime_error("Error in config file: incorrect "
+                                         "parameter for <max-jobs> tag");
+            prof->setMaxJobs(param_int);
+        }
+
         sub = child.child("hide-original-resource");
         if (sub != nullptr) {
             param = sub.text().as_string();
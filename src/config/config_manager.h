@@ -72,9 +72,23 @@ typedef enum {
     CFG_SERVER_BOOKMARK_FILE,
     CFG_SERVER_CUSTOM_HTTP_HEADERS,
     CFG_SERVER_UPNP_TITLE_AND_DESC_STRING_LIMIT,
+    CFG_SERVER_BLOCK_IO_ENABLED,
+    CFG_SERVER_BLOCK_IO_MIN_SIZE,
+    CFG_SERVER_BLOCK_IO_BLOCK_SIZE,
+    CFG_SERVER_BLOCK_IO_MIMETYPE_LIST,
+    CFG_SERVER_RESOURCE_CACHE_ENABLED,
+    CFG_SERVER_RESOURCE_CACHE_MEMORY_SIZE,
+    CFG_SERVER_RESOURCE_CACHE_DISK_SIZE,
+    CFG_SERVER_RESOURCE_CACHE_DIR,
+    CFG_SERVER_RESOURCE_CACHE_MAX_AGE,
+    CFG_SERVER_BANDWIDTH_TOTAL_RATE,
+    CFG_SERVER_BANDWIDTH_CLIENT_RATE,
+    CFG_SERVER_BANDWIDTH_BURST,
     CFG_SERVER_UI_ENABLED,
     CFG_SERVER_UI_POLL_INTERVAL,
     CFG_SERVER_UI_POLL_WHEN_IDLE,
+    CFG_SERVER_UI_LONG_POLL_TIMEOUT,
+    CFG_SERVER_UI_MAX_LONG_POLLS,
     CFG_SERVER_UI_ACCOUNTS_ENABLED,
     CFG_SERVER_UI_ACCOUNT_LIST,
     CFG_SERVER_UI_SESSION_TIMEOUT,
@@ -145,6 +159,11 @@ typedef enum {
 #ifdef HAVE_LIBEXIF
     CFG_IMPORT_LIBOPTS_EXIF_AUXDATA_TAGS_LIST,
 #endif
+#ifdef HAVE_LIBJPEG
+    CFG_IMPORT_SCALED_IMAGES_ENABLED,
+    CFG_IMPORT_SCALED_IMAGES_QUALITY,
+    CFG_IMPORT_SCALED_IMAGES_PREGENERATE,
+#endif
 #ifdef HAVE_EXIV2
     CFG_IMPORT_LIBOPTS_EXIV2_AUXDATA_TAGS_LIST,
 #endif
@@ -152,6 +171,15 @@ typedef enum {
     CFG_IMPORT_LIBOPTS_ID3_AUXDATA_TAGS_LIST,
 #endif
     CFG_TRANSCODING_PROFILE_LIST,
+    CFG_TRANSCODING_OUTPUT,
+    CFG_TRANSCODING_CACHE_ENABLED,
+    CFG_TRANSCODING_CACHE_SIZE,
+    CFG_TRANSCODING_CACHE_DIR,
+    CFG_TRANSCODING_SCHEDULER_MAX_JOBS,
+    CFG_TRANSCODING_SCHEDULER_QUEUE,
+    CFG_TRANSCODING_SCHEDULER_QUEUE_TIMEOUT,
+    CFG_TRANSCODING_SCHEDULER_NICE,
+    CFG_TRANSCODING_SCHEDULER_IO_CLASS,
 #ifdef HAVE_CURL
     CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE,
     CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE,
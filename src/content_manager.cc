@@ -29,6 +29,7 @@
 
 /// \file content_manager.cc
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <dirent.h>
@@ -40,11 +41,23 @@
 
 #include "config/config_manager.h"
 #include "content_manager.h"
+#include "iohandler/stream_reactor.h"
+#ifdef HAVE_CURL
+#include "util/curl_handle_pool.h"
+#endif
 #include "layout/fallback_layout.h"
+#include "metadata/image_scale_handler.h"
 #include "metadata/metadata_handler.h"
+#include "metadata/sidecar_handler.h"
 #include "storage/storage.h"
+#include "transcoding/transcode_scheduler.h"
 #include "update_manager.h"
+#include "util/bandwidth_shaper.h"
+#ifdef HAVE_MAGIC
+#include "util/mime_cache.h"
+#endif
 #include "util/process.h"
+#include "util/resource_cache.h"
 #include "util/string_converter.h"
 #include "util/timer.h"
 #include "util/tools.h"
@@ -84,7 +97,8 @@ using namespace std;
 ContentManager::ContentManager(const std::shared_ptr<ConfigManager>& config, const std::shared_ptr<Storage>& storage,
     std::shared_ptr<UpdateManager> update_manager, std::shared_ptr<web::SessionManager> session_manager,
     std::shared_ptr<Timer> timer, std::shared_ptr<TaskProcessor> task_processor,
-    std::shared_ptr<Runtime> scripting_runtime, std::shared_ptr<LastFm> last_fm)
+    std::shared_ptr<Runtime> scripting_runtime, std::shared_ptr<LastFm> last_fm,
+    std::shared_ptr<ResourceCache> resourceCache)
     : config(config)
     , storage(storage)
     , update_manager(std::move(update_manager))
@@ -93,6 +107,7 @@ ContentManager::ContentManager(const std::shared_ptr<ConfigManager>& config, con
     , task_processor(std::move(task_processor))
     , scripting_runtime(std::move(scripting_runtime))
     , last_fm(std::move(last_fm))
+    , resourceCache(std::move(resourceCache))
 {
     ignore_unknown_extensions = false;
     extension_map_case_sensitive = false;
@@ -120,6 +135,19 @@ ContentManager::ContentManager(const std::shared_ptr<ConfigManager>& config, con
 
     mimetype_contenttype_map = config->getDictionaryOption(CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
 
+    transcodeScheduler = std::make_shared<TranscodeScheduler>(config->getIntOption(CFG_TRANSCODING_SCHEDULER_MAX_JOBS),
+        config->getIntOption(CFG_TRANSCODING_SCHEDULER_QUEUE),
+        std::chrono::seconds(config->getIntOption(CFG_TRANSCODING_SCHEDULER_QUEUE_TIMEOUT)));
+    streamReactor = std::make_shared<StreamReactor>();
+    bandwidthShaper = std::make_shared<BandwidthShaper>(config->getIntOption(CFG_SERVER_BANDWIDTH_TOTAL_RATE),
+        config->getIntOption(CFG_SERVER_BANDWIDTH_CLIENT_RATE), config->getIntOption(CFG_SERVER_BANDWIDTH_BURST));
+#ifdef HAVE_CURL
+    curlPool = std::make_shared<CurlHandlePool>();
+#endif
+#ifdef HAVE_MAGIC
+    mimeCache = std::make_shared<MimeCache>(MIME_CACHE_ENTRIES);
+#endif
+
     auto config_timed_list = config->getAutoscanListOption(CFG_IMPORT_AUTOSCAN_TIMED_LIST);
     for (size_t i = 0; i < config_timed_list->size(); i++) {
         auto dir = config_timed_list->get(i);
@@ -362,6 +390,7 @@ void ContentManager::shutdown()
         if (exec != nullptr)
             exec->kill();
     }
+    streamReactor->shutdown();
 
     log_debug("signalling...");
     signal();
@@ -616,6 +645,11 @@ void ContentManager::_rescanDirectory(int containerID, int scanID, ScanMode scan
     // request only items if non-recursive scan is wanted
     unique_ptr<unordered_set<int>> list = storage->getObjects(containerID, !adir->getRecursive());
 
+    // files were added, removed or renamed since the last scan; a deleted
+    // sidecar leaves no file behind that could be noticed
+    struct stat dirStat;
+    bool dirChanged = adir->getPreviousLMT() > 0 && stat(location.c_str(), &dirStat) == 0 && dirStat.st_mtime > adir->getPreviousLMT();
+
     unsigned int thisTaskID;
     if (task != nullptr) {
         thisTaskID = task->getID();
@@ -651,11 +685,18 @@ void ContentManager::_rescanDirectory(int containerID, int scanID, ScanMode scan
         }
 
         if (S_ISREG(statbuf.st_mode)) {
+            // items imported by earlier scans do not know about new sidecars
+            if (adir->getPreviousLMT() > 0 && statbuf.st_mtime > adir->getPreviousLMT())
+                updateSidecars(path);
+
             int objectID = storage->findObjectIDByPath(path);
             if (objectID > 0) {
                 if (list != nullptr)
                     list->erase(objectID);
 
+                if (dirChanged)
+                    refreshSidecars(storage->loadObject(objectID));
+
                 if (scanLevel == ScanLevel::Full) {
                     // check modification time and update file if chagned
                     if (last_modified_current_max < statbuf.st_mtime) {
@@ -974,6 +1015,15 @@ void ContentManager::addObject(const std::shared_ptr<CdsObject>& obj)
     update_manager->containerChanged(obj->getParentID());
     if (IS_CDS_CONTAINER(obj->getObjectType()))
         session_manager->containerChangedUI(obj->getParentID());
+
+#ifdef HAVE_LIBJPEG
+    if (resourceCache != nullptr && IS_CDS_ITEM(obj->getObjectType()) && config->getBoolOption(CFG_IMPORT_SCALED_IMAGES_PREGENERATE)) {
+        auto item = std::static_pointer_cast<CdsItem>(obj);
+        auto resources = item->getResources();
+        if (std::any_of(resources.begin(), resources.end(), [](const auto& res) { return res->getHandlerType() == CH_IMAGE_SCALE; }))
+            addTask(std::make_shared<CMGenerateResourcesTask>(config, resourceCache, item), true);
+    }
+#endif
 }
 
 void ContentManager::addContainer(int parentID, std::string title, const std::string& upnpClass)
@@ -1017,6 +1067,34 @@ void ContentManager::updateObject(const std::shared_ptr<CdsObject>& obj, bool se
     }
 }
 
+void ContentManager::updateSidecars(const fs::path& path)
+{
+    if (!SidecarHandler::isSidecar(path))
+        return;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(path.parent_path(), ec)) {
+        if (!SidecarHandler::isSidecarOf(path, entry.path()))
+            continue;
+
+        auto obj = storage->findObjectByPath(entry.path());
+        if (obj != nullptr)
+            refreshSidecars(obj);
+    }
+}
+
+void ContentManager::refreshSidecars(const std::shared_ptr<CdsObject>& obj)
+{
+    if (!IS_CDS_ITEM(obj->getObjectType()))
+        return;
+
+    auto item = std::static_pointer_cast<CdsItem>(obj);
+    if (SidecarHandler(config).refresh(item)) {
+        log_debug("Updating sidecars of {}", item->getLocation().c_str());
+        updateObject(item);
+    }
+}
+
 std::shared_ptr<CdsObject> ContentManager::convertObject(std::shared_ptr<CdsObject> oldObj, int newType)
 {
     int oldType = oldObj->getObjectType();
@@ -1055,7 +1133,7 @@ std::shared_ptr<CdsObject> ContentManager::createObjectFromFile(const fs::path&
                 if (ignore_unknown_extensions)
                     return nullptr; // item should be ignored
 #ifdef HAVE_MAGIC
-                mimetype = getMIMETypeFromFile(path);
+                mimetype = mimeCache->getMimeType(path, statbuf.st_mtime, statbuf.st_size);
 #endif
             }
         }
@@ -1809,6 +1887,34 @@ void CMRescanDirectoryTask::run()
     }
 }
 
+#ifdef HAVE_LIBJPEG
+CMGenerateResourcesTask::CMGenerateResourcesTask(std::shared_ptr<ConfigManager> config,
+    std::shared_ptr<ResourceCache> resourceCache, std::shared_ptr<CdsItem> item)
+    : GenericTask(ContentManagerTask)
+    , config(std::move(config))
+    , resourceCache(std::move(resourceCache))
+    , item(std::move(item))
+{
+    this->taskType = GenerateResources;
+    this->description = "Scaling image: " + this->item->getLocation().string();
+}
+
+void CMGenerateResourcesTask::run()
+{
+    struct stat statbuf;
+    if (stat(item->getLocation().c_str(), &statbuf) != 0)
+        return;
+
+    ImageScaleHandler handler(config);
+    for (int i = 0; i < item->getResourceCount(); i++) {
+        if (item->getResource(i)->getHandlerType() != CH_IMAGE_SCALE)
+            continue;
+        auto key = ResourceCache::makeKey(item->getLocation(), statbuf.st_mtime, handler.getContentVariant(item, i));
+        resourceCache->getOrCreate(key, [&]() { return handler.serveContent(item, i); });
+    }
+}
+#endif // HAVE_LIBJPEG
+
 #ifdef ONLINE_SERVICES
 CMFetchOnlineContentTask::CMFetchOnlineContentTask(std::shared_ptr<ContentManager> content,
     std::shared_ptr<TaskProcessor> task_processor, std::shared_ptr<Timer> timer,
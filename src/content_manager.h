@@ -76,7 +76,17 @@ class SessionManager;
 class Runtime;
 class LastFm;
 class ContentManager;
+class ResourceCache;
+class StreamReactor;
+class BandwidthShaper;
+#ifdef HAVE_CURL
+class CurlHandlePool;
+#endif
+#ifdef HAVE_MAGIC
+class MimeCache;
+#endif
 class TaskProcessor;
+class TranscodeScheduler;
 
 class CMAddFileTask : public GenericTask, public std::enable_shared_from_this<CMAddFileTask> {
 protected:
@@ -121,6 +131,21 @@ public:
     virtual void run() override;
 };
 
+#ifdef HAVE_LIBJPEG
+/// \brief Renders the scaled image resources of an item into the resource cache.
+class CMGenerateResourcesTask : public GenericTask {
+protected:
+    std::shared_ptr<ConfigManager> config;
+    std::shared_ptr<ResourceCache> resourceCache;
+    std::shared_ptr<CdsItem> item;
+
+public:
+    CMGenerateResourcesTask(std::shared_ptr<ConfigManager> config,
+        std::shared_ptr<ResourceCache> resourceCache, std::shared_ptr<CdsItem> item);
+    void run() override;
+};
+#endif
+
 #ifdef ONLINE_SERVICES
 class CMFetchOnlineContentTask : public GenericTask {
 protected:
@@ -146,7 +171,8 @@ public:
     ContentManager(const std::shared_ptr<ConfigManager>& config, const std::shared_ptr<Storage>& storage,
         std::shared_ptr<UpdateManager> update_manager, std::shared_ptr<web::SessionManager> session_manager,
         std::shared_ptr<Timer> timer, std::shared_ptr<TaskProcessor> task_processor,
-        std::shared_ptr<Runtime> scripting_runtime, std::shared_ptr<LastFm> last_fm);
+        std::shared_ptr<Runtime> scripting_runtime, std::shared_ptr<LastFm> last_fm,
+        std::shared_ptr<ResourceCache> resourceCache);
     void run();
     ~ContentManager() override;
     void shutdown();
@@ -199,6 +225,14 @@ public:
     /// \param parameters key value pairs of fields to be updated
     void updateObject(int objectID, const std::map<std::string, std::string>& parameters);
 
+    /// \brief Updates the items that use a sidecar file, i.e. a subtitle next to a video.
+    /// \param path sidecar file that was added, changed or removed
+    void updateSidecars(const fs::path& path);
+
+    /// \brief Looks up the sidecar files of an item again.
+    /// \param obj item to check, other objects are ignored
+    void refreshSidecars(const std::shared_ptr<CdsObject>& obj);
+
     std::shared_ptr<CdsObject> createObjectFromFile(const fs::path& path,
         bool magic = true,
         bool allow_fifo = false);
@@ -311,6 +345,25 @@ public:
 
     void triggerPlayHook(const std::shared_ptr<CdsObject>& obj);
 
+    /// \brief Admission control for transcoding streams.
+    std::shared_ptr<TranscodeScheduler> getTranscodeScheduler() { return transcodeScheduler; }
+
+    /// \brief Event loops filling the buffers of remote and transcoded streams.
+    std::shared_ptr<StreamReactor> getStreamReactor() { return streamReactor; }
+
+    /// \brief Rate limits and statistics of the media streams.
+    std::shared_ptr<BandwidthShaper> getBandwidthShaper() { return bandwidthShaper; }
+
+#ifdef HAVE_CURL
+    /// \brief Curl handles for proxied streams and online services.
+    std::shared_ptr<CurlHandlePool> getCurlPool() { return curlPool; }
+#endif
+
+#ifdef HAVE_MAGIC
+    /// \brief Mime types filemagic found for imported and served files.
+    std::shared_ptr<MimeCache> getMimeCache() { return mimeCache; }
+#endif
+
 protected:
     void initLayout();
     void destroyLayout();
@@ -328,6 +381,16 @@ protected:
     std::shared_ptr<TaskProcessor> task_processor;
     std::shared_ptr<Runtime> scripting_runtime;
     std::shared_ptr<LastFm> last_fm;
+    std::shared_ptr<ResourceCache> resourceCache;
+    std::shared_ptr<TranscodeScheduler> transcodeScheduler;
+    std::shared_ptr<StreamReactor> streamReactor;
+    std::shared_ptr<BandwidthShaper> bandwidthShaper;
+#ifdef HAVE_CURL
+    std::shared_ptr<CurlHandlePool> curlPool;
+#endif
+#ifdef HAVE_MAGIC
+    std::shared_ptr<MimeCache> mimeCache;
+#endif
 
     std::recursive_mutex mutex;
     using AutoLock = std::lock_guard<decltype(mutex)>;
@@ -24,36 +24,44 @@ Gerbera - https://gerbera.io/
 #include "device_description_handler.h"
 
 #include "iohandler/mem_io_handler.h"
+#include "util/headers.h"
 #include "util/tools.h"
 #include <utility>
 
+DescriptionDocument::DescriptionDocument(std::string content, std::string mimeType, time_t lastModified)
+    : content(std::make_shared<const std::string>(std::move(content)))
+    , mimeType(std::move(mimeType))
+    , lastModified(lastModified)
+{
+    etag = "\"" + hex_string_md5(*this->content) + "\"";
+}
+
 DeviceDescriptionHandler::DeviceDescriptionHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
-    UpnpXMLBuilder* xmlBuilder)
+    std::shared_ptr<DescriptionDocument> document)
     : RequestHandler(std::move(config), std::move(storage))
-    , xmlBuilder(xmlBuilder)
+    , document(std::move(document))
 {
-
-    auto desc = xmlBuilder->renderDeviceDescription();
-
-    std::ostringstream buf;
-    desc->print(buf, "", 0);
-    deviceDescription = buf.str();
 }
 
 void DeviceDescriptionHandler::getInfo(const char* filename, UpnpFileInfo* info)
 {
-    // We should be able to do the generation here, but libupnp doesnt support the request cookies yet
-    UpnpFileInfo_set_FileLength(info, -1);
-    UpnpFileInfo_set_ContentType(info, "application/xml");
+    UpnpFileInfo_set_FileLength(info, document->getContent()->length());
+    UpnpFileInfo_set_LastModified(info, document->getLastModified());
+    UpnpFileInfo_set_ContentType(info, ixmlCloneDOMString(document->getMimeType().c_str()));
     UpnpFileInfo_set_IsReadable(info, 1);
     UpnpFileInfo_set_IsDirectory(info, 0);
+
+    Headers headers;
+    headers.addHeader("ETag", document->getETag());
+    headers.addHeader("Cache-Control", "no-cache");
+    headers.writeHeaders(info);
 }
 
 std::unique_ptr<IOHandler> DeviceDescriptionHandler::open(const char* filename, enum UpnpOpenFileMode mode, std::string range)
 {
-    log_debug("Device description requested");
+    log_debug("Description requested: {}", filename);
 
-    auto t = std::make_unique<MemIOHandler>(deviceDescription);
+    auto t = std::make_unique<MemIOHandler>(document->getContent());
     t->open(mode);
     return t;
 }
@@ -25,20 +25,42 @@ Gerbera - https://gerbera.io/
 #define GERBERA_DEVICE_DESCRIPTION_HANDLER_H
 
 #include "request_handler.h"
-#include "upnp_xml.h"
+#include <ctime>
 #include <memory>
+#include <string>
+
+/// \brief A description document rendered once per server run.
+///
+/// Holds the device description or a service description (SCPD). The
+/// content is shared between all requests, ETag and Last-Modified are
+/// fixed when the document is created, so they only change when the
+/// server is restarted with a new configuration.
+class DescriptionDocument {
+public:
+    DescriptionDocument(std::string content, std::string mimeType, time_t lastModified);
+
+    const std::shared_ptr<const std::string>& getContent() const { return content; }
+    const std::string& getMimeType() const { return mimeType; }
+    const std::string& getETag() const { return etag; }
+    time_t getLastModified() const { return lastModified; }
+
+protected:
+    std::shared_ptr<const std::string> content;
+    std::string mimeType;
+    std::string etag;
+    time_t lastModified;
+};
 
 class DeviceDescriptionHandler : public RequestHandler {
 public:
     explicit DeviceDescriptionHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
-        UpnpXMLBuilder* xmlBuilder);
+        std::shared_ptr<DescriptionDocument> document);
 
     void getInfo(const char* filename, UpnpFileInfo* info) override;
     std::unique_ptr<IOHandler> open(const char* filename, enum UpnpOpenFileMode mode, std::string range) override;
 
 protected:
-    UpnpXMLBuilder* xmlBuilder;
-    std::string deviceDescription;
+    std::shared_ptr<DescriptionDocument> document;
 };
 
 #endif //GERBERA_DEVICE_DESCRIPTION_HANDLER_H
@@ -90,6 +90,15 @@ public:
     }
 };
 
+/// \brief No transcoding slot is available for a stream.
+class TranscodingBusyException : public std::runtime_error {
+public:
+    inline explicit TranscodingBusyException(std::string message)
+        : std::runtime_error(message)
+    {
+    }
+};
+
 class TryAgainException : public std::runtime_error {
 public:
     inline explicit TryAgainException(std::string message)
@@ -29,6 +29,7 @@
 
 /// \file file_request_handler.cc
 
+#include <algorithm>
 #include <filesystem>
 #include <sys/stat.h>
 #include <utility>
@@ -36,103 +37,200 @@
 #include "config/config_manager.h"
 #include "content_manager.h"
 #include "file_request_handler.h"
+#include "iohandler/block_file_io_handler.h"
 #include "iohandler/file_io_handler.h"
+#include "iohandler/mem_io_handler.h"
+#include "iohandler/shaped_io_handler.h"
+#include "iohandler/time_seek_io_handler.h"
 #include "metadata/metadata_handler.h"
+#include "metadata/sidecar_handler.h"
 #include "server.h"
 #include "storage/storage.h"
 #include "update_manager.h"
 #include "util/process.h"
+#include "util/resource_cache.h"
 #include "web/session_manager.h"
 
 #include "util/headers.h"
 #include "util/tools.h"
 
+#include "transcoding/transcode_cache.h"
 #include "transcoding/transcode_dispatcher.h"
+#include "transcoding/transcode_scheduler.h"
 
 FileRequestHandler::FileRequestHandler(std::shared_ptr<ConfigManager> config,
     std::shared_ptr<Storage> storage,
     std::shared_ptr<ContentManager> content,
     std::shared_ptr<UpdateManager> updateManager, std::shared_ptr<web::SessionManager> sessionManager,
-    UpnpXMLBuilder* xmlBuilder)
+    UpnpXMLBuilder* xmlBuilder, std::shared_ptr<ResourceCache> resourceCache,
+    std::shared_ptr<TranscodeCache> transcodeCache)
     : RequestHandler(std::move(config), std::move(storage))
     , content(std::move(content))
     , updateManager(std::move(updateManager))
     , sessionManager(std::move(sessionManager))
     , xmlBuilder(xmlBuilder)
+    , resourceCache(std::move(resourceCache))
+    , transcodeCache(std::move(transcodeCache))
 {
 }
 
-void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
+std::uintptr_t FileRequestStateCache::put(const std::string& link, std::shared_ptr<FileRequestState> state)
 {
-    Headers headers;
-    log_debug("start");
+    AutoLock lock(mutex);
+    purge(state->created);
+    if (entries.size() >= MAX_ENTRIES)
+        entries.erase(entries.begin());
+
+    // never hand out 0, it stands for "no cookie"
+    if (++lastToken == 0)
+        ++lastToken;
+    entries[lastToken] = { link, std::move(state) };
+    return lastToken;
+}
 
-    std::string mimeType;
-    int objectID;
-    std::string tr_profile;
+std::shared_ptr<FileRequestState> FileRequestStateCache::take(std::uintptr_t token, const std::string& link)
+{
+    AutoLock lock(mutex);
+    purge(std::chrono::steady_clock::now());
 
-    struct stat statbuf;
-    int ret = 0;
-    bool is_srt = false;
+    auto it = entries.end();
+    if (token != 0) {
+        it = entries.find(token);
+    } else {
+        // newest entry for the link, the Open of the same request follows its GetInfo;
+        // if several clients are requesting the link, the Open cannot be told apart
+        // and the seek position, slot and client must not cross over
+        for (auto rit = entries.rbegin(); rit != entries.rend(); ++rit) {
+            if (rit->second.link != link)
+                continue;
+            if (it == entries.end())
+                it = std::prev(rit.base());
+            else if (rit->second.state->client != it->second.state->client)
+                return nullptr;
+        }
+    }
+    if (it == entries.end() || it->second.link != link)
+        return nullptr;
 
-    std::string parameters = (filename + strlen(LINK_FILE_REQUEST_HANDLER));
+    auto state = std::move(it->second.state);
+    entries.erase(it);
+    return state;
+}
+
+void FileRequestStateCache::purge(std::chrono::steady_clock::time_point now)
+{
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (now - it->second.state->created > MAX_AGE)
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::shared_ptr<FileRequestState> FileRequestHandler::resolve(const char* filename) const
+{
+    auto result = std::make_shared<FileRequestState>();
+    result->created = std::chrono::steady_clock::now();
+    result->seekStart = 0;
+    result->announcedLength = -1;
 
-    std::map<std::string, std::string> dict;
-    dict_decode_simple(parameters, &dict);
+    std::string parameters = (filename + strlen(LINK_FILE_REQUEST_HANDLER));
+    dict_decode_simple(parameters, &result->params);
 
     log_debug("full url (filename): {}, parameters: {}", filename, parameters.c_str());
 
-    std::string objID = getValueOrDefault(dict, "object_id");
+    std::string objID = getValueOrDefault(result->params, "object_id");
     if (objID.empty()) {
-        //log_error("object_id not found in url");
-        throw std::runtime_error("getInfo: object_id not found");
+        throw std::runtime_error("object_id not found in parameters");
     }
-    objectID = std::stoi(objID);
-
-    //log_debug("got ObjectID: [{}]", object_id.c_str());
-
-    auto obj = storage->loadObject(objectID);
+    int objectID = std::stoi(objID);
 
-    int objectType = obj->getObjectType();
+    log_debug("Loading media object with id {}", objectID);
+    result->obj = storage->loadObject(objectID);
 
-    if (!IS_CDS_ITEM(objectType)) {
+    if (!IS_CDS_ITEM(result->obj->getObjectType())) {
         throw std::runtime_error("requested object is not an item");
     }
 
-    auto item = std::static_pointer_cast<CdsItem>(obj);
+    resolveFile(*result);
+    return result;
+}
 
-    fs::path path = item->getLocation();
+void FileRequestHandler::resolveFile(FileRequestState& state) const
+{
+    auto item = std::static_pointer_cast<CdsItem>(state.obj);
+    state.path = item->getLocation();
+    state.isSrt = false;
+    state.resHandler = -1;
+    state.mimeType.clear();
 
     // determining which resource to serve
-    int res_id = 0;
-    std::string s_res_id = getValueOrDefault(dict, URL_RESOURCE_ID);
+    std::string s_res_id = getValueOrDefault(state.params, URL_RESOURCE_ID);
     if (string_ok(s_res_id) && (s_res_id != URL_VALUE_TRANSCODE_NO_RES_ID))
-        res_id = std::stoi(s_res_id);
+        state.resId = std::stoi(s_res_id);
     else
-        res_id = -1;
+        state.resId = -1;
 
-    std::string ext = getValueOrDefault(dict, "ext");
+    std::string ext = getValueOrDefault(state.params, "ext");
     size_t edot = ext.rfind('.');
     if (edot != std::string::npos)
         ext = ext.substr(edot);
-    if ((ext == ".srt") || (ext == ".ssa") || (ext == ".smi") || (ext == ".sub")) {
-        // remove .ext
-        std::string pathNoExt = path.parent_path() / path.stem();
-        path = pathNoExt + ext;
-        mimeType = MIMETYPE_TEXT;
+    if (SidecarHandler::isSubtitleExtension(ext)) {
+        // subtitles are indexed when the item is imported
+        fs::path subtitlePath = SidecarHandler::getSubtitlePath(item, ext);
+        if (subtitlePath.empty())
+            throw SubtitlesNotFoundException("No " + ext + " subtitle for " + state.path.string() + " is available.");
+        state.path = subtitlePath;
+        state.mimeType = MIMETYPE_TEXT;
 
         // reset resource id
-        res_id = 0;
-        is_srt = true;
+        state.resId = 0;
+        state.isSrt = true;
     }
 
-    ret = stat(path.c_str(), &statbuf);
+    int ret = stat(state.path.c_str(), &state.statbuf);
     if (ret != 0) {
-        if (is_srt)
-            throw SubtitlesNotFoundException("Subtitle file " + path.string() + " is not available.");
+        if (state.isSrt)
+            throw SubtitlesNotFoundException("Subtitle file " + state.path.string() + " is not available.");
+
+        throw std::runtime_error("Failed to open " + state.path.string() + " - " + strerror(errno));
+    }
 
-        throw std::runtime_error("Failed to open " + path.string() + " - " + strerror(errno));
+    state.trProfile = getValueOrDefault(state.params, URL_PARAM_TRANSCODE_PROFILE_NAME);
+
+    // some resources are created dynamically and not saved in the database,
+    // so we can not load such a resource for a particular item, we will have
+    // to trust the resource handler parameter
+    std::string rh = getValueOrDefault(state.params, RESOURCE_HANDLER);
+    if (((state.resId > 0) && (state.resId < item->getResourceCount()))
+        || ((state.resId > 0) && string_ok(rh))) {
+        if (string_ok(rh))
+            state.resHandler = std::stoi(rh);
+        else {
+            auto resource = item->getResource(state.resId);
+            state.resHandler = resource->getHandlerType();
+            // http-get:*:image/jpeg:*
+            std::string protocolInfo = getValueOrDefault(resource->getAttributes(), "protocolInfo");
+            if (!protocolInfo.empty()) {
+                state.mimeType = getMTFromProtocolInfo(protocolInfo);
+            }
+        }
     }
+}
+
+void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
+{
+    Headers headers;
+    log_debug("start");
+
+    state = resolve(filename);
+    state->client = sockAddrToString(UpnpFileInfo_get_CtrlPtIPAddr(info));
+
+    auto item = std::static_pointer_cast<CdsItem>(state->obj);
+    const fs::path& path = state->path;
+    const struct stat& statbuf = state->statbuf;
+    std::string mimeType = state->mimeType;
+    const std::string& tr_profile = state->trProfile;
 
     if (access(path.c_str(), R_OK) == 0) {
         UpnpFileInfo_set_IsReadable(info, 1);
@@ -146,33 +244,16 @@ void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
         header = "Content-Disposition: attachment; filename=\"" + path.filename().string() + "\"";
     }
 
-    tr_profile = getValueOrDefault(dict, URL_PARAM_TRANSCODE_PROFILE_NAME);
+    time_t lastModified = statbuf.st_mtime;
 
     // for transcoded resourecs res_id will always be negative
-    log_debug("fetching resource id {}", res_id);
-    std::string rh = getValueOrDefault(dict, RESOURCE_HANDLER);
-
-    if (((res_id > 0) && (res_id < item->getResourceCount()))
-        || ((res_id > 0) && string_ok(rh))) {
-
-        int res_handler;
-        if (string_ok(rh))
-            res_handler = std::stoi(rh);
-        else {
-            auto resource = item->getResource(res_id);
-            res_handler = resource->getHandlerType();
-            // http-get:*:image/jpeg:*
-            std::string protocolInfo = getValueOrDefault(item->getResource(res_id)->getAttributes(), "protocolInfo");
-            if (!protocolInfo.empty()) {
-                mimeType = getMTFromProtocolInfo(protocolInfo);
-            }
-        }
-
-        auto h = MetadataHandler::createHandler(config, res_handler);
+    log_debug("fetching resource id {}", state->resId);
+    if (state->resHandler != -1) {
+        auto h = MetadataHandler::createHandler(config, state->resHandler);
         if (!string_ok(mimeType))
             mimeType = h->getMimeType();
 
-        auto io_handler = h->serveContent(item, res_id);
+        auto io_handler = createResourceIOHandler(item, h);
 
         // get size
         io_handler->open(UPNP_READ);
@@ -181,7 +262,21 @@ void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
         io_handler->close();
 
         UpnpFileInfo_set_FileLength(info, size);
-    } else if (!is_srt && string_ok(tr_profile)) {
+
+        // libupnp cannot answer with 304, so a lifetime spares clients
+        // from downloading thumbnails and album art on every view
+        if (state->resHandler == CH_SIDECAR) {
+            lastModified = getLastWriteTime(item->getResource(state->resId)->getOption(RESOURCE_OPTION_PATH));
+            headers.addHeader("Cache-Control", "no-cache");
+        } else {
+            // fan art is a file of its own, a replaced poster gets a new ETag
+            auto fanArtPath = state->resHandler == CH_FANART ? item->getResource(state->resId)->getOption(RESOURCE_OPTION_PATH) : "";
+            if (!fanArtPath.empty())
+                lastModified = getLastWriteTime(fanArtPath);
+            headers.addHeader("Cache-Control", "max-age=" + std::to_string(config->getIntOption(CFG_SERVER_RESOURCE_CACHE_MAX_AGE)));
+        }
+        headers.addHeader("ETag", makeETag(item->getID(), state->resId, lastModified, size));
+    } else if (!state->isSrt && string_ok(tr_profile)) {
 
         auto tp = config->getTranscodingProfileListOption(CFG_TRANSCODING_PROFILE_LIST)
                       ->getByName(tr_profile);
@@ -209,40 +304,72 @@ void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
                 mimeType = mimeType + ";channels=" + nrch;
         }
 
-        UpnpFileInfo_set_FileLength(info, -1);
+        off_t length = -1;
+        if (tp->isTimeSeekable()) {
+            double duration = -1;
+            std::string durationStr = item->getResource(0)->getAttribute(MetadataHandler::getResAttrName(R_DURATION));
+            if (!string_ok(durationStr) || !parseNptTime(durationStr, duration))
+                duration = -1;
+
+            std::string timeSeek = getValueOrDefault(Headers::readHeaders(info), "timeseekrange.dlna.org");
+            double end = -1;
+            if (string_ok(timeSeek)) {
+                if (parseNptRange(timeSeek, state->seekStart, end) && (duration < 0 || state->seekStart < duration)) {
+                    if (end < 0 && duration >= 0)
+                        end = duration;
+                    headers.addHeader(D_HTTP_TIME_SEEK_RANGE_HEADER, "npt=" + secondsToNpt(state->seekStart) + "-" + (end >= 0 ? secondsToNpt(end) : "") + "/" + (duration >= 0 ? secondsToNpt(duration) : "*"));
+                } else {
+                    log_warning("Ignoring invalid {} request: {}", D_HTTP_TIME_SEEK_RANGE_HEADER, timeSeek);
+                    state->seekStart = 0;
+                    end = -1;
+                }
+            }
+
+            // with a known bitrate the length can be estimated, which lets
+            // the web server handle byte ranges by seeking our handler
+            if (tp->getBitrate() > 0 && duration > 0) {
+                double stop = (end >= 0) ? end : duration;
+                length = static_cast<off_t>((stop - state->seekStart) * tp->getBitrate() / 8);
+            }
+        }
+
+        // a complete stream in the transcode cache is served as a file
+        bool cached = false;
+        std::string cacheKey = getTranscodeCacheKey();
+        if (!cacheKey.empty()) {
+            auto cachePath = transcodeCache->lookup(cacheKey);
+            std::error_code ec;
+            if (!cachePath.empty()) {
+                auto size = fs::file_size(cachePath, ec);
+                cached = !ec;
+                if (cached)
+                    length = size;
+            }
+        }
+
+        // the slot is taken by open(), which a HEAD request never reaches;
+        // a request that could not even queue is refused before any headers are sent
+        if (!cached && !content->getTranscodeScheduler()->canAdmit(tp->getName(), tp->getMaxJobs()))
+            throw TranscodingBusyException("transcoding queue is full, rejecting stream of profile " + tp->getName());
+
+        state->announcedLength = length;
+        UpnpFileInfo_set_FileLength(info, length);
     } else {
         UpnpFileInfo_set_FileLength(info, statbuf.st_size);
+        headers.addHeader("ETag", makeETag(item->getID(), 0, statbuf.st_mtime, statbuf.st_size));
 
         if (config->getBoolOption(CFG_SERVER_EXTEND_PROTOCOLINFO_SM_HACK)) {
             if (startswith(item->getMimeType(), "video")) {
-                // Look for subtitle file and returns it's URL
+                // Return the URL of the subtitle found at import time
                 // in CaptionInfo.sec response header.
                 // To be more compliant with original Samsung
                 // server we should check for getCaptionInfo.sec: 1
                 // request header.
-                std::vector<std::string> subexts;
-                subexts.reserve(4);
-                subexts.emplace_back(".srt");
-                subexts.emplace_back(".ssa");
-                subexts.emplace_back(".smi");
-                subexts.emplace_back(".sub");
-
-                // remove .ext
-                std::string pathNoExt = path.parent_path() / path.stem();
-
-                std::string validext;
-                for (const auto& ext : subexts) {
-                    std::string fpath = pathNoExt + ext;
-                    if (access(fpath.c_str(), R_OK) == 0) {
-                        validext = ext;
-                        break;
-                    }
-                }
-
-                if (validext.length() > 0) {
+                fs::path subtitlePath = SidecarHandler::getSubtitlePath(item);
+                if (!subtitlePath.empty()) {
                     std::string burlpath = filename;
                     burlpath = burlpath.substr(0, burlpath.rfind('.'));
-                    std::string url = "http://" + Server::getIP() + ":" + Server::getPort() + burlpath + validext;
+                    std::string url = "http://" + Server::getIP() + ":" + Server::getPort() + burlpath + subtitlePath.extension().string();
                     headers.addHeader("CaptionInfo.sec:", url);
                 }
             }
@@ -265,7 +392,7 @@ void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
     //log_debug("sizeof off_t {}, statbuf.st_size {}", sizeof(off_t), sizeof(statbuf.st_size));
     //log_debug("getInfo: file_length: " OFF_T_SPRINTF "", statbuf.st_size);
 
-    UpnpFileInfo_set_LastModified(info, statbuf.st_mtime);
+    UpnpFileInfo_set_LastModified(info, lastModified);
     UpnpFileInfo_set_IsDirectory(info, S_ISDIR(statbuf.st_mode));
     UpnpFileInfo_set_ContentType(info, ixmlCloneDOMString(mimeType.c_str()));
 
@@ -287,31 +414,18 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(const char* filename,
         throw std::runtime_error("UPNP_WRITE unsupported");
     }
 
-    std::string parameters = (filename + strlen(LINK_FILE_REQUEST_HANDLER));
-
-    std::map<std::string, std::string> params;
-    dict_decode_simple(parameters, &params);
-    log_debug("full url (filename): {}, parameters: {}", filename, parameters.c_str());
-
-    std::string objID = getValueOrDefault(params, "object_id");
-    if (objID.empty()) {
-        throw std::runtime_error("object_id not found in parameters");
-    }
-
-    int objectID = std::stoi(objID);
-
-    log_debug("Opening media file with object id {}", objectID);
-    auto obj = storage->loadObject(objectID);
+    // reuse what getInfo() resolved for this request
+    if (state == nullptr)
+        state = resolve(filename);
+    else
+        log_debug("reusing request state for {}", filename);
 
+    auto obj = state->obj;
     int objectType = obj->getObjectType();
 
-    if (!IS_CDS_ITEM(objectType)) {
-        throw std::runtime_error("requested object is not an item");
-    }
-
-    // determining which resource to serve
+    // the action runs for the main resource only, as requested in the url
     int res_id = 0;
-    std::string s_res_id = getValueOrDefault(params, URL_RESOURCE_ID);
+    std::string s_res_id = getValueOrDefault(state->params, URL_RESOURCE_ID);
     if (string_ok(s_res_id) && (s_res_id != URL_VALUE_TRANSCODE_NO_RES_ID)) {
         res_id = std::stoi(s_res_id);
     } else {
@@ -372,44 +486,23 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(const char* filename,
                 updateManager->containerChanged(clone->getParentID(), FLUSH_ASAP);
             }
             obj = clone;
+
+            // the script may have changed the location
+            state->obj = obj;
+            resolveFile(*state);
         } else {
             log_debug("Item untouched...");
         }
     }
 
     auto item = std::static_pointer_cast<CdsItem>(obj);
-
-    fs::path path = item->getLocation();
-    bool is_srt = false;
-
-    std::string mimeType;
-    std::string ext = getValueOrDefault(params, "ext");
-    size_t edot = ext.rfind('.');
-    if (edot != std::string::npos)
-        ext = ext.substr(edot);
-    if ((ext == ".srt") || (ext == ".ssa") || (ext == ".smi") || (ext == ".sub")) {
-        // remove .ext
-        std::string pathNoExt = path.parent_path() / path.stem();
-        path = pathNoExt + ext;
-        mimeType = MIMETYPE_TEXT;
-
-        // reset resource id
-        res_id = 0;
-        is_srt = true;
-    }
-
-    struct stat statbuf;
-    int ret = stat(path.c_str(), &statbuf);
-    if (ret != 0) {
-        if (is_srt)
-            throw SubtitlesNotFoundException("Subtitle file " + path.string() + " is not available.");
-
-        throw std::runtime_error("Failed to open " + path.string() + " - " + strerror(errno));
-    }
+    const fs::path& path = state->path;
+    std::string mimeType = state->mimeType;
+    res_id = state->resId;
 
     log_debug("fetching resource id {}", res_id);
 
-    std::string tr_profile = getValueOrDefault(params, URL_PARAM_TRANSCODE_PROFILE_NAME);
+    const std::string& tr_profile = state->trProfile;
     if (string_ok(tr_profile)) {
         if (res_id != (-1)) {
             throw std::runtime_error("Invalid resource ID given!");
@@ -420,55 +513,54 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(const char* filename,
         }
     }
 
-    // some resources are created dynamically and not saved in the database,
-    // so we can not load such a resource for a particular item, we will have
-    // to trust the resource handler parameter
-    std::string rh = getValueOrDefault(params, RESOURCE_HANDLER);
-    if (((res_id > 0) && (res_id < item->getResourceCount())) || ((res_id > 0) && string_ok(rh))) {
-        //info->file_length = -1;
-
-        int res_handler;
-        if (string_ok(rh))
-            res_handler = std::stoi(rh);
-        else {
-            auto resource = item->getResource(res_id);
-            res_handler = resource->getHandlerType();
-            // http-get:*:image/jpeg:*
-            std::string protocolInfo = getValueOrDefault(item->getResource(res_id)->getAttributes(), "protocolInfo");
-            if (!protocolInfo.empty()) {
-                mimeType = getMTFromProtocolInfo(protocolInfo);
-            }
-        }
-
-        auto h = MetadataHandler::createHandler(config, res_handler);
+    if (state->resHandler != -1) {
+        auto h = MetadataHandler::createHandler(config, state->resHandler);
         if (!string_ok(mimeType))
             mimeType = h->getMimeType();
 
-        /* FIXME Upstream upnp / DNLA
-#ifdef EXTEND_PROTOCOLINFO
-        header = getDLNAtransferHeader(mimeType, header);
-#endif
-
-        if (string_ok(header))
-                info->http_header = ixmlCloneDOMString(header.c_str());
-        */
-
-        //info->content_type = ixmlCloneDOMString(mimeType.c_str());
-        //auto io_handler = h->serveContent(item, res_id, &(info->file_length));
-
-        auto io_handler = h->serveContent(item, res_id);
+        auto io_handler = createResourceIOHandler(item, h);
         io_handler->open(mode);
         log_debug("end");
         return io_handler;
     }
 
-    if (!is_srt && string_ok(tr_profile)) {
-        std::string range = getValueOrDefault(params, "range");
+    if (!state->isSrt && string_ok(tr_profile)) {
+        std::string range = getValueOrDefault(state->params, "range");
 
-        auto tr_d = std::make_unique<TranscodeDispatcher>(config, content);
+        auto tr_d = std::make_shared<TranscodeDispatcher>(config, content);
         auto tp = config->getTranscodingProfileListOption(CFG_TRANSCODING_PROFILE_LIST)
                       ->getByName(tr_profile);
-        return tr_d->open(tp, path, item, range);
+        std::string cacheKey = getTranscodeCacheKey();
+        if (!cacheKey.empty()) {
+            auto cached = transcodeCache->lookup(cacheKey);
+            if (!cached.empty()) {
+                auto io_handler = std::make_unique<FileIOHandler>(cached);
+                io_handler->open(mode);
+                content->triggerPlayHook(obj);
+                return shapeStream(std::move(io_handler));
+            }
+        }
+
+        auto job = content->getTranscodeScheduler()->admit(tr_profile, tp != nullptr ? tp->getMaxJobs() : 0);
+
+        auto cache = transcodeCache;
+        off_t announcedLength = state->announcedLength;
+        auto startTranscoder = [=](double start) {
+            auto io_handler = tr_d->open(tp, path, item, range, start);
+            // only streams starting at the beginning are recorded
+            if (!cacheKey.empty() && start == 0)
+                io_handler = cache->record(cacheKey, std::move(io_handler), announcedLength);
+            return io_handler;
+        };
+        std::unique_ptr<IOHandler> io_handler;
+        if (tp != nullptr && tp->isTimeSeekable() && tp->getBitrate() > 0) {
+            // seeking restarts the transcoder at the matching time
+            io_handler = std::make_unique<TimeSeekIOHandler>(startTranscoder, tp->getBitrate(), state->seekStart);
+            io_handler->open(mode);
+        } else {
+            io_handler = startTranscoder(state->seekStart);
+        }
+        return shapeStream(std::make_unique<TranscodeJobIOHandler>(job, std::move(io_handler)));
     }
 
     if (mimeType.empty())
@@ -497,9 +589,44 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(const char* filename,
         info->http_header = ixmlCloneDOMString(header.c_str());
     */
 
-    auto io_handler = std::make_unique<FileIOHandler>(path);
+    auto io_handler = createFileIOHandler(path, mimeType, state->statbuf.st_size);
     io_handler->open(mode);
     content->triggerPlayHook(obj);
     log_debug("end");
-    return io_handler;
+    return shapeStream(std::move(io_handler));
+}
+
+std::unique_ptr<IOHandler> FileRequestHandler::createResourceIOHandler(const std::shared_ptr<CdsItem>& item, const std::unique_ptr<MetadataHandler>& handler) const
+{
+    // sidecar files and fan art are plain files which can change without
+    // the item, so they are read directly
+    if (resourceCache == nullptr || state->resHandler == CH_SIDECAR || state->resHandler == CH_FANART)
+        return handler->serveContent(item, state->resId);
+
+    auto key = ResourceCache::makeKey(item->getLocation(), state->statbuf.st_mtime, handler->getContentVariant(item, state->resId));
+    auto data = resourceCache->getOrCreate(key, [&]() { return handler->serveContent(item, state->resId); });
+    return std::make_unique<MemIOHandler>(data);
+}
+
+std::unique_ptr<IOHandler> FileRequestHandler::shapeStream(std::unique_ptr<IOHandler> handler) const
+{
+    return std::make_unique<ShapedIOHandler>(content->getBandwidthShaper(), state->client, state->obj->getTitle(), std::move(handler));
+}
+
+std::string FileRequestHandler::getTranscodeCacheKey() const
+{
+    if (transcodeCache == nullptr || state->seekStart != 0 || !string_ok(state->trProfile))
+        return "";
+    return TranscodeCache::makeKey(state->trProfile, state->path, state->statbuf.st_mtime);
+}
+
+std::unique_ptr<IOHandler> FileRequestHandler::createFileIOHandler(const fs::path& path, const std::string& mimeType, off_t size) const
+{
+    if (config->getBoolOption(CFG_SERVER_BLOCK_IO_ENABLED) && size >= config->getIntOption(CFG_SERVER_BLOCK_IO_MIN_SIZE)) {
+        auto prefixes = config->getStringArrayOption(CFG_SERVER_BLOCK_IO_MIMETYPE_LIST);
+        bool match = prefixes.empty() || std::any_of(prefixes.begin(), prefixes.end(), [&](const auto& prefix) { return startswith(mimeType, prefix); });
+        if (match)
+            return std::make_unique<BlockFileIOHandler>(path, config->getIntOption(CFG_SERVER_BLOCK_IO_BLOCK_SIZE));
+    }
+    return std::make_unique<FileIOHandler>(path);
 }
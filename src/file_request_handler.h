@@ -32,38 +32,144 @@
 #ifndef __FILE_REQUEST_HANDLER_H__
 #define __FILE_REQUEST_HANDLER_H__
 
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/stat.h>
+
 #include "common.h"
 #include "request_handler.h"
 #include "upnp_xml.h"
-#include <memory>
 
 // forward declaration
+class CdsObject;
 class ConfigManager;
 class ContentManager;
+class MetadataHandler;
+class ResourceCache;
+class TranscodeCache;
 class UpdateManager;
 namespace web {
 class SessionManager;
 }
 
+/// \brief Media request as resolved by FileRequestHandler::getInfo().
+///
+/// libupnp calls GetInfo and then Open for one GET request, the state is
+/// handed over so that open() does not load the object and stat the file again.
+struct FileRequestState {
+    std::map<std::string, std::string> params;
+    std::shared_ptr<CdsObject> obj;
+    fs::path path;
+    struct stat statbuf;
+    int resId;
+    bool isSrt;
+    /// \brief metadata handler serving the resource, -1 for the file itself
+    int resHandler;
+    std::string trProfile;
+    std::string mimeType;
+    /// \brief start of a requested TimeSeekRange in seconds
+    double seekStart;
+    /// \brief estimated length of a transcoded stream sent by GetInfo, -1 if none
+    off_t announcedLength;
+    std::chrono::steady_clock::time_point created;
+    /// \brief address of the requesting client
+    std::string client;
+};
+
+/// \brief Short-lived store passing FileRequestState from GetInfo to Open.
+///
+/// With request cookies each entry is found by the token stored in the
+/// cookie, otherwise by the request link as long as only one client has
+/// requested it. Entries that are never opened (HEAD requests, failed
+/// requests) expire after a few seconds.
+class FileRequestStateCache {
+public:
+    /// \brief Stores the state of the request for link.
+    /// \return token to be passed as request cookie
+    std::uintptr_t put(const std::string& link, std::shared_ptr<FileRequestState> state);
+
+    /// \brief Removes and returns the state stored by put().
+    /// \param token request cookie, 0 to look the entry up by link
+    /// \param link unescaped request link
+    /// \return state or nullptr if nothing usable was stored or, without
+    /// token, the link is pending for more than one client
+    std::shared_ptr<FileRequestState> take(std::uintptr_t token, const std::string& link);
+
+protected:
+    static constexpr std::chrono::seconds MAX_AGE = std::chrono::seconds(5);
+    static constexpr size_t MAX_ENTRIES = 64;
+
+    struct Entry {
+        std::string link;
+        std::shared_ptr<FileRequestState> state;
+    };
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    std::uintptr_t lastToken = 0;
+    std::map<std::uintptr_t, Entry> entries;
+
+    void purge(std::chrono::steady_clock::time_point now);
+};
+
 class FileRequestHandler : public RequestHandler {
 protected:
     std::shared_ptr<ContentManager> content;
     std::shared_ptr<UpdateManager> updateManager;
     std::shared_ptr<web::SessionManager> sessionManager;
     UpnpXMLBuilder* xmlBuilder;
+    std::shared_ptr<ResourceCache> resourceCache;
+    std::shared_ptr<TranscodeCache> transcodeCache;
+
+    /// \brief State resolved by getInfo() or handed over to open().
+    std::shared_ptr<FileRequestState> state;
+
+    /// \brief Parses the request url and loads the requested item.
+    std::shared_ptr<FileRequestState> resolve(const char* filename) const;
+
+    /// \brief Determines path, resource and mimetype of the item in state and stats the file.
+    void resolveFile(FileRequestState& state) const;
+
+    /// \brief Creates the (unopened) handler of the secondary resource in state.
+    ///
+    /// Generated resources are served from the resource cache if it is enabled.
+    std::unique_ptr<IOHandler> createResourceIOHandler(const std::shared_ptr<CdsItem>& item, const std::unique_ptr<MetadataHandler>& handler) const;
+
+    /// \brief Creates the handler streaming a media file.
+    ///
+    /// Large files matching the block-io settings are read in blocks,
+    /// everything else through stdio.
+    std::unique_ptr<IOHandler> createFileIOHandler(const fs::path& path, const std::string& mimeType, off_t size) const;
+
+    /// \brief Wraps the open handler of the media stream in state into the bandwidth shaper.
+    std::unique_ptr<IOHandler> shapeStream(std::unique_ptr<IOHandler> handler) const;
+
+    /// \brief Returns the transcode cache key of the stream in state, empty if it is not cached.
+    std::string getTranscodeCacheKey() const;
 
 public:
     explicit FileRequestHandler(std::shared_ptr<ConfigManager> config,
         std::shared_ptr<Storage> storage,
         std::shared_ptr<ContentManager> content,
         std::shared_ptr<UpdateManager> updateManager, std::shared_ptr<web::SessionManager> sessionManager,
-        UpnpXMLBuilder* xmlBuilder);
+        UpnpXMLBuilder* xmlBuilder, std::shared_ptr<ResourceCache> resourceCache,
+        std::shared_ptr<TranscodeCache> transcodeCache);
 
     void getInfo(const char* filename, UpnpFileInfo* info) override;
     std::unique_ptr<IOHandler> open(
         const char* filename,
         enum UpnpOpenFileMode mode,
         std::string range) override;
+
+    /// \brief Returns the state resolved by the last getInfo() call.
+    std::shared_ptr<FileRequestState> getState() const { return state; }
+
+    /// \brief Hands over the state resolved by getInfo() for the same request.
+    void setState(std::shared_ptr<FileRequestState> state) { this->state = std::move(state); }
 };
 
 #endif // __FILE_REQUEST_HANDLER_H__
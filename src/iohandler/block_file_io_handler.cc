@@ -0,0 +1,184 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    block_file_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file block_file_io_handler.cc
+
+#include "block_file_io_handler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+#include "util/tools.h"
+
+/// \brief Number of blocks the kernel is asked to read ahead.
+#define READ_AHEAD_BLOCKS 4
+
+BlockFileIOHandler::BlockFileIOHandler(fs::path filename, size_t blockSize)
+    : filename(std::move(filename))
+    , fd(-1)
+    , pos(0)
+    , block(nullptr)
+    , blockOffset(0)
+    , blockFill(0)
+{
+    auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    this->blockSize = std::max((blockSize + pageSize - 1) / pageSize, static_cast<size_t>(1)) * pageSize;
+}
+
+BlockFileIOHandler::~BlockFileIOHandler()
+{
+    if (fd >= 0)
+        ::close(fd);
+    free(block);
+}
+
+void BlockFileIOHandler::open(enum UpnpOpenFileMode mode)
+{
+    if (mode == UPNP_WRITE) {
+        throw std::runtime_error("BlockFileIOHandler::open: Write mode not supported");
+    } else if (mode != UPNP_READ) {
+        throw std::runtime_error("BlockFileIOHandler::open: invalid UpnpOpenFileMode mode");
+    }
+
+    fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("BlockFileIOHandler::open: failed to open: " + filename.string() + ": " + mt_strerror(errno));
+    }
+
+    void* buffer = nullptr;
+    if (posix_memalign(&buffer, static_cast<size_t>(sysconf(_SC_PAGESIZE)), blockSize) != 0) {
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("BlockFileIOHandler::open: failed to allocate block buffer");
+    }
+    block = static_cast<char*>(buffer);
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    readAhead(0);
+}
+
+void BlockFileIOHandler::readAhead(off_t offset)
+{
+    posix_fadvise(fd, offset, blockSize * READ_AHEAD_BLOCKS, POSIX_FADV_WILLNEED);
+}
+
+bool BlockFileIOHandler::fillBlock()
+{
+    off_t offset = pos - (pos % blockSize);
+    if (blockFill > 0 && offset == blockOffset)
+        return pos < blockOffset + static_cast<off_t>(blockFill);
+
+    ssize_t ret;
+    do {
+        ret = pread(fd, block, blockSize, offset);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0)
+        throw std::runtime_error("BlockFileIOHandler: read failed: " + mt_strerror(errno));
+
+    blockOffset = offset;
+    blockFill = ret;
+    readAhead(offset + blockSize);
+    return pos < blockOffset + static_cast<off_t>(blockFill);
+}
+
+size_t BlockFileIOHandler::read(char* buf, size_t length)
+{
+    size_t total = 0;
+    while (total < length) {
+        // large reads on a block boundary skip the copy
+        if (pos % blockSize == 0 && length - total >= blockSize) {
+            size_t direct = (length - total) - ((length - total) % blockSize);
+            ssize_t ret;
+            do {
+                ret = pread(fd, buf + total, direct, pos);
+            } while (ret < 0 && errno == EINTR);
+            if (ret < 0)
+                return total > 0 ? total : -1;
+            if (ret == 0)
+                break;
+            pos += ret;
+            total += ret;
+            readAhead(pos);
+            continue;
+        }
+
+        try {
+            if (!fillBlock())
+                break;
+        } catch (const std::runtime_error& e) {
+            log_error("{}", e.what());
+            return total > 0 ? total : -1;
+        }
+        size_t available = blockOffset + blockFill - pos;
+        size_t count = std::min(available, length - total);
+        memcpy(buf + total, block + (pos - blockOffset), count);
+        pos += count;
+        total += count;
+    }
+    return total;
+}
+
+void BlockFileIOHandler::seek(off_t offset, int whence)
+{
+    off_t newPos;
+    if (whence == SEEK_SET) {
+        newPos = offset;
+    } else if (whence == SEEK_CUR) {
+        newPos = pos + offset;
+    } else if (whence == SEEK_END) {
+        struct stat statbuf;
+        if (fstat(fd, &statbuf) != 0)
+            throw std::runtime_error("BlockFileIOHandler: fstat failed");
+        newPos = statbuf.st_size + offset;
+    } else {
+        throw std::runtime_error("BlockFileIOHandler: invalid whence");
+    }
+    if (newPos < 0)
+        throw std::runtime_error("BlockFileIOHandler: seek before start of file");
+
+    pos = newPos;
+    readAhead(pos - (pos % blockSize));
+}
+
+off_t BlockFileIOHandler::tell()
+{
+    return pos;
+}
+
+void BlockFileIOHandler::close()
+{
+    int ret = ::close(fd);
+    fd = -1;
+    free(block);
+    block = nullptr;
+    blockFill = 0;
+    if (ret != 0) {
+        throw std::runtime_error("BlockFileIOHandler: close failed");
+    }
+}
@@ -0,0 +1,94 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    block_file_io_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file block_file_io_handler.h
+/// \brief Definition of the BlockFileIOHandler class.
+#ifndef GERBERA_BLOCK_FILE_IO_HANDLER_H
+#define GERBERA_BLOCK_FILE_IO_HANDLER_H
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "common.h"
+#include "io_handler.h"
+
+/// \brief Allows the web server to stream large files.
+///
+/// The file is read with pread() in large blocks aligned to the page size,
+/// the kernel is told that access is sequential and is asked to read ahead
+/// the following blocks. The small reads of the web server are served from
+/// the current block, reads of at least one block size go directly to the
+/// caller's buffer.
+class BlockFileIOHandler : public IOHandler {
+public:
+    /// \brief Sets the filename to work with.
+    /// \param blockSize size of the blocks read from the file, rounded up to the page size
+    BlockFileIOHandler(fs::path filename, size_t blockSize);
+    ~BlockFileIOHandler() override;
+
+    /// \brief Opens file for reading (writing is not supported)
+    void open(enum UpnpOpenFileMode mode) override;
+
+    /// \brief Reads a previously opened file sequentially.
+    /// \param buf Data from the file will be copied into this buffer.
+    /// \param length Number of bytes to be copied into the buffer.
+    size_t read(char* buf, size_t length) override;
+
+    /// \brief Performs seek on an open file.
+    void seek(off_t offset, int whence) override;
+
+    /// \brief Return the current stream position.
+    off_t tell() override;
+
+    /// \brief Close a previously opened file.
+    void close() override;
+
+protected:
+    /// \brief Name of the file.
+    fs::path filename;
+
+    /// \brief Descriptor of the file.
+    int fd;
+
+    /// \brief Current stream position.
+    off_t pos;
+
+    /// \brief Buffer holding the current block.
+    char* block;
+    size_t blockSize;
+
+    /// \brief File offset of the current block.
+    off_t blockOffset;
+
+    /// \brief Number of valid bytes in the current block.
+    size_t blockFill;
+
+    /// \brief Reads the block containing the current position.
+    /// \return false at the end of the file
+    bool fillBlock();
+
+    /// \brief Asks the kernel to read ahead of the given offset.
+    void readAhead(off_t offset);
+};
+
+#endif // GERBERA_BLOCK_FILE_IO_HANDLER_H
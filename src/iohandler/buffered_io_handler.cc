@@ -29,15 +29,19 @@
 
 /// \file buffered_io_handler.cc
 
+#include <algorithm>
 #include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "buffered_io_handler.h"
 #include "util/tools.h"
 
 using namespace std;
 
-BufferedIOHandler::BufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandler, size_t bufSize, size_t maxChunkSize, size_t initialFillSize)
-    : IOHandlerBufferHelper(bufSize, initialFillSize)
+BufferedIOHandler::BufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandler, size_t bufSize, size_t maxChunkSize, size_t initialFillSize,
+    std::shared_ptr<StreamReactor> reactor)
+    : IOHandlerBufferHelper(bufSize, initialFillSize, std::move(reactor))
 {
     if (underlyingHandler == nullptr)
         throw std::runtime_error("underlyingHandler must not be nullptr");
@@ -45,6 +49,8 @@ BufferedIOHandler::BufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandl
         throw std::runtime_error("maxChunkSize must be positive");
     this->underlyingHandler = std::move(underlyingHandler);
     this->maxChunkSize = maxChunkSize;
+    fd = -1;
+    fdPaused = false;
 
     // test it first!
     //seekEnabled = true;
@@ -64,121 +70,120 @@ void BufferedIOHandler::close()
     underlyingHandler->close();
 }
 
+bool BufferedIOHandler::endedCleanly()
+{
+    return underlyingHandler->endedCleanly();
+}
+
 void BufferedIOHandler::threadProc()
 {
-    int readBytes;
-    size_t maxWrite;
+    int readBytes = 0;
 
 #ifdef TOMBDEBUG
     struct timespec last_log;
     bool first_log = true;
 #endif
 
-    unique_lock<std::mutex> lock(mutex);
-    do {
+    while (!threadShutdown) {
 
 #ifdef TOMBDEBUG
         if (first_log || getDeltaMillis(&last_log) > 1000) {
             if (first_log)
                 first_log = false;
             getTimespecNow(&last_log);
-            float percentFillLevel = 0;
-            if (!empty) {
-                int currentFillSize = b - a;
-                if (currentFillSize <= 0)
-                    currentFillSize += bufSize;
-                percentFillLevel = (static_cast<float>(currentFillSize) / static_cast<float>(bufSize)) * 100;
-            }
-            log_debug("buffer fill level: {:03.2f}%  (bufSize: {}; a: {}; b: {})", percentFillLevel, bufSize, a, b);
+            float percentFillLevel = (static_cast<float>(getFillSize()) / static_cast<float>(bufSize)) * 100;
+            log_debug("buffer fill level: {:03.2f}%  (bufSize: {}; waits: {})", percentFillLevel, bufSize, waitCount);
         }
 #endif
-        if (empty)
-            a = b = 0;
-
-        if (doSeek && !empty && (seekWhence == SEEK_SET || (seekWhence == SEEK_CUR && seekOffset > 0))) {
-            int currentFillSize = b - a;
-            if (currentFillSize <= 0)
-                currentFillSize += bufSize;
-
-            int relSeek = seekOffset;
-            if (seekWhence == SEEK_SET)
-                relSeek -= posRead;
-
-            if (relSeek <= currentFillSize) { // we have everything we need in the buffer already
-                a += relSeek;
-                posRead += relSeek;
-                if (a >= bufSize)
-                    a -= bufSize;
-                if (a == b) {
-                    empty = true;
-                    a = b = 0;
+        if (doSeek) {
+            unique_lock<std::mutex> lock(mutex);
+            if (!seekInBuffer()) { // seek not been processed yet
+                try {
+                    underlyingHandler->seek(seekOffset, seekWhence);
+                    resetBuffer();
+                } catch (const std::runtime_error& e) {
+                    log_error("Error while seeking in buffer: {}", e.what());
                 }
 
-                /// \todo do we need to wait for initialFillSize again?
+                /// \todo should we do that?
+                waitForInitialFillSize = (initialFillSize > 0);
 
                 doSeek = false;
-                cond.notify_one();
+                cond.notify_all();
             }
         }
 
-        // note: seeking could be optimized some more (backward seeking)
-        // but this should suffice for now
+        if (!waitForSpace(1))
+            continue;
+
+        size_t chunkSize = std::min(getWritableChunk(), maxChunkSize);
+        readBytes = underlyingHandler->read(buffer + writeIndex % bufSize, chunkSize);
+        if (readBytes > 0)
+            commitWrite(readBytes);
+        else if (readBytes == CHECK_SOCKET)
+            signalCheckSocket();
+        else
+            break;
+    }
+    signalEnd(readBytes < 0);
+}
 
-        if (doSeek) { // seek not been processed yet
-            try {
-                underlyingHandler->seek(seekOffset, seekWhence);
-                empty = true;
-                a = b = 0;
-            } catch (const std::runtime_error& e) {
-                log_error("Error while seeking in buffer: {}", e.what());
-            }
+bool BufferedIOHandler::attach()
+{
+    // seeks are done by the buffer thread
+    if (seekEnabled)
+        return false;
+
+    fd = underlyingHandler->getFd();
+    if (fd == -1)
+        return false;
+
+    // our reads must not block the other streams of the loop
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    loop->addFd(fd, this);
+    return true;
+}
 
-            /// \todo should we do that?
-            waitForInitialFillSize = (initialFillSize > 0);
+void BufferedIOHandler::detach()
+{
+    loop->removeFd(fd);
+}
 
-            doSeek = false;
-            cond.notify_one();
-        }
+void BufferedIOHandler::resume()
+{
+    if (fdPaused) {
+        fdPaused = false;
+        loop->setFdEnabled(fd, true);
+    }
+}
 
-        maxWrite = (empty ? bufSize : (a < b ? bufSize - b : a - b));
-        if (maxWrite == 0) {
-            cond.wait(lock);
-        } else {
-            lock.unlock();
-            size_t chunkSize = (maxChunkSize > maxWrite ? maxWrite : maxChunkSize);
-            readBytes = underlyingHandler->read(buffer + b, chunkSize);
-            lock.lock();
-            if (readBytes > 0) {
-                b += readBytes;
-                assert(b <= bufSize);
-                if (b == bufSize)
-                    b = 0;
-                if (empty) {
-                    empty = false;
-                    cond.notify_one();
-                }
-                if (waitForInitialFillSize) {
-                    int currentFillSize = b - a;
-                    if (currentFillSize <= 0)
-                        currentFillSize += bufSize;
-                    if (static_cast<size_t>(currentFillSize) >= initialFillSize) {
-                        log_debug("buffer: initial fillsize reached");
-                        waitForInitialFillSize = false;
-                        cond.notify_one();
-                    }
-                }
-            } else if (readBytes == CHECK_SOCKET) {
-                checkSocket = true;
-                cond.notify_one();
+void BufferedIOHandler::onReadable()
+{
+    // a few chunks at most, the other streams of the loop want their turn
+    for (int i = 0; i < 4; i++) {
+        size_t chunkSize = std::min(getWritableChunk(), maxChunkSize);
+        if (chunkSize == 0) {
+            // read() checks writerWaiting after consuming data
+            writerWaiting = true;
+            chunkSize = std::min(getWritableChunk(), maxChunkSize);
+            if (chunkSize == 0) {
+                fdPaused = true;
+                loop->setFdEnabled(fd, false);
+                return;
             }
+            writerWaiting = false;
         }
-    } while ((maxWrite == 0 || readBytes > 0 || readBytes == CHECK_SOCKET) && !threadShutdown);
-    if (!threadShutdown) {
-        if (readBytes == 0)
-            eof = true;
-        if (readBytes < 0)
-            readError = true;
+
+        ssize_t readBytes = ::read(fd, buffer + writeIndex % bufSize, chunkSize);
+        if (readBytes > 0) {
+            commitWrite(readBytes);
+            continue;
+        }
+        if (readBytes == -1 && (errno == EAGAIN || errno == EINTR))
+            return;
+
+        loop->removeFd(fd);
+        signalEnd(readBytes < 0);
+        return;
     }
-    // ensure that read() doesn't wait for me to fill the buffer
-    cond.notify_one();
 }
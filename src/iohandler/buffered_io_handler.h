@@ -50,16 +50,29 @@ public:
     /// \param initialFillSize the number of bytes which have to be in the buffer
     /// before the first read at the very beginning or after a seek returns;
     /// 0 disables the delay
-    BufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandler, size_t bufSize, size_t maxChunkSize, size_t initialFillSize);
+    /// \param reactor event loops to read pollable handlers from, nullptr to use a buffer thread
+    BufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandler, size_t bufSize, size_t maxChunkSize, size_t initialFillSize,
+        std::shared_ptr<StreamReactor> reactor = nullptr);
 
     void open(enum UpnpOpenFileMode mode) override;
     void close() override;
+    bool endedCleanly() override;
 
 private:
     std::unique_ptr<IOHandler> underlyingHandler;
     size_t maxChunkSize;
 
+    /// \brief descriptor of underlyingHandler read by the loop
+    int fd;
+    /// \brief the loop stopped watching fd because the buffer is full
+    bool fdPaused;
+
     void threadProc() override;
+
+    bool attach() override;
+    void detach() override;
+    void resume() override;
+    void onReadable() override;
 };
 
 #endif // __BUFFERED_IO_HANDLER_H__
@@ -32,13 +32,18 @@
 #ifdef HAVE_CURL
 
 #include "curl_io_handler.h"
+
+#include <algorithm>
+
 #include "config/config_manager.h"
 #include "util/tools.h"
 
 using namespace std;
 
-CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize)
-    : IOHandlerBufferHelper(bufSize, initialFillSize)
+CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize,
+    std::shared_ptr<StreamReactor> reactor, std::shared_ptr<CurlHandlePool> pool)
+    : IOHandlerBufferHelper(bufSize, initialFillSize, std::move(reactor))
+    , pool(std::move(pool))
 {
     if (!string_ok(URL))
         throw std::runtime_error("URL has not been set correctly");
@@ -49,7 +54,7 @@ CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t b
     this->external_curl_handle = (curl_handle != nullptr);
     this->curl_handle = curl_handle;
     //bytesCurl = 0;
-    signalAfterEveryRead = true;
+    paused = false;
 
     // still todo:
     // * optimize seek if data already in buffer
@@ -58,12 +63,16 @@ CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t b
 
 void CurlIOHandler::open(enum UpnpOpenFileMode mode)
 {
-    if (curl_handle == nullptr) {
+    if (external_curl_handle) {
+        curl_easy_reset(curl_handle);
+    } else if (pool != nullptr) {
+        pooledHandle = pool->acquire();
+        curl_handle = pooledHandle.get();
+    } else {
         curl_handle = curl_easy_init();
         if (curl_handle == nullptr)
             throw std::runtime_error("failed to init curl");
-    } else
-        curl_easy_reset(curl_handle);
+    }
 
     IOHandlerBufferHelper::open(mode);
 }
@@ -72,13 +81,19 @@ void CurlIOHandler::close()
 {
     IOHandlerBufferHelper::close();
 
-    if (external_curl_handle && curl_handle != nullptr)
+    if (external_curl_handle)
+        return;
+
+    // the connection stays open for the next request to the server
+    if (pooledHandle != nullptr)
+        pooledHandle.reset();
+    else if (curl_handle != nullptr)
         curl_easy_cleanup(curl_handle);
+    curl_handle = nullptr;
 }
 
-void CurlIOHandler::threadProc()
+void CurlIOHandler::setupHandle()
 {
-    CURLcode res;
     assert(curl_handle != nullptr);
     assert(string_ok(URL));
 
@@ -105,40 +120,86 @@ void CurlIOHandler::threadProc()
 
     curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, CurlIOHandler::curlCallback);
     curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, (void*)this);
+}
+
+void CurlIOHandler::applySeek()
+{
+    log_debug("SEEK: {} {}", seekOffset, seekWhence);
+
+    if (seekWhence == SEEK_SET) {
+        posRead = seekOffset;
+        curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, seekOffset);
+    } else if (seekWhence == SEEK_CUR) {
+        posRead += seekOffset;
+        curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, posRead);
+    } else {
+        log_error("CurlIOHandler currently does not support SEEK_END");
+        static_assert(1);
+    }
+
+    /// \todo should we do that?
+    waitForInitialFillSize = (initialFillSize > 0);
+
+    doSeek = false;
+    cond.notify_all();
+}
+
+void CurlIOHandler::threadProc()
+{
+    CURLcode res;
+    setupHandle();
 
     unique_lock<std::mutex> lock(mutex, std::defer_lock);
     do {
         lock.lock();
-        if (doSeek) {
-            log_debug("SEEK: %lld {}", seekOffset, seekWhence);
-
-            if (seekWhence == SEEK_SET) {
-                posRead = seekOffset;
-                curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, seekOffset);
-            } else if (seekWhence == SEEK_CUR) {
-                posRead += seekOffset;
-                curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, posRead);
-            } else {
-                log_error("CurlIOHandler currently does not support SEEK_END");
-                static_assert(1);
-            }
-
-            /// \todo should we do that?
-            waitForInitialFillSize = (initialFillSize > 0);
-
-            doSeek = false;
-            cond.notify_one();
-        }
+        if (doSeek)
+            applySeek();
         lock.unlock();
         res = curl_easy_perform(curl_handle);
     } while (doSeek);
 
-    if (res != CURLE_OK)
-        readError = true;
-    else
-        eof = true;
+    signalEnd(res != CURLE_OK);
+}
+
+bool CurlIOHandler::attach()
+{
+    setupHandle();
+    loop->addCurl(curl_handle, this);
+    return true;
+}
+
+void CurlIOHandler::detach()
+{
+    loop->removeCurl(curl_handle);
+}
+
+void CurlIOHandler::resume()
+{
+    // like the buffer thread, we do not seek after the end of the stream
+    if (doSeek && !eof && !readError) {
+        unique_lock<std::mutex> lock(mutex);
+        if (doSeek && !seekInBuffer()) {
+            // we need a new request after the seek
+            loop->removeCurl(curl_handle);
+            resetBuffer();
+            applySeek();
+            paused = false;
+            loop->addCurl(curl_handle, this);
+            return;
+        }
+    }
+
+    if (paused) {
+        // curl delivers the data it kept right away, the callback may
+        // pause the transfer again
+        paused = false;
+        curl_easy_pause(curl_handle, CURLPAUSE_CONT);
+    }
+}
 
-    cond.notify_one();
+void CurlIOHandler::onCurlDone(CURLcode result)
+{
+    signalEnd(result != CURLE_OK);
 }
 
 size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* data)
@@ -150,99 +211,40 @@ size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* d
 
     //log_debug("URL: {}; size: {}; nmemb: {}; wantWrite: {}", ego->URL.c_str(), size, nmemb, wantWrite);
 
-    unique_lock<std::mutex> lock(ego->mutex);
-
-    bool first = true;
-
-    int bufFree = 0;
-    do {
-        if (ego->doSeek && !ego->empty && (ego->seekWhence == SEEK_SET || (ego->seekWhence == SEEK_CUR && ego->seekOffset > 0))) {
-            int currentFillSize = ego->b - ego->a;
-            if (currentFillSize <= 0)
-                currentFillSize += ego->bufSize;
-
-            int relSeek = ego->seekOffset;
-            if (ego->seekWhence == SEEK_SET)
-                relSeek -= ego->posRead;
-
-            if (relSeek <= currentFillSize) { // we have everything we need in the buffer already
-                ego->a += relSeek;
-                ego->posRead += relSeek;
-                if (ego->a >= ego->bufSize)
-                    ego->a -= ego->bufSize;
-                if (ego->a == ego->b) {
-                    ego->empty = true;
-                    ego->a = ego->b = 0;
-                }
-                /// \todo do we need to wait for initialFillSize again?
-
-                ego->doSeek = false;
-                ego->cond.notify_one();
-            }
+    // the loop must not block, curl keeps the data until resume()
+    if (ego->loop != nullptr && ego->bufSize - ego->getFillSize() < wantWrite) {
+        // read() checks writerWaiting after consuming data
+        ego->writerWaiting = true;
+        if (ego->bufSize - ego->getFillSize() < wantWrite) {
+            ego->paused = true;
+            return CURL_WRITEFUNC_PAUSE;
         }
+        ego->writerWaiting = false;
+    }
 
-        // note: seeking could be optimized some more (backward seeking)
-        // but this should suffice for now
+    while (ego->loop == nullptr && !ego->waitForSpace(wantWrite)) {
+        if (ego->threadShutdown)
+            return 0;
 
-        if (ego->doSeek) { // seek not been processed yet
-            ego->a = ego->b = 0;
-            ego->empty = true;
+        unique_lock<std::mutex> lock(ego->mutex);
+        if (ego->doSeek && !ego->seekInBuffer()) {
+            ego->resetBuffer();
 
             // terminate this request, because we need a new request
             // after the seek
             return 0;
         }
+    }
 
-        if (!first) {
-            ego->cond.wait(lock);
-        } else
-            first = false;
-
-        if (ego->threadShutdown)
-            return 0;
-
-        if (ego->empty) {
-            ego->a = ego->b = 0;
-            bufFree = ego->bufSize;
-        } else {
-            bufFree = ego->a - ego->b;
-            if (bufFree < 0)
-                bufFree += ego->bufSize;
-        }
-    } while (static_cast<size_t>(bufFree) < wantWrite);
-
-    size_t maxWrite = (ego->empty ? ego->bufSize : (ego->a < ego->b ? ego->bufSize - ego->b : ego->a - ego->b));
-    size_t write1 = (wantWrite > maxWrite ? maxWrite : wantWrite);
-    size_t write2 = (write1 < wantWrite ? wantWrite - write1 : 0);
-
-    size_t bLocal = ego->b;
-
-    lock.unlock();
-
-    memcpy(ego->buffer + bLocal, ptr, write1);
-    if (write2)
-        memcpy(ego->buffer, static_cast<char*>(ptr) + maxWrite, write2);
+    size_t b = ego->writeIndex % ego->bufSize;
+    size_t write1 = std::min(wantWrite, ego->bufSize - b);
 
-    lock.lock();
+    memcpy(ego->buffer + b, ptr, write1);
+    if (write1 < wantWrite)
+        memcpy(ego->buffer, static_cast<char*>(ptr) + write1, wantWrite - write1);
 
     //ego->bytesCurl += wantWrite;
-    ego->b += wantWrite;
-    if (ego->b >= ego->bufSize)
-        ego->b -= ego->bufSize;
-    if (ego->empty) {
-        ego->empty = false;
-        ego->cond.notify_one();
-    }
-    if (ego->waitForInitialFillSize) {
-        int currentFillSize = ego->b - ego->a;
-        if (currentFillSize <= 0)
-            currentFillSize += ego->bufSize;
-        if (static_cast<size_t>(currentFillSize) >= ego->initialFillSize) {
-            log_debug("buffer: initial fillsize reached");
-            ego->waitForInitialFillSize = false;
-            ego->cond.notify_one();
-        }
-    }
+    ego->commitWrite(wantWrite);
 
     return wantWrite;
 }
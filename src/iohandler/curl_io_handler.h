@@ -39,10 +39,15 @@
 
 #include "common.h"
 #include "io_handler_buffer_helper.h"
+#include "util/curl_handle_pool.h"
 
 class CurlIOHandler : public IOHandlerBufferHelper {
 public:
-    CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize);
+    /// \param curl_handle handle owned by the caller, nullptr to take one
+    /// from pool or to create a new one
+    CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize,
+        std::shared_ptr<StreamReactor> reactor = nullptr,
+        std::shared_ptr<CurlHandlePool> pool = nullptr);
 
     void open(enum UpnpOpenFileMode mode) override;
     void close() override;
@@ -50,11 +55,25 @@ public:
 private:
     CURL* curl_handle;
     bool external_curl_handle;
+    std::shared_ptr<CurlHandlePool> pool;
+    CurlHandlePool::Handle pooledHandle;
     std::string URL;
     //off_t bytesCurl;
+    /// \brief the loop paused the transfer because the buffer is full
+    bool paused;
 
     static size_t curlCallback(void* ptr, size_t size, size_t nmemb, void* data);
     void threadProc() override;
+
+    void setupHandle();
+    /// \brief restarts the transfer at the position requested by seek(),
+    /// the mutex must be held
+    void applySeek();
+
+    bool attach() override;
+    void detach() override;
+    void resume() override;
+    void onCurlDone(CURLcode result) override;
 };
 
 #endif // __CURL_IO_HANDLER_H__
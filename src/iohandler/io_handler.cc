@@ -116,6 +116,20 @@ off_t IOHandler::tell()
     return -1;
 }
 
+/// \brief Return the descriptor the data is read from or written to, -1
+/// if it can not be polled.
+int IOHandler::getFd()
+{
+    return -1;
+}
+
+/// \brief Checks whether the source ended without an error, called
+/// after the descriptor of getFd() was read to its end.
+bool IOHandler::endedCleanly()
+{
+    return true;
+}
+
 /// \fn static int web_close (UpnpWebFileHandle f)
 /// \brief Closes a previously opened file.
 /// \param f Handle of the file.
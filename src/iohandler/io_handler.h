@@ -70,6 +70,14 @@ public:
     /// \brief Return the current stream position.
     virtual off_t tell();
 
+    /// \brief Return the descriptor the data is read from or written to, -1
+    /// if it can not be polled.
+    virtual int getFd();
+
+    /// \brief Checks whether the source ended without an error, called
+    /// after the descriptor of getFd() was read to its end.
+    virtual bool endedCleanly();
+
     /// \brief Close/free previously opened/initialized data.
     virtual void close();
 };
@@ -32,9 +32,13 @@
 #include "io_handler_buffer_helper.h"
 #include "config/config_manager.h"
 
+#include <algorithm>
+
 using namespace std;
 
-IOHandlerBufferHelper::IOHandlerBufferHelper(size_t bufSize, size_t initialFillSize)
+IOHandlerBufferHelper::IOHandlerBufferHelper(size_t bufSize, size_t initialFillSize, std::shared_ptr<StreamReactor> reactor)
+    : reactor(std::move(reactor))
+    , loop(nullptr)
 {
     if (bufSize <= 0)
         throw std::runtime_error("bufSize must be positive");
@@ -49,10 +53,11 @@ IOHandlerBufferHelper::IOHandlerBufferHelper(size_t bufSize, size_t initialFillS
     threadShutdown = false;
     eof = false;
     readError = false;
-    a = b = posRead = 0;
-    empty = true;
-    signalAfterEveryRead = false;
+    readIndex = writeIndex = 0;
+    posRead = 0;
     checkSocket = false;
+    readerWaiting = writerWaiting = false;
+    waitCount = 0;
 
     seekEnabled = false;
     doSeek = false;
@@ -66,7 +71,15 @@ void IOHandlerBufferHelper::open(enum UpnpOpenFileMode mode)
     if (buffer == nullptr)
         throw std::runtime_error("Failed to allocate memory for transcoding buffer!");
 
-    startBufferThread();
+    if (reactor != nullptr) {
+        loop = reactor->getLoop();
+        bool attached = false;
+        loop->call([&]() { attached = attach(); });
+        if (!attached)
+            loop = nullptr;
+    }
+    if (loop == nullptr)
+        startBufferThread();
     isOpen = true;
 }
 
@@ -83,66 +96,150 @@ size_t IOHandlerBufferHelper::read(char* buf, size_t length)
     // length must be positive
     assert(length > 0);
 
-    unique_lock<std::mutex> lock(mutex);
-
-    while ((empty || waitForInitialFillSize) && !(threadShutdown || eof || readError)) {
-        if (checkSocket) {
-            checkSocket = false;
-            return CHECK_SOCKET;
+    size_t currentFillSize = getFillSize();
+    if (currentFillSize == 0 || waitForInitialFillSize) {
+        unique_lock<std::mutex> lock(mutex);
+        // the buffer thread checks readerWaiting after publishing new data,
+        // so either it sees the flag or we see the data
+        readerWaiting = true;
+        while ((getFillSize() == 0 || waitForInitialFillSize) && !(threadShutdown || eof || readError)) {
+            if (checkSocket) {
+                checkSocket = false;
+                readerWaiting = false;
+                return CHECK_SOCKET;
+            }
+            waitCount++;
+            // a loop does not block in the read of the source, so we
+            // have to tell libupnp to check the socket ourselves
+            if (loop == nullptr)
+                cond.wait(lock);
+            else if (cond.wait_for(lock, std::chrono::seconds(BUFFER_CHECK_SOCKET_TIMEOUT)) == std::cv_status::timeout)
+                checkSocket = true;
         }
-        cond.wait(lock);
+        readerWaiting = false;
+
+        if (readError || threadShutdown)
+            return -1;
+        currentFillSize = getFillSize();
+        // a loop reads the descriptor directly, past the checks in the
+        // read() of the source
+        if (currentFillSize == 0 && eof)
+            return endedCleanly() ? 0 : -1;
     }
 
-    if (readError || threadShutdown)
-        return -1;
-    if (empty && eof)
-        return 0;
+    size_t a = readIndex % bufSize;
+    size_t didRead = std::min(length, currentFillSize);
+    size_t read1 = std::min(didRead, bufSize - a);
 
-    size_t bLocal = b;
-    lock.unlock();
+    memcpy(buf, buffer + a, read1);
+    if (read1 < didRead)
+        memcpy(buf + read1, buffer, didRead - read1);
 
-    // we ensured with the while above that the buffer isn't empty
-    int currentFillSize = bLocal - a;
-    if (currentFillSize <= 0)
-        currentFillSize += bufSize;
-    size_t maxRead1 = (a < bLocal ? bLocal - a : bufSize - a);
-    size_t read1 = (maxRead1 > length ? length : maxRead1);
-    size_t maxRead2 = currentFillSize - read1;
-    size_t read2 = (read1 < length ? length - read1 : 0);
-    if (read2 > maxRead2)
-        read2 = maxRead2;
+    readIndex += didRead;
+    posRead += didRead;
 
-    memcpy(buf, buffer + a, read1);
-    if (read2)
-        memcpy(buf + read1, buffer, read2);
+    if (writerWaiting.exchange(false)) {
+        if (loop != nullptr) {
+            loop->post([this]() { resume(); });
+        } else {
+            std::lock_guard<std::mutex> lock(mutex);
+            cond.notify_all();
+        }
+    }
 
-    size_t didRead = read1 + read2;
+    return didRead;
+}
+
+size_t IOHandlerBufferHelper::getWritableChunk() const
+{
+    size_t b = writeIndex % bufSize;
+    return std::min(bufSize - getFillSize(), bufSize - b);
+}
 
-    lock.lock();
+bool IOHandlerBufferHelper::waitForSpace(size_t length)
+{
+    if (bufSize - getFillSize() >= length && !doSeek && !threadShutdown)
+        return true;
 
-    bool signalled = false;
-    // was the buffer full or became it "full" while we read?
-    if (signalAfterEveryRead || a == b) {
-        cond.notify_one();
-        signalled = true;
+    unique_lock<std::mutex> lock(mutex);
+    // read() checks writerWaiting after consuming data
+    writerWaiting = true;
+    while (bufSize - getFillSize() < length && !doSeek && !threadShutdown) {
+        waitCount++;
+        cond.wait(lock);
+        writerWaiting = true;
     }
+    writerWaiting = false;
+    return !doSeek && !threadShutdown;
+}
 
-    a += didRead;
-    if (a >= bufSize)
-        a -= bufSize;
-    if (a == b) {
-        empty = true;
-        if (!signalled)
-            cond.notify_one();
+void IOHandlerBufferHelper::commitWrite(size_t length)
+{
+    writeIndex += length;
+
+    if (waitForInitialFillSize && getFillSize() >= initialFillSize) {
+        std::lock_guard<std::mutex> lock(mutex);
+        log_debug("buffer: initial fillsize reached");
+        waitForInitialFillSize = false;
+        cond.notify_all();
+    } else if (readerWaiting) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cond.notify_all();
     }
+}
 
-    posRead += didRead;
-    return didRead;
+void IOHandlerBufferHelper::signalCheckSocket()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    checkSocket = true;
+    cond.notify_all();
+}
+
+void IOHandlerBufferHelper::signalEnd(bool error)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!threadShutdown) {
+        if (error)
+            readError = true;
+        else
+            eof = true;
+    }
+    // ensure that read() doesn't wait for us to fill the buffer
+    cond.notify_all();
+}
+
+bool IOHandlerBufferHelper::seekInBuffer()
+{
+    if (seekWhence != SEEK_SET && !(seekWhence == SEEK_CUR && seekOffset > 0))
+        return false;
+
+    off_t relSeek = seekOffset;
+    if (seekWhence == SEEK_SET)
+        relSeek -= posRead;
+
+    // note: seeking could be optimized some more (backward seeking)
+    // but this should suffice for now
+    if (relSeek < 0 || static_cast<size_t>(relSeek) > getFillSize())
+        return false;
+
+    // we have everything we need in the buffer already
+    readIndex += relSeek;
+    posRead += relSeek;
+    /// \todo do we need to wait for initialFillSize again?
+
+    doSeek = false;
+    cond.notify_all();
+    return true;
+}
+
+void IOHandlerBufferHelper::resetBuffer()
+{
+    readIndex = writeIndex = 0;
 }
 
 void IOHandlerBufferHelper::seek(off_t offset, int whence)
 {
-    log_debug("seek called: %lld {}", offset, whence);
+    log_debug("seek called: {} {}", offset, whence);
     if (!seekEnabled)
         throw std::runtime_error("seek currently disabled in this IOHandlerBufferHelper");
 
@@ -161,12 +258,14 @@ void IOHandlerBufferHelper::seek(off_t offset, int whence)
 
     // if another seek isn't processed yet - well we don't care as this new seek
     // will change the position anyway
-    doSeek = true;
     seekOffset = offset;
     seekWhence = whence;
+    doSeek = true;
 
     // tell the probably sleeping thread to process our seek
-    cond.notify_one();
+    cond.notify_all();
+    if (loop != nullptr)
+        loop->post([this]() { resume(); });
 
     // wait until the seek has been processed
     cond.wait(lock, [&]() {
@@ -179,7 +278,15 @@ void IOHandlerBufferHelper::close()
     if (!isOpen)
         throw std::runtime_error("close called on closed IOHandlerBufferHelper");
     isOpen = false;
-    stopBufferThread();
+    if (loop != nullptr) {
+        loop->call([this]() { detach(); });
+        loop = nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        threadShutdown = true;
+        cond.notify_all();
+    } else {
+        stopBufferThread();
+    }
     FREE(buffer);
     buffer = nullptr;
 }
@@ -199,7 +306,7 @@ void IOHandlerBufferHelper::stopBufferThread()
 {
     unique_lock<std::mutex> lock(mutex);
     threadShutdown = true;
-    cond.notify_one();
+    cond.notify_all();
     lock.unlock();
 
     if (bufferThread)
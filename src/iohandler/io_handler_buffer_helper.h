@@ -32,6 +32,7 @@
 #ifndef __IO_HANDLER_BUFFER_HELPER_H__
 #define __IO_HANDLER_BUFFER_HELPER_H__
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <pthread.h>
@@ -39,11 +40,25 @@
 
 #include "common.h"
 #include "io_handler.h"
+#include "stream_reactor.h"
+
+// read() returns CHECK_SOCKET after waiting this long for data
+// from a stream loop, in seconds
+#define BUFFER_CHECK_SOCKET_TIMEOUT 6
 
 /// \brief a IOHandler with buffer support
 /// the buffer is only for read(). write() is not supported
 /// the public functions of this class are *not* thread safe!
-class IOHandlerBufferHelper : public IOHandler {
+///
+/// The buffer is a single producer, single consumer ring: read() only moves
+/// readIndex and the buffer thread only moves writeIndex, so neither takes
+/// the mutex while data flows. The mutex and condition are only used when
+/// one side has to wait for the other because the buffer ran empty or full,
+/// for seeks and for the end of the stream.
+///
+/// Subclasses that can fill the buffer from events are attached to a loop of
+/// the StreamReactor, the others get a buffer thread of their own.
+class IOHandlerBufferHelper : public IOHandler, public ReactorSource {
 public:
     /// \brief get an instance of a IOHandlerBufferHelper
     /// \param bufSize the size of the buffer in bytes
@@ -51,7 +66,8 @@ public:
     /// \param initialFillSize the number of bytes which have to be in the buffer
     /// before the first read at the very beginning or after a seek returns;
     /// 0 disables the delay
-    IOHandlerBufferHelper(size_t bufSize, size_t initialFillSize);
+    /// \param reactor event loops to fill the buffer, nullptr to use a buffer thread
+    IOHandlerBufferHelper(size_t bufSize, size_t initialFillSize, std::shared_ptr<StreamReactor> reactor = nullptr);
     ~IOHandlerBufferHelper() override;
 
     // inherited from IOHandler
@@ -60,29 +76,77 @@ public:
     void seek(off_t offset, int whence) override;
     void close() override;
 
+    /// \brief Number of times read() or the buffer thread had to wait for the other side.
+    size_t getWaitCount() const { return waitCount; }
+
 protected:
     size_t bufSize;
     size_t initialFillSize;
     char* buffer;
     bool isOpen;
-    bool eof;
-    bool readError;
-    bool waitForInitialFillSize;
-    bool signalAfterEveryRead;
-    bool checkSocket;
+    std::atomic_bool eof;
+    std::atomic_bool readError;
+    std::atomic_bool waitForInitialFillSize;
+    std::atomic_bool checkSocket;
 
     // buffer stuff..
-    bool empty;
-    size_t a;
-    size_t b;
+    /// \brief bytes read from and written to the buffer since the last reset,
+    /// the position in the buffer is the index modulo bufSize
+    std::atomic_size_t readIndex;
+    std::atomic_size_t writeIndex;
     off_t posRead;
 
+    /// \brief number of bytes in the buffer
+    size_t getFillSize() const { return writeIndex - readIndex; }
+
+    /// \brief number of bytes the buffer thread can write at writeIndex
+    /// without wrapping around
+    size_t getWritableChunk() const;
+
+    /// \brief called by the buffer thread, waits until length bytes can be written
+    /// \return false if the thread has to shut down or a seek is pending
+    bool waitForSpace(size_t length);
+
+    /// \brief called by the buffer thread after length bytes were written at writeIndex
+    void commitWrite(size_t length);
+
+    /// \brief called by the buffer thread to make read() return CHECK_SOCKET
+    void signalCheckSocket();
+
+    /// \brief called by the buffer thread when the stream ended
+    /// \param error true if the stream ended with an error
+    void signalEnd(bool error);
+
+    /// \brief performs a pending forward seek in the data already in the buffer,
+    /// the mutex must be held
+    /// \return true if the seek was done
+    bool seekInBuffer();
+
+    /// \brief drops the data in the buffer, the mutex must be held while a seek is pending
+    void resetBuffer();
+
     // seek stuff...
     bool seekEnabled;
-    bool doSeek;
+    std::atomic_bool doSeek;
     off_t seekOffset;
     int seekWhence;
 
+    // event loop stuff..
+    std::shared_ptr<StreamReactor> reactor;
+    /// \brief loop the stream is attached to, nullptr if it uses a buffer thread
+    StreamReactor::Loop* loop;
+
+    /// \brief starts filling the buffer from loop, called on the loop thread
+    /// \return false if the stream needs a buffer thread instead
+    virtual bool attach() { return false; }
+
+    /// \brief stops filling the buffer, called on the loop thread
+    virtual void detach() { }
+
+    /// \brief called on the loop thread after read() made space while the
+    /// writer was waiting for it, or after seek() requested a seek
+    virtual void resume() { }
+
     // thread stuff..
     void startBufferThread();
     void stopBufferThread();
@@ -90,7 +154,13 @@ protected:
     virtual void threadProc() = 0;
 
     pthread_t bufferThread;
-    bool threadShutdown;
+    std::atomic_bool threadShutdown;
+
+    /// \brief set while a side waits on cond, the other side only
+    /// takes the mutex to wake it up then
+    std::atomic_bool readerWaiting;
+    std::atomic_bool writerWaiting;
+    std::atomic_size_t waitCount;
 
     std::condition_variable cond;
     std::mutex mutex;
@@ -30,9 +30,28 @@
 /// \file io_handler_chainer.cc
 
 #include "io_handler_chainer.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+#include <poll.h>
+
 #include "exceptions.h"
 
-IOHandlerChainer::IOHandlerChainer(std::unique_ptr<IOHandler>& readFrom, std::unique_ptr<IOHandler>& writeTo, int chunkSize)
+/// \brief Interval after which the chunk size is adapted
+#define IOHC_ADAPT_INTERVAL std::chrono::milliseconds(250)
+/// \brief The chunk holds about this much of the stream
+#define IOHC_CHUNK_DURATION_DIVISOR 50
+/// \brief Milliseconds between checks for a shutdown while waiting
+#define IOHC_POLL_TIMEOUT 1000
+
+static bool isWritable(int fd, int timeout)
+{
+    struct pollfd out = { fd, POLLOUT, 0 };
+    return poll(&out, 1, timeout) > 0;
+}
+
+IOHandlerChainer::IOHandlerChainer(std::unique_ptr<IOHandler>& readFrom, std::unique_ptr<IOHandler>& writeTo, int chunkSize, int maxChunkSize)
 {
     if (chunkSize <= 0)
         throw std::runtime_error("chunkSize must be positive");
@@ -40,10 +59,16 @@ IOHandlerChainer::IOHandlerChainer(std::unique_ptr<IOHandler>& readFrom, std::un
         throw std::runtime_error("readFrom and writeTo need to be set");
     status = 0;
     this->chunkSize = chunkSize;
+    minChunkSize = chunkSize;
+    this->maxChunkSize = std::max(chunkSize, maxChunkSize);
+    bytesMoved = 0;
+    stalls = 0;
+    spliced = false;
+    intervalBytes = 0;
     this->readFrom = std::move(readFrom);
     this->writeTo = std::move(writeTo);
-    readFrom->open(UPNP_READ);
-    buf = static_cast<char*>(MALLOC(chunkSize));
+    this->readFrom->open(UPNP_READ);
+    buf.resize(chunkSize);
     startThread();
 }
 
@@ -61,32 +86,19 @@ void IOHandlerChainer::threadProc()
             }
         } while (!threadShutdownCheck() && again);
 
-        bool stopLoop = false;
-        while (!threadShutdownCheck() && !stopLoop) {
-            int numRead = readFrom->read(buf, chunkSize);
-            if (numRead == 0) {
-                status = IOHC_NORMAL_SHUTDOWN;
-                stopLoop = true;
-            } else if (numRead < 0) {
-                status = IOHC_READ_ERROR;
-                stopLoop = true;
-            } else {
-                int numWritten = 0;
-                while (!threadShutdownCheck() && numWritten == 0 && !stopLoop) {
-                    numWritten = writeTo->write(buf, numRead);
-                    if (numWritten != 0 && numWritten != numRead) {
-                        status = IOHC_WRITE_ERROR;
-                        stopLoop = true;
-                    }
-                }
-            }
-        }
+        intervalStart = std::chrono::steady_clock::now();
+        int inFd = readFrom->getFd();
+        int outFd = writeTo->getFd();
+        if (threadShutdownCheck() || inFd == -1 || outFd == -1 || !spliceData(inFd, outFd))
+            copyData(outFd);
+
+        log_debug("chain done: {} bytes, {} stalls, chunk size {}", getBytesMoved(), getStalls(), getChunkSize());
     } catch (const std::runtime_error& e) {
         log_debug("{}", e.what());
         status = IOHC_EXCEPTION;
     }
     try {
-        if (threadShutdownCheck())
+        if (threadShutdownCheck() && status == 0)
             status = IOHC_FORCED_SHUTDOWN;
         readFrom->close();
         writeTo->close();
@@ -95,3 +107,115 @@ void IOHandlerChainer::threadProc()
         status = IOHC_EXCEPTION;
     }
 }
+
+void IOHandlerChainer::copyData(int outFd)
+{
+    bool stopLoop = false;
+    while (!threadShutdownCheck() && !stopLoop) {
+        int numRead = readFrom->read(buf.data(), chunkSize);
+        if (numRead == 0) {
+            status = IOHC_NORMAL_SHUTDOWN;
+            stopLoop = true;
+        } else if (numRead < 0) {
+            status = IOHC_READ_ERROR;
+            stopLoop = true;
+        } else {
+            int numWritten = 0;
+            bool blocked = false;
+            while (!threadShutdownCheck() && numWritten == 0 && !stopLoop) {
+                numWritten = writeTo->write(buf.data(), numRead);
+                if (numWritten == 0) {
+                    // one stall per chunk, however long writeTo keeps it
+                    if (!blocked)
+                        stalls++;
+                    blocked = true;
+                    if (outFd != -1)
+                        isWritable(outFd, IOHC_POLL_TIMEOUT);
+                } else if (numWritten != numRead) {
+                    status = IOHC_WRITE_ERROR;
+                    stopLoop = true;
+                }
+            }
+            if (numWritten == numRead)
+                account(numWritten);
+        }
+    }
+}
+
+bool IOHandlerChainer::spliceData(int inFd, int outFd)
+{
+#ifdef __linux__
+    bool blocked = false;
+    while (!threadShutdownCheck()) {
+        // the pipes limit the amount, there is no buffer to fill
+        ssize_t moved = splice(inFd, nullptr, outFd, nullptr, maxChunkSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (moved > 0) {
+            spliced = true;
+            blocked = false;
+            account(moved);
+            continue;
+        }
+        if (moved == 0) {
+            status = IOHC_NORMAL_SHUTDOWN;
+            return true;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno == EINVAL && !spliced) {
+            log_debug("splice not supported, copying the data");
+            return false;
+        }
+        if (errno != EAGAIN) {
+            log_debug("splice failed: {}", mt_strerror(errno));
+            status = errno == EPIPE ? IOHC_WRITE_ERROR : IOHC_READ_ERROR;
+            return true;
+        }
+
+        // wait for the end which is not ready, a full target counts once
+        // until data moves again
+        if (!isWritable(outFd, 0)) {
+            if (!blocked)
+                stalls++;
+            blocked = true;
+            isWritable(outFd, IOHC_POLL_TIMEOUT);
+            continue;
+        }
+        struct pollfd in = { inFd, POLLIN, 0 };
+        if (poll(&in, 1, IOHC_POLL_TIMEOUT) < 0 && errno != EINTR) {
+            status = IOHC_READ_ERROR;
+            return true;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void IOHandlerChainer::account(size_t bytes)
+{
+    bytesMoved += bytes;
+    intervalBytes += bytes;
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = now - intervalStart;
+    if (elapsed < IOHC_ADAPT_INTERVAL)
+        return;
+
+    // enough for 1/IOHC_CHUNK_DURATION_DIVISOR seconds of the stream, as
+    // power of two between the initial and the maximum size
+    double throughput = intervalBytes / std::chrono::duration<double>(elapsed).count();
+    auto wanted = static_cast<int>(std::min<double>(throughput / IOHC_CHUNK_DURATION_DIVISOR, maxChunkSize));
+    int size = minChunkSize;
+    while (size < wanted && size * 2 <= maxChunkSize)
+        size *= 2;
+
+    if (size != chunkSize) {
+        log_debug("chunk size {} -> {} at {} bytes/s", chunkSize, size, static_cast<long long>(throughput));
+        chunkSize = size;
+        buf.resize(size);
+        buf.shrink_to_fit();
+    }
+    intervalStart = now;
+    intervalBytes = 0;
+}
@@ -38,30 +38,76 @@
 #define IOHC_WRITE_ERROR 4
 #define IOHC_EXCEPTION 5
 
+/// \brief Largest chunk the chain grows to for fast sources
+#define IOHC_MAX_CHUNK_SIZE (1024 * 1024)
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
 #include "io_handler.h"
 #include "util/thread_executor.h"
 
 /// \brief gets two IOHandler, starts a thread which reads from one IOHandler
 /// and writes the data to the other IOHandler
+///
+/// The chunk size follows the measured throughput, so that fast streams are
+/// moved with few large read/write pairs and slow ones do not hold a large
+/// buffer. If both handlers have a descriptor the data is moved with splice()
+/// without copying it to user space.
 class IOHandlerChainer : public ThreadExecutor {
 public:
     /// \brief initialize the IOHandlerChainer
     /// \param readFrom the IOHandler to read from
     /// \param writeTo the IOHandler to write to
-    /// \param chunkSize the amount of bytes to read/write at once. a buffer of
-    /// this size will be allocated
-    IOHandlerChainer(std::unique_ptr<IOHandler>& readFrom, std::unique_ptr<IOHandler>& writeTo, int chunkSize);
+    /// \param chunkSize the amount of bytes to read/write at once when the
+    /// chain starts, the chunk never gets smaller
+    /// \param maxChunkSize the amount of bytes the chunk may grow to
+    IOHandlerChainer(std::unique_ptr<IOHandler>& readFrom, std::unique_ptr<IOHandler>& writeTo, int chunkSize, int maxChunkSize = IOHC_MAX_CHUNK_SIZE);
     int getStatus() override { return status; }
 
+    /// \brief Number of bytes moved so far
+    off_t getBytesMoved() const { return bytesMoved; }
+
+    /// \brief Number of chunks writeTo was not ready to take
+    int getStalls() const { return stalls; }
+
+    /// \brief Whether the data was moved with splice()
+    bool isSpliced() const { return spliced; }
+
+    /// \brief Current chunk size
+    int getChunkSize() const { return chunkSize; }
+
 protected:
     void threadProc() override;
 
+    /// \brief Moves the data with read() and write()
+    /// \param outFd descriptor of writeTo to wait for when it is not ready,
+    /// -1 if there is none
+    void copyData(int outFd);
+
+    /// \brief Moves the data between the descriptors with splice()
+    /// \return false if the descriptors do not support splice()
+    bool spliceData(int inFd, int outFd);
+
+    /// \brief Counts the moved bytes and picks the chunk size for the
+    /// throughput of the last interval
+    void account(size_t bytes);
+
 private:
     int status;
-    char* buf;
-    int chunkSize;
+    std::vector<char> buf;
+    std::atomic<int> chunkSize;
+    int minChunkSize;
+    int maxChunkSize;
     std::unique_ptr<IOHandler> readFrom;
     std::unique_ptr<IOHandler> writeTo;
+
+    std::atomic<off_t> bytesMoved;
+    std::atomic<int> stalls;
+    std::atomic<bool> spliced;
+    std::chrono::steady_clock::time_point intervalStart;
+    size_t intervalBytes;
 };
 
 #endif // __IO_HANDLER_CHAINER_H__
@@ -42,6 +42,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <utility>
 
 MemIOHandler::MemIOHandler(const void* buffer, int length)
     : buffer(static_cast<char*>(MALLOC(length)))
@@ -59,9 +60,18 @@ MemIOHandler::MemIOHandler(const std::string& str)
     memcpy(this->buffer, str.c_str(), length);
 }
 
+MemIOHandler::MemIOHandler(std::shared_ptr<const std::string> data)
+    : buffer(const_cast<char*>(data->data()))
+    , length(data->length())
+    , shared(std::move(data))
+    , pos(-1)
+{
+}
+
 MemIOHandler::~MemIOHandler()
 {
-    FREE(buffer);
+    if (shared == nullptr)
+        FREE(buffer);
 }
 
 void MemIOHandler::open(enum UpnpOpenFileMode mode)
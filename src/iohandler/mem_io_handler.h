@@ -32,6 +32,9 @@
 #ifndef __MEM_IO_HANDLER_H__
 #define __MEM_IO_HANDLER_H__
 
+#include <memory>
+#include <string>
+
 #include "common.h"
 #include "io_handler.h"
 
@@ -42,6 +45,9 @@ protected:
     char* buffer;
     off_t length;
 
+    /// \brief shared data backing buffer, set if the handler does not own a copy
+    std::shared_ptr<const std::string> shared;
+
     /// \brief current offset in the buffer
     off_t pos;
 
@@ -50,6 +56,10 @@ public:
     /// \param buffer all operations will be done on this buffer.
     MemIOHandler(const void* buffer, int length);
     explicit MemIOHandler(const std::string& str);
+
+    /// \brief Serves the given data without copying it.
+    /// \param data shared buffer, kept alive for the lifetime of the handler.
+    explicit MemIOHandler(std::shared_ptr<const std::string> data);
     ~MemIOHandler() override;
 
     ///
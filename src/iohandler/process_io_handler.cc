@@ -35,8 +35,10 @@
 #include "util/process.h"
 #include <csignal>
 #include <fcntl.h>
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 #include <utility>
 
@@ -46,6 +48,9 @@
 
 #define MAX_TIMEOUTS 2 // maximum allowe consecutive timeouts
 
+// the output is closed shortly before the process exits
+#define EXIT_WAIT_STEPS 100 // 10 ms each
+
 ProcListItem::ProcListItem(std::shared_ptr<Executor> exec, bool abortOnDeath)
 {
     executor = std::move(exec);
@@ -81,6 +86,41 @@ bool ProcessIOHandler::abort()
     return abort;
 }
 
+bool ProcessIOHandler::endedCleanly()
+{
+    if (mainProc == nullptr)
+        return !abort();
+
+    for (int i = 0; i < EXIT_WAIT_STEPS && mainProc->isAlive(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // a process still running has produced all of its output
+    if (mainProc->isAlive())
+        return !abort();
+
+    int exitStatus = mainProc->getStatus();
+    if (exitStatus != EXIT_SUCCESS) {
+        log_warning("process exited with status {} at the end of its output", exitStatus);
+        return false;
+    }
+    return !abort();
+}
+
+bool ProcessIOHandler::terminatedEarly()
+{
+    if (mainProc == nullptr)
+        return false;
+    if (abort())
+        return true;
+    if (mainProc->isAlive())
+        return false;
+    if (mainProc->getStatus() != EXIT_SUCCESS)
+        return true;
+
+    // a short stream may be complete before it is read, the pipe still holds it
+    int pending = 0;
+    return fd < 0 || ioctl(fd, FIONREAD, &pending) != 0 || pending == 0;
+}
+
 void ProcessIOHandler::killAll()
 {
     for (const auto& i : procList) {
@@ -126,7 +166,7 @@ ProcessIOHandler::ProcessIOHandler(std::shared_ptr<ContentManager> content,
     this->mainProc = mainProc;
     this->ignoreSeek = ignoreSeek;
 
-    if ((mainProc != nullptr) && ((!mainProc->isAlive() || abort()))) {
+    if (terminatedEarly()) {
         killAll();
         throw std::runtime_error("process terminated early");
     }
@@ -144,13 +184,38 @@ ProcessIOHandler::ProcessIOHandler(std::shared_ptr<ContentManager> content,
     registerAll();
 }
 
+ProcessIOHandler::ProcessIOHandler(std::shared_ptr<ContentManager> content,
+    int fd,
+    const std::shared_ptr<Executor>& mainProc,
+    std::vector<std::shared_ptr<ProcListItem>> procList,
+    bool ignoreSeek)
+{
+    this->content = std::move(content);
+    this->fd = fd;
+    this->procList = std::move(procList);
+    this->mainProc = mainProc;
+    this->ignoreSeek = ignoreSeek;
+
+    if (terminatedEarly()) {
+        killAll();
+        ::close(fd);
+        this->fd = -1;
+        throw std::runtime_error("process terminated early");
+    }
+    registerAll();
+}
+
 void ProcessIOHandler::open(enum UpnpOpenFileMode mode)
 {
-    if ((mainProc != nullptr) && ((!mainProc->isAlive() || abort()))) {
+    if (terminatedEarly()) {
         killAll();
         throw std::runtime_error("process terminated early");
     }
 
+    // pipes are handed over open
+    if (filename.empty())
+        return;
+
     if (mode == UPNP_READ)
         fd = ::open(filename.c_str(), O_RDONLY | O_NONBLOCK);
     else if (mode == UPNP_WRITE)
@@ -177,7 +242,6 @@ size_t ProcessIOHandler::read(char* buf, size_t length)
     struct timeval timeout;
     ssize_t bytes_read = 0;
     size_t num_bytes = 0;
-    char* p_buffer = buf;
     int exit_status = EXIT_SUCCESS;
     int ret = 0;
     int timeout_count = 0;
@@ -224,22 +288,22 @@ size_t ProcessIOHandler::read(char* buf, size_t length)
 
         if (FD_ISSET(fd, &readSet)) {
             timeout_count = 0;
-            bytes_read = ::read(fd, p_buffer, length);
-            if (bytes_read == 0)
+            bytes_read = ::read(fd, buf, length);
+            if (bytes_read == 0) {
+                if (!endedCleanly())
+                    return -1;
                 break;
+            }
 
             if (bytes_read < 0) {
                 log_debug("aborting read!!!");
                 return -1;
             }
 
-            num_bytes = num_bytes + bytes_read;
-            length = length - bytes_read;
-
-            if (length <= 0)
-                break;
-
-            p_buffer = buf + num_bytes;
+            // hand out what the process produced so far, a slow or live
+            // transcoder must not hold back the data until buf is full
+            num_bytes = bytes_read;
+            break;
         }
     }
 
@@ -365,7 +429,7 @@ void ProcessIOHandler::close()
 {
     bool ret;
 
-    log_debug("terminating process, closing {}", this->filename.c_str());
+    log_debug("terminating process, closing {}", filename.empty() ? fmt::format("pipe {}", fd) : filename.string());
     unregisterAll();
 
     if (mainProc != nullptr) {
@@ -375,9 +439,13 @@ void ProcessIOHandler::close()
 
     killAll();
 
-    ::close(fd);
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
 
-    unlink(filename.c_str());
+    if (!filename.empty())
+        unlink(filename.c_str());
 
     if (!ret)
         throw std::runtime_error("failed to kill process!");
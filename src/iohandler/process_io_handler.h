@@ -57,7 +57,7 @@ protected:
 // forward declaration
 class ContentManager;
 
-/// \brief Allows the web server to read from a fifo.
+/// \brief Allows the web server to read from a fifo or a pipe.
 class ProcessIOHandler : public IOHandler {
 public:
     /// \brief Sets the filename to work with.
@@ -69,6 +69,15 @@ public:
         std::vector<std::shared_ptr<ProcListItem>> procList = std::vector<std::shared_ptr<ProcListItem>>(),
         bool ignoreSeek = false);
 
+    /// \brief Takes over an already open pipe end.
+    /// \param fd descriptor to read from or write to, closed with the handler
+    /// \param procList associated processes that will be terminated once
+    /// they are no longer needed
+    ProcessIOHandler(std::shared_ptr<ContentManager> content,
+        int fd, const std::shared_ptr<Executor>& mainProc,
+        std::vector<std::shared_ptr<ProcListItem>> procList = std::vector<std::shared_ptr<ProcListItem>>(),
+        bool ignoreSeek = false);
+
     /// \brief Opens file for reading (writing is not supported)
     void open(enum UpnpOpenFileMode mode) override;
 
@@ -95,6 +104,11 @@ public:
     /// \brief Close a previously opened file and kills the kill_pid process
     void close() override;
 
+    int getFd() override { return fd; }
+
+    /// \brief Checks the exit status of the main process once its output ended.
+    bool endedCleanly() override;
+
     ~ProcessIOHandler() override;
 
 protected:
@@ -106,16 +120,18 @@ protected:
     /// \brief Main process used for reading
     std::shared_ptr<Executor> mainProc;
 
-    /// \brief name of the file or fifo to read the data from
+    /// \brief name of the file or fifo to read the data from, empty for pipes
     fs::path filename;
 
     /// \brief file descriptor
-    int fd {};
+    int fd { -1 };
 
     /// \brief if this flag is set seek on a fifo will not return an error
     bool ignoreSeek;
 
     bool abort();
+    /// \brief Checks whether the main process failed or exited without output.
+    bool terminatedEarly();
     void killAll();
     void registerAll();
     void unregisterAll();
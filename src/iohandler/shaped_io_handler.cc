@@ -0,0 +1,69 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    shaped_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file shaped_io_handler.cc
+
+#include "shaped_io_handler.h"
+
+ShapedIOHandler::ShapedIOHandler(std::shared_ptr<BandwidthShaper> shaper, const std::string& client, const std::string& name, std::unique_ptr<IOHandler> handler)
+    : shaper(std::move(shaper))
+    , handler(std::move(handler))
+{
+    stream = this->shaper->addStream(client, name);
+}
+
+ShapedIOHandler::~ShapedIOHandler()
+{
+    if (stream != nullptr)
+        shaper->removeStream(stream);
+}
+
+// the underlying handler is open already
+void ShapedIOHandler::open(enum UpnpOpenFileMode mode)
+{
+}
+
+size_t ShapedIOHandler::read(char* buf, size_t length)
+{
+    size_t ret = handler->read(buf, shaper->getQuantum(length));
+    if (ret > 0 && ret <= length)
+        shaper->consume(*stream, ret);
+    return ret;
+}
+
+void ShapedIOHandler::seek(off_t offset, int whence)
+{
+    handler->seek(offset, whence);
+}
+
+off_t ShapedIOHandler::tell()
+{
+    return handler->tell();
+}
+
+void ShapedIOHandler::close()
+{
+    handler->close();
+    shaper->removeStream(stream);
+    stream = nullptr;
+}
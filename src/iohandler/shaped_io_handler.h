@@ -0,0 +1,55 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    shaped_io_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file shaped_io_handler.h
+/// \brief Definition of the ShapedIOHandler class.
+#ifndef GERBERA_SHAPED_IO_HANDLER_H
+#define GERBERA_SHAPED_IO_HANDLER_H
+
+#include <memory>
+
+#include "io_handler.h"
+#include "util/bandwidth_shaper.h"
+
+/// \brief Sends the data of an open handler at the rate granted by a BandwidthShaper.
+class ShapedIOHandler : public IOHandler {
+public:
+    /// \param client address of the client receiving the stream
+    /// \param name shown in the stream statistics
+    /// \param handler open handler providing the data
+    ShapedIOHandler(std::shared_ptr<BandwidthShaper> shaper, const std::string& client, const std::string& name, std::unique_ptr<IOHandler> handler);
+    ~ShapedIOHandler() override;
+
+    void open(enum UpnpOpenFileMode mode) override;
+    size_t read(char* buf, size_t length) override;
+    void seek(off_t offset, int whence) override;
+    off_t tell() override;
+    void close() override;
+
+protected:
+    std::shared_ptr<BandwidthShaper> shaper;
+    std::shared_ptr<BandwidthShaper::Stream> stream;
+    std::unique_ptr<IOHandler> handler;
+};
+
+#endif // GERBERA_SHAPED_IO_HANDLER_H
@@ -0,0 +1,342 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    stream_reactor.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file stream_reactor.cc
+
+#include "stream_reactor.h"
+
+#include <algorithm>
+#include <future>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "util/tools.h"
+
+#define MAX_EVENTS 64
+
+StreamReactor::Loop::Loop()
+{
+    shutdownFlag = false;
+    sourceCount = 0;
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        throw std::runtime_error("Failed to create epoll instance: " + mt_strerror(errno));
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd == -1) {
+        ::close(epollFd);
+        throw std::runtime_error("Failed to create eventfd: " + mt_strerror(errno));
+    }
+
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+#ifdef HAVE_CURL
+    curlTimerSet = false;
+    multiHandle = curl_multi_init();
+    curl_multi_setopt(multiHandle, CURLMOPT_SOCKETFUNCTION, curlSocketCallback);
+    curl_multi_setopt(multiHandle, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multiHandle, CURLMOPT_TIMERFUNCTION, curlTimerCallback);
+    curl_multi_setopt(multiHandle, CURLMOPT_TIMERDATA, this);
+#endif
+
+    thread_ = std::thread { &Loop::threadProc, this };
+}
+
+StreamReactor::Loop::~Loop()
+{
+    stop();
+#ifdef HAVE_CURL
+    curl_multi_cleanup(multiHandle);
+#endif
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+bool StreamReactor::Loop::post(std::function<void()> task)
+{
+    AutoLock lock(mutex);
+    if (shutdownFlag)
+        return false;
+    tasks.push_back(std::move(task));
+    uint64_t one = 1;
+    if (::write(wakeFd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+        log_error("Failed to wake up stream loop: {}", mt_strerror(errno));
+    return true;
+}
+
+void StreamReactor::Loop::call(const std::function<void()>& task)
+{
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        task();
+        return;
+    }
+
+    std::promise<void> done;
+    auto future = done.get_future();
+    bool posted = post([&]() {
+        try {
+            task();
+            done.set_value();
+        } catch (...) {
+            done.set_exception(std::current_exception());
+        }
+    });
+
+    // nothing runs on the loop any more
+    if (!posted) {
+        task();
+        return;
+    }
+    future.get();
+}
+
+void StreamReactor::Loop::stop()
+{
+    {
+        AutoLock lock(mutex);
+        if (shutdownFlag)
+            return;
+        shutdownFlag = true;
+        uint64_t one = 1;
+        if (::write(wakeFd, &one, sizeof(one)) == -1 && errno != EAGAIN)
+            log_error("Failed to wake up stream loop: {}", mt_strerror(errno));
+    }
+    if (thread_.joinable())
+        thread_.join();
+
+    // tasks accepted before the shutdown, call() waits for them
+    runTasks();
+}
+
+void StreamReactor::Loop::addFd(int fd, ReactorSource* source)
+{
+    fdSources[fd] = source;
+    sourceCount++;
+    setFdEnabled(fd, true);
+}
+
+void StreamReactor::Loop::setFdEnabled(int fd, bool enabled)
+{
+    // a disabled descriptor is removed from the epoll set altogether,
+    // epoll reports hangups even without any requested event
+    if (enabled) {
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1 && errno != EEXIST)
+            log_error("Failed to watch descriptor {}: {}", fd, mt_strerror(errno));
+    } else {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+void StreamReactor::Loop::removeFd(int fd)
+{
+    if (fdSources.erase(fd) == 0)
+        return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    sourceCount--;
+}
+
+#ifdef HAVE_CURL
+void StreamReactor::Loop::addCurl(CURL* handle, ReactorSource* source)
+{
+    curlSources[handle] = source;
+    sourceCount++;
+    curl_multi_add_handle(multiHandle, handle);
+}
+
+void StreamReactor::Loop::removeCurl(CURL* handle)
+{
+    if (curlSources.erase(handle) == 0)
+        return;
+    curl_multi_remove_handle(multiHandle, handle);
+    sourceCount--;
+}
+
+void StreamReactor::Loop::curlAction(curl_socket_t socket, int events)
+{
+    int running = 0;
+    curl_multi_socket_action(multiHandle, socket, events, &running);
+
+    CURLMsg* msg;
+    int left;
+    while ((msg = curl_multi_info_read(multiHandle, &left)) != nullptr) {
+        if (msg->msg != CURLMSG_DONE)
+            continue;
+        // msg is gone once the handle is removed
+        CURL* handle = msg->easy_handle;
+        CURLcode result = msg->data.result;
+        auto it = curlSources.find(handle);
+        if (it == curlSources.end())
+            continue;
+        ReactorSource* source = it->second;
+        removeCurl(handle);
+        source->onCurlDone(result);
+    }
+}
+
+int StreamReactor::Loop::curlSocketCallback(CURL* handle, curl_socket_t socket, int what, void* userp, void* socketp)
+{
+    auto loop = static_cast<Loop*>(userp);
+
+    if (what == CURL_POLL_REMOVE) {
+        epoll_ctl(loop->epollFd, EPOLL_CTL_DEL, socket, nullptr);
+        loop->curlSockets.erase(socket);
+        return 0;
+    }
+
+    struct epoll_event ev = {};
+    ev.events = ((what & CURL_POLL_IN) ? EPOLLIN : 0) | ((what & CURL_POLL_OUT) ? EPOLLOUT : 0);
+    ev.data.fd = socket;
+    bool known = loop->curlSockets.find(socket) != loop->curlSockets.end();
+    if (epoll_ctl(loop->epollFd, known ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, socket, &ev) == -1)
+        log_error("Failed to watch curl socket {}: {}", socket, mt_strerror(errno));
+    loop->curlSockets.insert(socket);
+    return 0;
+}
+
+int StreamReactor::Loop::curlTimerCallback(CURLM* multi, long timeoutMs, void* userp)
+{
+    auto loop = static_cast<Loop*>(userp);
+    loop->curlTimerSet = (timeoutMs >= 0);
+    if (loop->curlTimerSet)
+        loop->curlDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    return 0;
+}
+#endif
+
+int StreamReactor::Loop::getTimeout() const
+{
+#ifdef HAVE_CURL
+    if (curlTimerSet) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(curlDeadline - std::chrono::steady_clock::now());
+        return std::max(0, static_cast<int>(left.count()));
+    }
+#endif
+    return -1;
+}
+
+void StreamReactor::Loop::runTasks()
+{
+    uint64_t count;
+    if (::read(wakeFd, &count, sizeof(count)) == -1 && errno != EAGAIN)
+        log_error("Failed to read stream loop wakeups: {}", mt_strerror(errno));
+
+    std::vector<std::function<void()>> current;
+    {
+        AutoLock lock(mutex);
+        current.swap(tasks);
+    }
+    for (const auto& task : current) {
+        try {
+            task();
+        } catch (const std::runtime_error& e) {
+            log_error("Stream loop task failed: {}", e.what());
+        }
+    }
+}
+
+void StreamReactor::Loop::threadProc()
+{
+    struct epoll_event events[MAX_EVENTS];
+
+    while (true) {
+        {
+            AutoLock lock(mutex);
+            if (shutdownFlag)
+                break;
+        }
+
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, getTimeout());
+        if (count == -1) {
+            if (errno == EINTR)
+                continue;
+            log_error("Stream loop failed: {}", mt_strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                runTasks();
+                continue;
+            }
+
+            // the source may have been removed by an earlier event
+            auto it = fdSources.find(fd);
+            if (it != fdSources.end()) {
+                it->second->onReadable();
+                continue;
+            }
+
+#ifdef HAVE_CURL
+            int action = ((events[i].events & EPOLLIN) ? CURL_CSELECT_IN : 0)
+                | ((events[i].events & EPOLLOUT) ? CURL_CSELECT_OUT : 0)
+                | ((events[i].events & (EPOLLERR | EPOLLHUP)) ? CURL_CSELECT_ERR : 0);
+            curlAction(fd, action);
+#endif
+        }
+
+#ifdef HAVE_CURL
+        if (curlTimerSet && std::chrono::steady_clock::now() >= curlDeadline) {
+            curlTimerSet = false;
+            curlAction(CURL_SOCKET_TIMEOUT, 0);
+        }
+#endif
+    }
+}
+
+StreamReactor::StreamReactor(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < threadCount; i++)
+        loops.push_back(std::make_unique<Loop>());
+    log_debug("Started {} stream loops", threadCount);
+}
+
+StreamReactor::~StreamReactor()
+{
+    shutdown();
+}
+
+StreamReactor::Loop* StreamReactor::getLoop()
+{
+    auto loop = std::min_element(loops.begin(), loops.end(), [](const auto& a, const auto& b) {
+        return a->getSourceCount() < b->getSourceCount();
+    });
+    return loop->get();
+}
+
+void StreamReactor::shutdown()
+{
+    for (const auto& loop : loops)
+        loop->stop();
+}
@@ -0,0 +1,146 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    stream_reactor.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file stream_reactor.h
+/// \brief Definition of the StreamReactor class.
+#ifndef GERBERA_STREAM_REACTOR_H
+#define GERBERA_STREAM_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_CURL
+#include <curl/curl.h>
+#endif
+
+/// \brief Receives the events of a stream attached to a StreamReactor::Loop,
+/// all callbacks run on the thread of the loop.
+class ReactorSource {
+public:
+    virtual ~ReactorSource() = default;
+
+    /// \brief The descriptor added with Loop::addFd() is readable or was closed.
+    virtual void onReadable() { }
+
+#ifdef HAVE_CURL
+    /// \brief The transfer added with Loop::addCurl() finished, it has been
+    /// removed from the loop already.
+    virtual void onCurlDone(CURLcode result) { }
+#endif
+};
+
+/// \brief A fixed number of event loops that fill the buffers of all streams,
+/// so the number of threads does not grow with the number of streams.
+///
+/// Descriptors are watched with epoll and curl transfers are driven by the
+/// curl multi handle of the loop.
+class StreamReactor {
+public:
+    class Loop {
+    public:
+        Loop();
+        ~Loop();
+
+        /// \brief Runs task on the thread of the loop.
+        /// \return false if the loop was stopped and task was dropped
+        bool post(std::function<void()> task);
+
+        /// \brief Runs task on the thread of the loop and waits for it.
+        void call(const std::function<void()>& task);
+
+        /// \brief Stops the thread of the loop, tasks posted afterwards are dropped.
+        void stop();
+
+        /// \brief Number of streams attached to the loop.
+        size_t getSourceCount() const { return sourceCount; }
+
+        // the following functions may only be called on the thread of the loop
+
+        /// \brief Calls source->onReadable() whenever fd is readable.
+        void addFd(int fd, ReactorSource* source);
+
+        /// \brief Stops or resumes watching fd, e.g. while the buffer is full.
+        void setFdEnabled(int fd, bool enabled);
+
+        void removeFd(int fd);
+
+#ifdef HAVE_CURL
+        /// \brief Starts the transfer of handle, source->onCurlDone() is called
+        /// when it finished.
+        void addCurl(CURL* handle, ReactorSource* source);
+
+        void removeCurl(CURL* handle);
+#endif
+
+    protected:
+        int epollFd;
+        int wakeFd;
+        std::thread thread_;
+        bool shutdownFlag;
+        std::atomic_size_t sourceCount;
+
+        std::mutex mutex;
+        using AutoLock = std::lock_guard<decltype(mutex)>;
+        std::vector<std::function<void()>> tasks;
+
+        std::map<int, ReactorSource*> fdSources;
+
+        void threadProc();
+        void runTasks();
+        int getTimeout() const;
+
+#ifdef HAVE_CURL
+        CURLM* multiHandle;
+        std::map<CURL*, ReactorSource*> curlSources;
+        std::set<curl_socket_t> curlSockets;
+        bool curlTimerSet;
+        std::chrono::steady_clock::time_point curlDeadline;
+
+        void curlAction(curl_socket_t socket, int events);
+        static int curlSocketCallback(CURL* handle, curl_socket_t socket, int what, void* userp, void* socketp);
+        static int curlTimerCallback(CURLM* multi, long timeoutMs, void* userp);
+#endif
+    };
+
+    /// \param threadCount number of loops, 0 for one per processor core
+    explicit StreamReactor(unsigned int threadCount = 0);
+    ~StreamReactor();
+
+    /// \brief Returns the loop with the fewest streams attached.
+    Loop* getLoop();
+
+    void shutdown();
+
+protected:
+    std::vector<std::unique_ptr<Loop>> loops;
+};
+
+#endif // GERBERA_STREAM_REACTOR_H
@@ -0,0 +1,91 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    time_seek_io_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file time_seek_io_handler.cc
+
+#include "time_seek_io_handler.h"
+
+#include <utility>
+
+TimeSeekIOHandler::TimeSeekIOHandler(Opener opener, int bitrate, double start)
+    : opener(std::move(opener))
+    , bytesPerSecond(bitrate / 8.0)
+    , start(start)
+    , pos(0)
+{
+    if (bitrate <= 0)
+        throw std::runtime_error("TimeSeekIOHandler requires a bitrate");
+}
+
+void TimeSeekIOHandler::open(enum UpnpOpenFileMode mode)
+{
+    if (mode != UPNP_READ)
+        throw std::runtime_error("TimeSeekIOHandler only supports reading");
+
+    handler = opener(start);
+    pos = 0;
+}
+
+size_t TimeSeekIOHandler::read(char* buf, size_t length)
+{
+    size_t ret = handler->read(buf, length);
+    if (ret > 0 && ret != static_cast<size_t>(-1))
+        pos += ret;
+    return ret;
+}
+
+void TimeSeekIOHandler::seek(off_t offset, int whence)
+{
+    off_t target;
+    if (whence == SEEK_SET)
+        target = offset;
+    else if (whence == SEEK_CUR)
+        target = pos + offset;
+    else
+        throw std::runtime_error("TimeSeekIOHandler can not seek relative to the end");
+
+    if (target < 0)
+        throw std::runtime_error("TimeSeekIOHandler: invalid seek offset " + std::to_string(target));
+    if (target == pos)
+        return;
+
+    double time = start + target / bytesPerSecond;
+    log_debug("restarting stream at {}s for offset {}", time, target);
+    handler->close();
+    handler = opener(time);
+    pos = target;
+}
+
+off_t TimeSeekIOHandler::tell()
+{
+    return pos;
+}
+
+void TimeSeekIOHandler::close()
+{
+    if (handler != nullptr) {
+        handler->close();
+        handler = nullptr;
+    }
+}
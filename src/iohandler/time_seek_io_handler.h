@@ -0,0 +1,65 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    time_seek_io_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file time_seek_io_handler.h
+/// \brief Definition of the TimeSeekIOHandler class.
+#ifndef GERBERA_TIME_SEEK_IO_HANDLER_H
+#define GERBERA_TIME_SEEK_IO_HANDLER_H
+
+#include <functional>
+#include <memory>
+
+#include "common.h"
+#include "io_handler.h"
+
+/// \brief Makes a stream of constant bitrate seekable by restarting its producer.
+///
+/// Used for transcoded streams: instead of transcoding from the beginning
+/// and discarding data, a seek closes the running transcoder and starts a
+/// new one at the time corresponding to the requested byte offset.
+class TimeSeekIOHandler : public IOHandler {
+public:
+    /// \brief Opens the stream at the given time in seconds.
+    using Opener = std::function<std::unique_ptr<IOHandler>(double start)>;
+
+    /// \param opener starts the producer, the returned handler must be open
+    /// \param bitrate nominal bitrate of the stream in bits per second
+    /// \param start time in seconds that byte offset 0 corresponds to
+    TimeSeekIOHandler(Opener opener, int bitrate, double start);
+
+    void open(enum UpnpOpenFileMode mode) override;
+    size_t read(char* buf, size_t length) override;
+    void seek(off_t offset, int whence) override;
+    off_t tell() override;
+    void close() override;
+
+protected:
+    Opener opener;
+    std::unique_ptr<IOHandler> handler;
+    double bytesPerSecond;
+    double start;
+    off_t pos;
+};
+
+#endif // GERBERA_TIME_SEEK_IO_HANDLER_H
@@ -33,6 +33,7 @@
 #include "fanart_handler.h"
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "common.h"
@@ -40,8 +41,8 @@
 #include "util/tools.h"
 
 static const char* names[] = {
-    "/folder.jpg",
-    "/poster.jpg"
+    "folder.jpg",
+    "poster.jpg"
 };
 
 FanArtHandler::FanArtHandler(std::shared_ptr<ConfigManager> config)
@@ -66,6 +67,12 @@ fs::path FanArtHandler::getFanArtPath(const std::shared_ptr<CdsItem>& item)
     return "";
 }
 
+bool FanArtHandler::isFanArt(const fs::path& path)
+{
+    auto name = path.filename().string();
+    return std::any_of(std::begin(names), std::end(names), [&](const auto& n) { return name == n; });
+}
+
 void FanArtHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 {
     log_debug("Running fanart handler on {}", item->getLocation().c_str());
@@ -75,13 +82,19 @@ void FanArtHandler::fillMetadata(std::shared_ptr<CdsItem> item)
         auto resource = std::make_shared<CdsResource>(CH_FANART);
         resource->addAttribute(MetadataHandler::getResAttrName(R_PROTOCOLINFO), renderProtocolInfo("jpg"));
         resource->addParameter(RESOURCE_CONTENT_TYPE, ID3_ALBUM_ART);
+        resource->addOption(RESOURCE_OPTION_PATH, path);
         item->addResource(resource);
     }
 }
 
 std::unique_ptr<IOHandler> FanArtHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
 {
-    auto path = getFanArtPath(item);
+    // resources imported before the path was stored have to look again
+    fs::path path;
+    if (resNum >= 0 && resNum < item->getResourceCount())
+        path = item->getResource(resNum)->getOption(RESOURCE_OPTION_PATH);
+    if (path.empty())
+        path = getFanArtPath(item);
     log_debug("FanArt: Opening name: {}", path.c_str());
 
     auto io_handler = std::make_unique<FileIOHandler>(path);
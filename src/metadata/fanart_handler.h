@@ -42,6 +42,9 @@ public:
     void fillMetadata(std::shared_ptr<CdsItem> item) override;
     std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
 
+    /// \brief Checks if the file is picked up as fan art for its folder
+    static bool isFanArt(const fs::path& path);
+
 private:
     static fs::path getFanArtPath(const std::shared_ptr<CdsItem>& item);
 };
@@ -0,0 +1,294 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    image_scale_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file image_scale_handler.cc
+
+#ifdef HAVE_LIBJPEG
+
+#include "image_scale_handler.h" // API
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include <jpeglib.h>
+
+#include "config/config_manager.h"
+#include "iohandler/mem_io_handler.h"
+#include "util/tools.h"
+
+#define MIMETYPE_JPEG "image/jpeg"
+
+namespace {
+/// \brief libjpeg error manager leaving the library with longjmp instead of exit().
+struct JpegError {
+    struct jpeg_error_mgr pub;
+    jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void jpegErrorExit(j_common_ptr cinfo)
+{
+    auto err = reinterpret_cast<JpegError*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    longjmp(err->jump, 1);
+}
+
+/// \brief Buffers shared with libjpeg, allocated before setjmp so they survive a longjmp.
+struct JpegBuffers {
+    std::vector<unsigned char> row;
+    std::vector<unsigned int> sums;
+    std::vector<unsigned char> scaled;
+    std::vector<int> columns;
+    unsigned char* encoded = nullptr;
+    unsigned long encodedSize = 0;
+
+    ~JpegBuffers() { free(encoded); }
+};
+
+/// \brief Picks the DCT scaling that decodes the fewest pixels still covering the target size.
+void setDctScaling(struct jpeg_decompress_struct& dinfo, unsigned int targetWidth, unsigned int targetHeight)
+{
+    auto covers = [&](unsigned int num, unsigned int denom) {
+        return (dinfo.image_width * num + denom - 1) / denom >= targetWidth
+            && (dinfo.image_height * num + denom - 1) / denom >= targetHeight;
+    };
+    dinfo.scale_num = 1;
+    dinfo.scale_denom = 1;
+#if JPEG_LIB_VERSION >= 70 || defined(LIBJPEG_TURBO_VERSION)
+    // any multiple of 1/8
+    for (unsigned int num = 1; num < 8; num++) {
+        if (covers(num, 8)) {
+            dinfo.scale_num = num;
+            dinfo.scale_denom = 8;
+            break;
+        }
+    }
+#else
+    for (unsigned int denom = 8; denom > 1; denom /= 2) {
+        if (covers(1, denom)) {
+            dinfo.scale_denom = denom;
+            break;
+        }
+    }
+#endif
+}
+} // namespace
+
+ImageScaleHandler::ImageScaleHandler(std::shared_ptr<ConfigManager> config)
+    : MetadataHandler(std::move(config))
+{
+}
+
+bool ImageScaleHandler::getProfileSize(const std::string& profile, int& width, int& height)
+{
+    if (profile == D_JPEG_TN) {
+        width = 160;
+        height = 160;
+    } else if (profile == D_JPEG_SM) {
+        width = 640;
+        height = 480;
+    } else if (profile == D_JPEG_LRG) {
+        width = 4096;
+        height = 4096;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ImageScaleHandler::fitSize(int width, int height, int maxWidth, int maxHeight, int& outWidth, int& outHeight)
+{
+    if (width <= maxWidth && height <= maxHeight) {
+        outWidth = width;
+        outHeight = height;
+    } else if (static_cast<long>(width) * maxHeight >= static_cast<long>(height) * maxWidth) {
+        outWidth = maxWidth;
+        outHeight = std::max(1L, static_cast<long>(height) * maxWidth / width);
+    } else {
+        outWidth = std::max(1L, static_cast<long>(width) * maxHeight / height);
+        outHeight = maxHeight;
+    }
+}
+
+void ImageScaleHandler::fillMetadata(std::shared_ptr<CdsItem> item)
+{
+    auto resource = item->getResource(0);
+    std::string resolution = resource->getAttribute(MetadataHandler::getResAttrName(R_RESOLUTION));
+    if (!string_ok(resolution)) {
+        set_jpeg_resolution_resource(item, 0);
+        resolution = resource->getAttribute(MetadataHandler::getResAttrName(R_RESOLUTION));
+    }
+
+    int x;
+    int y;
+    if (!string_ok(resolution) || !check_resolution(resolution, &x, &y))
+        return;
+
+    for (const auto& profile : { D_JPEG_TN, D_JPEG_SM, D_JPEG_LRG }) {
+        int width;
+        int height;
+        getProfileSize(profile, width, height);
+        // the original already fits into this profile
+        if (x <= width && y <= height)
+            continue;
+
+        fitSize(x, y, width, height, width, height);
+        auto scaled = std::make_shared<CdsResource>(CH_IMAGE_SCALE);
+        scaled->addAttribute(MetadataHandler::getResAttrName(R_PROTOCOLINFO), renderProtocolInfo(MIMETYPE_JPEG));
+        scaled->addAttribute(MetadataHandler::getResAttrName(R_RESOLUTION), fmt::format("{}x{}", width, height));
+        scaled->addParameter(SCALED_IMAGE_PROFILE, profile);
+        item->addResource(scaled);
+    }
+}
+
+std::unique_ptr<IOHandler> ImageScaleHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
+{
+    auto res = item->getResource(resNum);
+    std::string profile = res->getParameter(SCALED_IMAGE_PROFILE);
+
+    int width;
+    int height;
+    if (!getProfileSize(profile, width, height))
+        throw std::runtime_error("ImageScaleHandler: got unknown profile: " + profile);
+
+    log_debug("Scaling {} to {}", item->getLocation().c_str(), profile);
+    auto data = scaleJpeg(item->getLocation(), width, height, config->getIntOption(CFG_IMPORT_SCALED_IMAGES_QUALITY));
+    return std::make_unique<MemIOHandler>(data);
+}
+
+std::string ImageScaleHandler::getMimeType()
+{
+    return MIMETYPE_JPEG;
+}
+
+std::string ImageScaleHandler::getContentVariant(const std::shared_ptr<CdsItem>& item, int resNum)
+{
+    return fmt::format("{}_q{}", MetadataHandler::getContentVariant(item, resNum), config->getIntOption(CFG_IMPORT_SCALED_IMAGES_QUALITY));
+}
+
+std::string ImageScaleHandler::scaleJpeg(const fs::path& path, int maxWidth, int maxHeight, int quality)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        throw std::runtime_error("ImageScaleHandler: could not open " + path.string() + ": " + mt_strerror(errno));
+
+    auto buffers = std::make_unique<JpegBuffers>();
+    struct jpeg_decompress_struct dinfo;
+    struct jpeg_compress_struct cinfo;
+    JpegError err;
+
+    dinfo.err = jpeg_std_error(&err.pub);
+    cinfo.err = dinfo.err;
+    err.pub.error_exit = jpegErrorExit;
+    jpeg_create_decompress(&dinfo);
+    jpeg_create_compress(&cinfo);
+
+    auto cleanup = [&]() {
+        jpeg_destroy_compress(&cinfo);
+        jpeg_destroy_decompress(&dinfo);
+        fclose(file);
+    };
+
+    if (setjmp(err.jump)) {
+        cleanup();
+        throw std::runtime_error("ImageScaleHandler: failed to scale " + path.string() + ": " + err.message);
+    }
+
+    jpeg_stdio_src(&dinfo, file);
+    jpeg_read_header(&dinfo, TRUE);
+    if (dinfo.num_components != 1 && dinfo.num_components != 3) {
+        cleanup();
+        throw std::runtime_error("ImageScaleHandler: unsupported color space in " + path.string());
+    }
+
+    int targetWidth;
+    int targetHeight;
+    fitSize(dinfo.image_width, dinfo.image_height, maxWidth, maxHeight, targetWidth, targetHeight);
+
+    // let the decoder drop as much as possible in the DCT domain
+    setDctScaling(dinfo, targetWidth, targetHeight);
+    dinfo.out_color_space = dinfo.num_components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_start_decompress(&dinfo);
+
+    int components = dinfo.output_components;
+    int srcWidth = dinfo.output_width;
+    int srcHeight = dinfo.output_height;
+    targetWidth = std::min(targetWidth, srcWidth);
+    targetHeight = std::min(targetHeight, srcHeight);
+
+    jpeg_mem_dest(&cinfo, &buffers->encoded, &buffers->encodedSize);
+    cinfo.image_width = targetWidth;
+    cinfo.image_height = targetHeight;
+    cinfo.input_components = components;
+    cinfo.in_color_space = components == 1 ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+
+    // area filter, every target pixel averages its source box; the rows
+    // are decoded and encoded one at a time, so the image is never held
+    // in memory as a whole
+    buffers->row.resize(static_cast<size_t>(srcWidth) * components);
+    buffers->sums.resize(static_cast<size_t>(targetWidth) * components);
+    buffers->scaled.resize(static_cast<size_t>(targetWidth) * components);
+    buffers->columns.resize(targetWidth + 1);
+    for (int x = 0; x <= targetWidth; x++)
+        buffers->columns[x] = static_cast<long>(x) * srcWidth / targetWidth;
+
+    for (int y = 0; y < targetHeight; y++) {
+        int rowEnd = static_cast<long>(y + 1) * srcHeight / targetHeight;
+        std::fill(buffers->sums.begin(), buffers->sums.end(), 0);
+        int rows = 0;
+        while (static_cast<int>(dinfo.output_scanline) < rowEnd) {
+            JSAMPROW row = buffers->row.data();
+            jpeg_read_scanlines(&dinfo, &row, 1);
+            rows++;
+            for (int x = 0; x < targetWidth; x++) {
+                unsigned int* sum = &buffers->sums[static_cast<size_t>(x) * components];
+                for (int sx = buffers->columns[x]; sx < buffers->columns[x + 1]; sx++) {
+                    for (int c = 0; c < components; c++)
+                        sum[c] += row[static_cast<size_t>(sx) * components + c];
+                }
+            }
+        }
+        for (int x = 0; x < targetWidth; x++) {
+            unsigned int count = rows * (buffers->columns[x + 1] - buffers->columns[x]);
+            for (int c = 0; c < components; c++) {
+                size_t i = static_cast<size_t>(x) * components + c;
+                buffers->scaled[i] = buffers->sums[i] / count;
+            }
+        }
+        JSAMPROW row = buffers->scaled.data();
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&dinfo);
+    jpeg_finish_compress(&cinfo);
+    cleanup();
+
+    return std::string(reinterpret_cast<const char*>(buffers->encoded), buffers->encodedSize);
+}
+
+#endif // HAVE_LIBJPEG
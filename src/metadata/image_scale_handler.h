@@ -0,0 +1,62 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    image_scale_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file image_scale_handler.h
+/// \brief Definition of the ImageScaleHandler class.
+#ifndef GERBERA_IMAGE_SCALE_HANDLER_H
+#define GERBERA_IMAGE_SCALE_HANDLER_H
+
+#ifdef HAVE_LIBJPEG
+
+#include "metadata_handler.h"
+
+/// \brief resource parameter holding the DLNA profile of a scaled image
+#define SCALED_IMAGE_PROFILE "pr"
+
+/// \brief Adds scaled renditions of JPEG images as resources and renders them on request.
+///
+/// The renditions follow the DLNA JPEG_TN, JPEG_SM and JPEG_LRG profiles.
+/// Decoding uses the DCT domain scaling of libjpeg, so only a fraction of
+/// the original is decompressed; the result is fitted with an area filter
+/// row by row, so memory use follows the image width, not its size.
+class ImageScaleHandler : public MetadataHandler {
+public:
+    explicit ImageScaleHandler(std::shared_ptr<ConfigManager> config);
+    void fillMetadata(std::shared_ptr<CdsItem> item) override;
+    std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
+    std::string getMimeType() override;
+    std::string getContentVariant(const std::shared_ptr<CdsItem>& item, int resNum) override;
+
+    /// \brief Returns the bounding box of a DLNA image profile.
+    /// \return false if the profile is not generated by this handler
+    static bool getProfileSize(const std::string& profile, int& width, int& height);
+
+    /// \brief Computes the size of an image fitted into a bounding box, keeping the aspect ratio.
+    static void fitSize(int width, int height, int maxWidth, int maxHeight, int& outWidth, int& outHeight);
+
+    /// \brief Decodes a JPEG file and encodes it fitted into maxWidth x maxHeight.
+    static std::string scaleJpeg(const fs::path& path, int maxWidth, int maxHeight, int quality);
+};
+
+#endif // HAVE_LIBJPEG
+#endif // GERBERA_IMAGE_SCALE_HANDLER_H
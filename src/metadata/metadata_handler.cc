@@ -57,7 +57,12 @@
 #include "metadata/matroska_handler.h"
 #endif
 
+#ifdef HAVE_LIBJPEG
+#include "metadata/image_scale_handler.h"
+#endif
+
 #include "metadata/fanart_handler.h"
+#include "metadata/sidecar_handler.h"
 
 mt_key MT_KEYS[] = {
     { "M_TITLE", "dc:title" },
@@ -139,6 +144,12 @@ void MetadataHandler::setMetadata(const std::shared_ptr<ConfigManager>& config,
     }
 #endif // HAVE_LIBEXIF
 
+#ifdef HAVE_LIBJPEG
+    if (content_type == CONTENT_TYPE_JPG && config->getBoolOption(CFG_IMPORT_SCALED_IMAGES_ENABLED)) {
+        ImageScaleHandler(config).fillMetadata(item);
+    }
+#endif
+
 #ifdef HAVE_MATROSKA
     if (content_type == CONTENT_TYPE_MKV) {
         MatroskaHandler(config).fillMetadata(item);
@@ -161,6 +172,7 @@ void MetadataHandler::setMetadata(const std::shared_ptr<ConfigManager>& config,
 
     // Fanart for all things!
     FanArtHandler(config).fillMetadata(item);
+    SidecarHandler(config).fillMetadata(item);
 }
 
 std::string MetadataHandler::getMetaFieldName(metadata_fields_t field)
@@ -191,9 +203,15 @@ std::unique_ptr<MetadataHandler> MetadataHandler::createHandler(const std::share
 #if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
     case CH_FFTH:
         return std::make_unique<FfmpegHandler>(config);
+#endif
+#ifdef HAVE_LIBJPEG
+    case CH_IMAGE_SCALE:
+        return std::make_unique<ImageScaleHandler>(config);
 #endif
     case CH_FANART:
         return std::make_unique<FanArtHandler>(config);
+    case CH_SIDECAR:
+        return std::make_unique<SidecarHandler>(config);
     default:
         throw std::runtime_error("unknown content handler ID: " + std::to_string(handlerType));
     }
@@ -203,3 +221,8 @@ std::string MetadataHandler::getMimeType()
 {
     return MIMETYPE_DEFAULT;
 }
+
+std::string MetadataHandler::getContentVariant(const std::shared_ptr<CdsItem>& item, int resNum)
+{
+    return item->getResource(resNum)->encode();
+}
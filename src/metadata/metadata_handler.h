@@ -47,6 +47,8 @@
 #define CH_FLAC 7
 #define CH_FANART 8
 #define CH_MATROSKA 9
+#define CH_IMAGE_SCALE 10
+#define CH_SIDECAR 11
 
 #define CONTENT_TYPE_MP3 "mp3"
 #define CONTENT_TYPE_OGG "ogg"
@@ -74,6 +76,8 @@
 #define ID3_ALBUM_ART "aa"
 #define EXIF_THUMBNAIL "EX_TH"
 #define THUMBNAIL "th" // thumbnail without need for special handling
+#define SUBTITLE_FILE "sub"
+#define NFO_FILE "nfo"
 
 typedef enum {
     M_TITLE = 0,
@@ -155,6 +159,10 @@ public:
     virtual void fillMetadata(std::shared_ptr<CdsItem> item) = 0;
     virtual std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) = 0;
     virtual std::string getMimeType();
+
+    /// \brief Describes everything the content of resource resNum depends on
+    /// besides the source file, used to key cached copies of it.
+    virtual std::string getContentVariant(const std::shared_ptr<CdsItem>& item, int resNum);
 };
 
 #endif // __METADATA_HANDLER_H__
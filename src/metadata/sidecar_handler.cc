@@ -0,0 +1,161 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    sidecar_handler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file sidecar_handler.cc
+
+#include "sidecar_handler.h" // API
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "fanart_handler.h"
+#include "iohandler/file_io_handler.h"
+#include "util/tools.h"
+
+static const char* subtitleExtensions[] = {
+    ".srt",
+    ".ssa",
+    ".smi",
+    ".sub"
+};
+
+#define NFO_EXTENSION ".nfo"
+
+SidecarHandler::SidecarHandler(std::shared_ptr<ConfigManager> config)
+    : MetadataHandler(std::move(config))
+{
+}
+
+void SidecarHandler::fillMetadata(std::shared_ptr<CdsItem> item)
+{
+    auto location = item->getLocation();
+    auto stem = location.parent_path() / location.stem();
+
+    std::vector<std::pair<std::string, std::string>> candidates;
+    if (startswith(item->getMimeType(), "video")) {
+        for (const auto& ext : subtitleExtensions)
+            candidates.emplace_back(ext, SUBTITLE_FILE);
+    }
+    candidates.emplace_back(NFO_EXTENSION, NFO_FILE);
+
+    for (const auto& candidate : candidates) {
+        fs::path path = stem.string() + candidate.first;
+        std::error_code ec;
+        if (path == location || !fs::is_regular_file(path, ec))
+            continue;
+
+        log_debug("Adding sidecar {} to {}", path.c_str(), location.c_str());
+        auto resource = std::make_shared<CdsResource>(CH_SIDECAR);
+        resource->addAttribute(MetadataHandler::getResAttrName(R_PROTOCOLINFO), renderProtocolInfo(MIMETYPE_TEXT));
+        resource->addParameter(RESOURCE_CONTENT_TYPE, candidate.second);
+        resource->addOption(RESOURCE_OPTION_PATH, path);
+        item->addResource(resource);
+    }
+}
+
+std::unique_ptr<IOHandler> SidecarHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
+{
+    fs::path path = item->getResource(resNum)->getOption(RESOURCE_OPTION_PATH);
+    log_debug("Opening sidecar {}", path.c_str());
+    return std::make_unique<FileIOHandler>(path);
+}
+
+std::string SidecarHandler::getMimeType()
+{
+    return MIMETYPE_TEXT;
+}
+
+bool SidecarHandler::refresh(const std::shared_ptr<CdsItem>& item)
+{
+    // fan art and sidecars are always the last resources, dropping them
+    // keeps the index of all other resources
+    auto resources = item->getResources();
+    std::vector<std::shared_ptr<CdsResource>> kept;
+    std::copy_if(resources.begin(), resources.end(), std::back_inserter(kept), [](const auto& res) {
+        return res->getHandlerType() != CH_FANART && res->getHandlerType() != CH_SIDECAR;
+    });
+    item->setResources(kept);
+
+    FanArtHandler(config).fillMetadata(item);
+    fillMetadata(item);
+
+    auto updated = item->getResources();
+    return !std::equal(resources.begin(), resources.end(), updated.begin(), updated.end(),
+        [](const auto& a, const auto& b) { return a->equals(b); });
+}
+
+int SidecarHandler::findSubtitle(const std::shared_ptr<CdsItem>& item, const std::string& ext)
+{
+    int count = item->getResourceCount();
+    for (int i = 1; i < count; i++) {
+        auto res = item->getResource(i);
+        if (res->getHandlerType() != CH_SIDECAR || res->getParameter(RESOURCE_CONTENT_TYPE) != SUBTITLE_FILE)
+            continue;
+        if (ext.empty() || fs::path(res->getOption(RESOURCE_OPTION_PATH)).extension() == ext)
+            return i;
+    }
+    return -1;
+}
+
+fs::path SidecarHandler::getSubtitlePath(const std::shared_ptr<CdsItem>& item, const std::string& ext)
+{
+    int subtitle = findSubtitle(item, ext);
+    if (subtitle > 0)
+        return item->getResource(subtitle)->getOption(RESOURCE_OPTION_PATH);
+
+    auto resources = item->getResources();
+    if (std::any_of(resources.begin(), resources.end(), [](const auto& res) { return res->getHandlerType() == CH_SIDECAR; }))
+        return "";
+
+    auto location = item->getLocation();
+    auto stem = location.parent_path() / location.stem();
+    for (const auto& candidate : subtitleExtensions) {
+        if (!ext.empty() && ext != candidate)
+            continue;
+        fs::path path = stem.string() + candidate;
+        std::error_code ec;
+        if (path != location && fs::is_regular_file(path, ec))
+            return path;
+    }
+    return "";
+}
+
+bool SidecarHandler::isSubtitleExtension(const std::string& ext)
+{
+    return std::any_of(std::begin(subtitleExtensions), std::end(subtitleExtensions), [&](const auto& e) { return ext == e; });
+}
+
+bool SidecarHandler::isSidecar(const fs::path& path)
+{
+    auto ext = path.extension().string();
+    return isSubtitleExtension(ext) || ext == NFO_EXTENSION || FanArtHandler::isFanArt(path);
+}
+
+bool SidecarHandler::isSidecarOf(const fs::path& sidecar, const fs::path& location)
+{
+    if (sidecar == location || sidecar.parent_path() != location.parent_path())
+        return false;
+    return FanArtHandler::isFanArt(sidecar) || sidecar.stem() == location.stem();
+}
@@ -0,0 +1,70 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    sidecar_handler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file sidecar_handler.h
+/// \brief Definition of the SidecarHandler class.
+#ifndef GERBERA_SIDECAR_HANDLER_H
+#define GERBERA_SIDECAR_HANDLER_H
+
+#include "metadata_handler.h"
+
+/// \brief Indexes the files stored next to an item as resources.
+///
+/// Subtitles (.srt, .ssa, .smi, .sub) and .nfo files sharing the stem of
+/// the item are looked up once at import time, the path is kept in the
+/// resource, so requests do not have to probe the filesystem.
+class SidecarHandler : public MetadataHandler {
+public:
+    explicit SidecarHandler(std::shared_ptr<ConfigManager> config);
+    void fillMetadata(std::shared_ptr<CdsItem> item) override;
+    std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
+    std::string getMimeType() override;
+
+    /// \brief Looks up the sidecar and fan art files of an item again.
+    /// \return true if the resources of the item changed
+    bool refresh(const std::shared_ptr<CdsItem>& item);
+
+    /// \brief Returns the index of the first subtitle resource of an item.
+    /// \param ext only consider subtitles with this extension, i.e. ".srt"
+    /// \return -1 if the item has no such subtitle
+    static int findSubtitle(const std::shared_ptr<CdsItem>& item, const std::string& ext = "");
+
+    /// \brief Returns the path of a subtitle of an item.
+    ///
+    /// Items imported before sidecars were indexed have no sidecar
+    /// resources, for them the filesystem is probed.
+    /// \param ext only consider subtitles with this extension, i.e. ".srt"
+    /// \return empty path if the item has no such subtitle
+    static fs::path getSubtitlePath(const std::shared_ptr<CdsItem>& item, const std::string& ext = "");
+
+    /// \brief Checks if the file is a subtitle file extension, i.e. ".srt"
+    static bool isSubtitleExtension(const std::string& ext);
+
+    /// \brief Checks if changes to the file affect the resources of other items
+    static bool isSidecar(const fs::path& path);
+
+    /// \brief Checks if the sidecar file belongs to the item at location
+    static bool isSidecarOf(const fs::path& sidecar, const fs::path& location);
+};
+
+#endif // GERBERA_SIDECAR_HANDLER_H
@@ -38,6 +38,7 @@
 #include "content_manager.h"
 #include "server.h"
 #include "storage/storage.h"
+#include "util/curl_handle_pool.h"
 #include "util/string_converter.h"
 
 #include <string>
@@ -53,23 +54,12 @@ ATrailersService::ATrailersService(const std::shared_ptr<ConfigManager>& config,
     , storage(std::move(storage))
     , content(std::move(content))
 {
-    pid = 0;
-    curl_handle = curl_easy_init();
-    if (!curl_handle)
-        throw std::runtime_error("failed to initialize curl!\n");
-
     if (config->getOption(CFG_ONLINE_CONTENT_ATRAILERS_RESOLUTION) == "640")
         service_url = ATRAILERS_SERVICE_URL_640;
     else
         service_url = ATRAILERS_SERVICE_URL_720P;
 }
 
-ATrailersService::~ATrailersService()
-{
-    if (curl_handle)
-        curl_easy_cleanup(curl_handle);
-}
-
 service_type_t ATrailersService::getServiceType()
 {
     return OS_ATrailers;
@@ -88,9 +78,11 @@ std::unique_ptr<pugi::xml_document> ATrailersService::getData()
     std::string buffer;
 
     try {
+        // a pooled handle reuses the connection of the last refresh
+        auto curl_handle = content->getCurlPool()->acquire();
         log_debug("DOWNLOADING URL: {}", service_url.c_str());
         buffer = URL::download(service_url, &retcode,
-            curl_handle, false, true, true);
+            curl_handle.get(), false, true, true);
     } catch (const std::runtime_error& ex) {
         log_error("Failed to download Apple Trailers XML data: {}",
             ex.what());
@@ -119,17 +111,6 @@ bool ATrailersService::refreshServiceData(std::shared_ptr<Layout> layout)
     log_debug("Refreshing Apple Trailers");
     // the layout is in full control of the service items
 
-    // this is a safeguard to ensure that this class is not called from
-    // multiple threads - it is not allowed to use the same curl handle
-    // from multiple threads
-    // we do it here because the handle is initialized in a different thread
-    // which is OK
-    if (pid == 0)
-        pid = pthread_self();
-
-    if (pid != pthread_self())
-        throw std::runtime_error("Not allowed to call refreshServiceData from different threads!");
-
     auto reply = getData();
     if (reply == nullptr) {
         log_debug("Failed to get XML content from Trailers service");
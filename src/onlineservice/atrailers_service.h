@@ -53,7 +53,6 @@ public:
     ATrailersService(const std::shared_ptr<ConfigManager>& config,
         std::shared_ptr<Storage> storage,
         std::shared_ptr<ContentManager> content);
-    ~ATrailersService();
 
     /// \brief Retrieves user specified content from the service and adds
     /// the items to the database.
@@ -70,11 +69,6 @@ protected:
     std::shared_ptr<Storage> storage;
     std::shared_ptr<ContentManager> content;
 
-    // the handle *must never be used from multiple threads*
-    CURL* curl_handle;
-    // safeguard to ensure the above
-    pthread_t pid;
-
     std::string service_url;
 
     /// \brief This function will retrieve the service XML
@@ -38,6 +38,7 @@
 #include "server.h"
 #include "sopcast_content_handler.h"
 #include "storage/storage.h"
+#include "util/curl_handle_pool.h"
 #include "util/string_converter.h"
 #include <utility>
 
@@ -50,16 +51,6 @@ SopCastService::SopCastService(std::shared_ptr<ConfigManager> config,
     , storage(std::move(storage))
     , content(std::move(content))
 {
-    pid = 0;
-    curl_handle = curl_easy_init();
-    if (!curl_handle)
-        throw std::runtime_error("failed to initialize curl!\n");
-}
-
-SopCastService::~SopCastService()
-{
-    if (curl_handle)
-        curl_easy_cleanup(curl_handle);
 }
 
 service_type_t SopCastService::getServiceType()
@@ -80,9 +71,11 @@ std::unique_ptr<pugi::xml_document> SopCastService::getData()
     std::string buffer;
 
     try {
+        // a pooled handle reuses the connection of the last refresh
+        auto curl_handle = content->getCurlPool()->acquire();
         log_debug("DOWNLOADING URL: {}", SOPCAST_CHANNEL_URL);
         buffer = URL::download(SOPCAST_CHANNEL_URL, &retcode,
-            curl_handle, false, true, true);
+            curl_handle.get(), false, true, true);
 
     } catch (const std::runtime_error& ex) {
         log_error("Failed to download SopCast XML data: {}",
@@ -112,17 +105,6 @@ bool SopCastService::refreshServiceData(std::shared_ptr<Layout> layout)
     log_debug("Refreshing SopCast service");
     // the layout is in full control of the service items
 
-    // this is a safeguard to ensure that this class is not called from
-    // multiple threads - it is not allowed to use the same curl handle
-    // from multiple threads
-    // we do it here because the handle is initialized in a different thread
-    // which is OK
-    if (pid == 0)
-        pid = pthread_self();
-
-    if (pid != pthread_self())
-        throw std::runtime_error("Not allowed to call refreshServiceData from different threads!");
-
     auto reply = getData();
     if (reply == nullptr) {
         log_debug("Failed to get XML content from SopCast service");
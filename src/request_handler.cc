@@ -61,3 +61,8 @@ void RequestHandler::splitUrl(const char* url, char separator, std::string& path
         path = url_s.substr(0, i1);
     }
 }
+
+std::string RequestHandler::makeETag(long long id, int resId, time_t mtime, off_t size)
+{
+    return fmt::format("\"{:x}-{:x}-{:x}-{:x}\"", id, resId, mtime, size);
+}
@@ -62,6 +62,13 @@ public:
     /// parameters = "object_id=12345&transcode=wav"
     static void splitUrl(const char* url, char separator, std::string& path, std::string& parameters);
 
+    /// \brief Builds a strong ETag for a response.
+    /// \param id object id, or another number identifying the file
+    /// \param resId resource of the object, 0 for the file itself
+    /// \param mtime modification time of the data
+    /// \param size length of the response body
+    static std::string makeETag(long long id, int resId, time_t mtime, off_t size);
+
 protected:
     std::shared_ptr<ConfigManager> config;
     std::shared_ptr<Storage> storage;
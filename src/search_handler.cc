@@ -21,12 +21,14 @@
 */
 #include "search_handler.h"
 #include "config/config_manager.h"
+#include "metadata/metadata_handler.h"
 #include "storage/storage.h"
 #include "util/tools.h"
 
 #include <algorithm>
 #include <cctype>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <stack>
 
@@ -464,12 +466,21 @@ std::string DefaultSQLEmitter::emit(const ASTCompareOperator* node, const std::s
     const std::string& value) const
 {
     auto operatr = node->getValue();
-    if (operatr != "=")
-        throw std::runtime_error("operator not yet supported");
+    if (operatr != "=" && operatr != "!=" && operatr != "<" && operatr != "<="
+        && operatr != ">" && operatr != ">=")
+        throw std::runtime_error("operator not supported");
 
     std::ostringstream sqlFragment;
-    sqlFragment << "(m.property_name='" << property << "' and lower(m.property_value)"
-                << operatr << "lower('" << value << "') and c.upnp_class is not null)";
+    int64_t sortKey;
+    // a partial date covers its whole period, <= and > compare with its end
+    bool upperBound = (operatr == "<=" || operatr == ">");
+    if (operatr != "=" && operatr != "!=" && getMetadataSortKey(property, value, sortKey, upperBound)) {
+        sqlFragment << "(m.property_name='" << property << "' and m.property_sort_key"
+                    << operatr << sortKey << " and c.upnp_class is not null)";
+    } else {
+        sqlFragment << "(m.property_name='" << property << "' and lower(m.property_value)"
+                    << operatr << "lower('" << value << "') and c.upnp_class is not null)";
+    }
     return sqlFragment.str();
 }
 
@@ -533,3 +544,121 @@ std::string DefaultSQLEmitter::emit(const ASTOrOperator* node, const std::string
     sqlFragment << lhs << " or " << rhs;
     return sqlFragment.str();
 }
+
+static bool parseDigits(const char*& pos, int count, int& value)
+{
+    value = 0;
+    for (int i = 0; i < count; i++, pos++) {
+        if (!isdigit(*pos))
+            return false;
+        value = value * 10 + (*pos - '0');
+    }
+    return true;
+}
+
+static bool parseDate(const char* pos, bool upperBound, int64_t& sortKey)
+{
+    // YYYY[-MM[-DD[Thh:mm[:ss]]]], followed by fraction or zone
+    int fields[6] = { 0, 0, 0, 0, 0, 0 };
+    const char separators[6] = { 0, '-', '-', 'T', ':', ':' };
+    int field = 0;
+    if (!parseDigits(pos, 4, fields[field++]))
+        return false;
+    while (field < 6 && *pos == separators[field]) {
+        pos++;
+        if (!parseDigits(pos, 2, fields[field++]))
+            return false;
+    }
+    if (field == 4 || (*pos != '\0' && *pos != '.' && *pos != 'Z' && *pos != '+' && *pos != '-'))
+        return false;
+
+    // a partial date stands for its whole period, the missing fields of the
+    // upper bound are the last point of it
+    if (upperBound) {
+        const int last[6] = { 0, 12, 31, 23, 59, 59 };
+        for (; field < 6; field++)
+            fields[field] = last[field];
+    }
+
+    sortKey = 0;
+    for (int value : fields)
+        sortKey = sortKey * 100 + value;
+    return true;
+}
+
+static bool parseDuration(const char* pos, int64_t& sortKey)
+{
+    // h:mm:ss[.fff]
+    int64_t hours = 0;
+    if (!isdigit(*pos))
+        return false;
+    while (isdigit(*pos))
+        hours = hours * 10 + (*pos++ - '0');
+    int minutes, seconds, millis = 0;
+    if (*pos++ != ':' || !parseDigits(pos, 2, minutes) || *pos++ != ':' || !parseDigits(pos, 2, seconds))
+        return false;
+    if (*pos == '.') {
+        pos++;
+        for (int scale = 100; isdigit(*pos); scale /= 10, pos++)
+            millis += scale * (*pos - '0');
+    }
+    if (*pos != '\0')
+        return false;
+
+    sortKey = ((hours * 60 + minutes) * 60 + seconds) * 1000 + millis;
+    return true;
+}
+
+static bool parseInteger(const char* pos, int64_t& sortKey)
+{
+    bool negative = (*pos == '-');
+    if (negative)
+        pos++;
+    int digits = 0;
+    sortKey = 0;
+    for (; isdigit(*pos); pos++, digits++)
+        sortKey = sortKey * 10 + (*pos - '0');
+    if (digits == 0 || digits > 18 || *pos != '\0')
+        return false;
+    if (negative)
+        sortKey = -sortKey;
+    return true;
+}
+
+enum class SortKeyType {
+    Date,
+    Duration,
+    Integer,
+};
+
+/// \brief Properties that are compared by a typed sort key, all others are
+/// compared as text
+static const std::map<std::string, SortKeyType> sortKeyTypes = {
+    { "dc:date", SortKeyType::Date },
+    { "upnp:date", SortKeyType::Date },
+    { "upnp:originalTrackNumber", SortKeyType::Integer },
+    { "upnp:originalDiscNumber", SortKeyType::Integer },
+    { "upnp:episodeNumber", SortKeyType::Integer },
+    { "upnp:episodeSeason", SortKeyType::Integer },
+    { "upnp:lastPlaybackPosition", SortKeyType::Duration },
+};
+
+bool getMetadataSortKey(const std::string& property, const std::string& value, int64_t& sortKey, bool upperBound)
+{
+    auto type = sortKeyTypes.find(property);
+    if (type == sortKeyTypes.end())
+        return false;
+    std::string trimmed = trim_string(value);
+    if (trimmed.empty())
+        return false;
+
+    switch (type->second) {
+    case SortKeyType::Date:
+        return parseDate(trimmed.c_str(), upperBound, sortKey);
+    case SortKeyType::Duration:
+        return parseDuration(trimmed.c_str(), sortKey);
+    case SortKeyType::Integer:
+        return parseInteger(trimmed.c_str(), sortKey);
+    }
+    return false;
+}
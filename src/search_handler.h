@@ -31,6 +31,7 @@
 #include "cds_objects.h"
 #include "memory.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -38,6 +39,21 @@
 
 class SearchParam;
 
+/// \brief Calculates the typed sort key of a metadata value.
+/// \param property name of the metadata property, e.g. dc:date
+/// \param value the metadata value
+/// \param sortKey receives the sort key
+/// \param upperBound a partial date gives the end of its period instead of
+/// the start
+/// \return true if the property has a numeric ordering and the value fits it
+///
+/// The type of the key follows the property: dates (dc:date, upnp:date as
+/// YYYY-MM-DDThh:mm:ss, any trailing part may be missing) become
+/// YYYYMMDDhhmmss, durations (h:mm:ss.fff) become milliseconds and track,
+/// disc and episode numbers are taken as they are. The keys are stored next
+/// to the metadata values, so range searches can use an index.
+bool getMetadataSortKey(const std::string& property, const std::string& value, int64_t& sortKey, bool upperBound = false);
+
 enum class TokenType {
     ASTERISK,
     DQUOTE,
@@ -34,14 +34,30 @@
 #include <utility>
 
 #include "config/config_manager.h"
+#include "content_manager.h"
 #include "iohandler/file_io_handler.h"
 #include "serve_request_handler.h"
 #include "server.h"
+#include "util/headers.h"
 #include "util/tools.h"
+#ifdef HAVE_MAGIC
+#include "util/mime_cache.h"
+#endif
 
-ServeRequestHandler::ServeRequestHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage)
+ServeRequestHandler::ServeRequestHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage, std::shared_ptr<ContentManager> content)
     : RequestHandler(std::move(config), std::move(storage))
+    , content(std::move(content))
+{
+}
+
+std::string ServeRequestHandler::getMimeType(const fs::path& path, const struct stat& statbuf) const
 {
+#ifdef HAVE_MAGIC
+    std::string mime = content->getMimeCache()->getMimeType(path, statbuf.st_mtime, statbuf.st_size);
+    if (string_ok(mime))
+        return mime;
+#endif // HAVE_MAGIC
+    return MIMETYPE_DEFAULT;
 }
 
 /// \todo clean up the fix for internal items
@@ -77,12 +93,7 @@ void ServeRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
 
     if (S_ISREG(statbuf.st_mode)) // we have a regular file
     {
-        std::string mimetype = MIMETYPE_DEFAULT;
-#ifdef HAVE_MAGIC
-        std::string mime = getMIMETypeFromFile(path);
-        if (string_ok(mime))
-            mimetype = mime;
-#endif // HAVE_MAGIC
+        std::string mimetype = getMimeType(path, statbuf);
 
         UpnpFileInfo_set_FileLength(info, statbuf.st_size);
         UpnpFileInfo_set_LastModified(info, statbuf.st_mtime);
@@ -95,6 +106,11 @@ void ServeRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
         }
 
         UpnpFileInfo_set_ContentType(info, ixmlCloneDOMString(mimetype.c_str()));
+
+        Headers headers;
+        headers.addHeader("ETag", makeETag(statbuf.st_ino, 0, statbuf.st_mtime, statbuf.st_size));
+        headers.addHeader("Cache-Control", "no-cache");
+        headers.writeHeaders(info);
     } else {
         throw std::runtime_error("Not a regular file: " + path);
     }
@@ -135,15 +151,9 @@ std::unique_ptr<IOHandler> ServeRequestHandler::open(const char* filename,
 
     if (S_ISREG(statbuf.st_mode)) // we have a regular file
     {
-        std::string mimetype = MIMETYPE_DEFAULT;
-#ifdef HAVE_MAGIC
-        std::string mime = getMIMETypeFromFile(path);
-        if (string_ok(mime))
-            mimetype = mime;
-#endif // HAVE_MAGIC
-
         // FIXME upstream headers
         /*
+        std::string mimetype = getMimeType(path, statbuf);
         info->file_length = statbuf.st_size;
         info->last_modified = statbuf.st_mtime;
         info->is_directory = S_ISDIR(statbuf.st_mode);
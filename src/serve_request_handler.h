@@ -35,13 +35,22 @@
 #include "common.h"
 #include "request_handler.h"
 
+// forward declaration
+class ContentManager;
+
 class ServeRequestHandler : public RequestHandler {
 public:
-    ServeRequestHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage);
+    ServeRequestHandler(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage, std::shared_ptr<ContentManager> content);
     void getInfo(const char* filename, UpnpFileInfo* info) override;
     std::unique_ptr<IOHandler> open(const char* filename,
         enum UpnpOpenFileMode mode,
         std::string range) override;
+
+protected:
+    std::shared_ptr<ContentManager> content;
+
+    /// \brief Returns the mime type of a served file.
+    std::string getMimeType(const fs::path& path, const struct stat& statbuf) const;
 };
 
 #endif // __SERVE_REQUEST_HANDLER_H__
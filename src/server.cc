@@ -45,6 +45,8 @@
 #include "server.h"
 #include "storage/storage.h"
 #include "update_manager.h"
+#include "transcoding/transcode_cache.h"
+#include "util/resource_cache.h"
 #include "util/task_processor.h"
 #include "web/session_manager.h"
 #ifdef HAVE_JS
@@ -64,6 +66,7 @@ static int static_upnp_callback(Upnp_EventType eventtype, const void* event, voi
 
 Server::Server(std::shared_ptr<ConfigManager> config)
     : config(std::move(config))
+    , fileRequestStates(std::make_unique<FileRequestStateCache>())
 {
     server_shutdown_flag = false;
 }
@@ -94,8 +97,16 @@ void Server::init()
 #ifdef HAVE_LASTFMLIB
     last_fm = std::make_shared<LastFm>(config);
 #endif
+    if (config->getBoolOption(CFG_SERVER_RESOURCE_CACHE_ENABLED)) {
+        resourceCache = std::make_shared<ResourceCache>(config->getIntOption(CFG_SERVER_RESOURCE_CACHE_MEMORY_SIZE),
+            config->getOption(CFG_SERVER_RESOURCE_CACHE_DIR), config->getIntOption(CFG_SERVER_RESOURCE_CACHE_DISK_SIZE));
+    }
+    if (config->getBoolOption(CFG_TRANSCODING_CACHE_ENABLED)) {
+        transcodeCache = std::make_shared<TranscodeCache>(config->getOption(CFG_TRANSCODING_CACHE_DIR),
+            static_cast<off_t>(config->getIntOption(CFG_TRANSCODING_CACHE_SIZE)) * 1024 * 1024);
+    }
     content = std::make_shared<ContentManager>(
-        config, storage, update_manager, session_manager, timer, task_processor, scripting_runtime, last_fm);
+        config, storage, update_manager, session_manager, timer, task_processor, scripting_runtime, last_fm, resourceCache);
 }
 
 Server::~Server() { log_debug("Server destroyed"); }
@@ -166,18 +177,6 @@ void Server::run()
         }
     }
 
-    log_debug("Setting virtual dir to: {}", virtual_directory.c_str());
-    ret = UpnpAddVirtualDir(virtual_directory.c_str(), this, nullptr);
-    if (ret != UPNP_E_SUCCESS) {
-        throw UpnpException(ret, "run: UpnpAddVirtualDir failed");
-    }
-
-    ret = registerVirtualDirCallbacks();
-
-    if (ret != UPNP_E_SUCCESS) {
-        throw UpnpException(ret, "run: UpnpSetVirtualDirCallbacks failed");
-    }
-
     std::string presentationURL = config->getOption(CFG_SERVER_PRESENTATION_URL);
     if (!string_ok(presentationURL)) {
         presentationURL = "http://" + ip + ":" + std::to_string(port) + "/";
@@ -193,11 +192,22 @@ void Server::run()
     log_debug("Creating UpnpXMLBuilder");
     xmlbuilder = std::make_unique<UpnpXMLBuilder>(config, storage, virtualUrl, presentationURL);
 
+    renderDescriptionDocuments(web_root);
+
+    log_debug("Setting virtual dir to: {}", virtual_directory.c_str());
+    ret = UpnpAddVirtualDir(virtual_directory.c_str(), static_cast<const RequestHandlerFactory*>(this), nullptr);
+    if (ret != UPNP_E_SUCCESS) {
+        throw UpnpException(ret, "run: UpnpAddVirtualDir failed");
+    }
+
+    ret = WebCallbacks::registerCallbacks();
+
+    if (ret != UPNP_E_SUCCESS) {
+        throw UpnpException(ret, "run: UpnpSetVirtualDirCallbacks failed");
+    }
+
     // register root device with the library
-    auto desc = xmlbuilder->renderDeviceDescription();
-    std::ostringstream buf;
-    desc->print(buf, "", 0);
-    std::string deviceDescription = buf.str();
+    const std::string& deviceDescription = *descriptionDocuments.at(std::string("/") + SERVER_VIRTUAL_DIR + "/" + DEVICE_DESCRIPTION_PATH)->getContent();
     //log_debug("Device Description: {}", deviceDescription.c_str());
 
     log_debug("Registering with UPnP...");
@@ -271,9 +281,14 @@ void Server::shutdown()
     curl_global_cleanup();
 #endif
 
+    // parked web UI requests would hold up the web server threads
+    session_manager->shutdown();
+
     log_debug("now calling upnp finish");
     UpnpFinish();
 
+    descriptionDocuments.clear();
+
     content->shutdown();
     content = nullptr;
 #ifdef HAVE_LASTFMLIB
@@ -428,7 +443,28 @@ void Server::sendCDSSubscriptionUpdate(const std::string& updateString)
     cds->sendSubscriptionUpdate(updateString);
 }
 
-std::unique_ptr<RequestHandler> Server::createRequestHandler(const char* filename) const
+int Server::getCDSSubscriberCount() const
+{
+    return cds != nullptr ? cds->getSubscriberCount() : 0;
+}
+
+void Server::renderDescriptionDocuments(const fs::path& webRoot)
+{
+    descriptionDocuments.clear();
+    time_t now = time(nullptr);
+
+    auto desc = xmlbuilder->renderDeviceDescription();
+    std::ostringstream buf;
+    desc->print(buf, "", 0);
+    descriptionDocuments[std::string("/") + SERVER_VIRTUAL_DIR + "/" + DEVICE_DESCRIPTION_PATH] = std::make_shared<DescriptionDocument>(buf.str(), MIMETYPE_XML, now);
+
+    for (auto const& scpd : { DESC_CM_SCPD_FILE, DESC_CDS_SCPD_FILE, DESC_MRREG_SCPD_FILE }) {
+        fs::path path = webRoot / scpd;
+        descriptionDocuments[std::string("/") + SERVER_VIRTUAL_DIR + "/" + scpd] = std::make_shared<DescriptionDocument>(readTextFile(path), MIMETYPE_XML, getLastWriteTime(path));
+    }
+}
+
+std::unique_ptr<RequestHandler> Server::createRequestHandler(const char* filename, std::uintptr_t requestToken, bool reuseState) const
 {
     std::string link = urlUnescape(filename);
     log_debug("Filename: {}", filename);
@@ -436,7 +472,10 @@ std::unique_ptr<RequestHandler> Server::createRequestHandler(const char* filenam
     std::unique_ptr<RequestHandler> ret = nullptr;
 
     if (startswith(link, std::string("/") + SERVER_VIRTUAL_DIR + "/" + CONTENT_MEDIA_HANDLER)) {
-        ret = std::make_unique<FileRequestHandler>(config, storage, content, update_manager, session_manager, xmlbuilder.get());
+        auto handler = std::make_unique<FileRequestHandler>(config, storage, content, update_manager, session_manager, xmlbuilder.get(), resourceCache, transcodeCache);
+        if (reuseState)
+            handler->setState(fileRequestStates->take(requestToken, link));
+        ret = std::move(handler);
     } else if (startswith(link, std::string("/") + SERVER_VIRTUAL_DIR + "/" + CONTENT_UI_HANDLER)) {
         std::string parameters;
         std::string path;
@@ -450,11 +489,11 @@ std::unique_ptr<RequestHandler> Server::createRequestHandler(const char* filenam
             r_type = "index";
 
         ret = web::createWebRequestHandler(config, storage, content, session_manager, r_type);
-    } else if (startswith(link, std::string("/") + SERVER_VIRTUAL_DIR + "/" + DEVICE_DESCRIPTION_PATH)) {
-        ret = std::make_unique<DeviceDescriptionHandler>(config, storage, xmlbuilder.get());
+    } else if (descriptionDocuments.find(link) != descriptionDocuments.end()) {
+        ret = std::make_unique<DeviceDescriptionHandler>(config, storage, descriptionDocuments.at(link));
     } else if (startswith(link, std::string("/") + SERVER_VIRTUAL_DIR + "/" + CONTENT_SERVE_HANDLER)) {
         if (string_ok(config->getOption(CFG_SERVER_SERVEDIR)))
-            ret = std::make_unique<ServeRequestHandler>(config, storage);
+            ret = std::make_unique<ServeRequestHandler>(config, storage, content);
         else
             throw std::runtime_error("Serving directories is not enabled in configuration");
     }
@@ -470,126 +509,11 @@ std::unique_ptr<RequestHandler> Server::createRequestHandler(const char* filenam
     return ret;
 }
 
-int Server::registerVirtualDirCallbacks()
+std::uintptr_t Server::keepRequestState(const char* filename, RequestHandler* handler) const
 {
-    log_debug("Setting UpnpVirtualDir GetInfoCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    int ret = UpnpVirtualDir_set_GetInfoCallback([](const char* filename, UpnpFileInfo* info, const void* cookie, const void** requestCookie) -> int {
-#else
-    int ret = UpnpVirtualDir_set_GetInfoCallback([](const char* filename, UpnpFileInfo* info, const void* cookie) -> int {
-#endif
-        try {
-            auto reqHandler = static_cast<const Server *>(cookie)->createRequestHandler(filename);
-            reqHandler->getInfo(filename, info);
-        } catch (const ServerShutdownException& se) {
-            return -1;
-        } catch (const SubtitlesNotFoundException& sex) {
-            log_warning("{}", sex.what());
-            return -1;
-        } catch (const std::runtime_error& e) {
-            log_error("{}", e.what());
-            return -1;
-        }
-        return 0; });
-    if (ret != 0)
-        return ret;
-
-    log_debug("Setting UpnpVirtualDir OpenCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    ret = UpnpVirtualDir_set_OpenCallback([](const char* filename, enum UpnpOpenFileMode mode, const void* cookie, const void* requestCookie) -> UpnpWebFileHandle {
-#else
-    ret = UpnpVirtualDir_set_OpenCallback([](const char* filename, enum UpnpOpenFileMode mode, const void* cookie) -> UpnpWebFileHandle {
-#endif
-        std::string link = urlUnescape(filename);
-
-        try {
-            auto reqHandler = static_cast<const Server*>(cookie)->createRequestHandler(filename);
-            auto ioHandler = reqHandler->open(link.c_str(), mode, "");
-            auto ioPtr = static_cast<UpnpWebFileHandle>(ioHandler.release());
-            //log_debug("%p open({})", ioPtr, filename);
-            return ioPtr;
-        } catch (const ServerShutdownException& se) {
-            return nullptr;
-        } catch (const SubtitlesNotFoundException& sex) {
-            log_info("SubtitlesNotFoundException: {}", sex.what());
-            return nullptr;
-        } catch (const std::runtime_error& ex) {
-            log_error("Exception: {}", ex.what());
-            return nullptr;
-        }
-    });
-    if (ret != UPNP_E_SUCCESS)
-        return ret;
-
-    log_debug("Setting UpnpVirtualDir ReadCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    ret = UpnpVirtualDir_set_ReadCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie, const void* requestCookie) -> int {
-#else
-    ret = UpnpVirtualDir_set_ReadCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie) -> int {
-#endif
-        //log_debug("%p read({})", f, length);
-        if (static_cast<const Server*>(cookie)->getShutdownStatus())
-            return -1;
-
-        auto handler = static_cast<IOHandler*>(f);
-        return handler->read(buf, length);
-    });
-    if (ret != UPNP_E_SUCCESS)
-        return ret;
-
-    log_debug("Setting UpnpVirtualDir WriteCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    ret = UpnpVirtualDir_set_WriteCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie, const void* requestCookie) -> int {
-#else
-    ret = UpnpVirtualDir_set_WriteCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie) -> int {
-#endif
-        //log_debug("%p write({})", f, length);
-        return 0;
-    });
-    if (ret != UPNP_E_SUCCESS)
-        return ret;
-
-    log_debug("Setting UpnpVirtualDir SeekCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    ret = UpnpVirtualDir_set_SeekCallback([](UpnpWebFileHandle f, off_t offset, int whence, const void* cookie, const void* requestCookie) -> int {
-#else
-    ret = UpnpVirtualDir_set_SeekCallback([](UpnpWebFileHandle f, off_t offset, int whence, const void* cookie) -> int {
-#endif
-        //log_debug("%p seek({}, {})", f, offset, whence);
-        try {
-            auto handler = static_cast<IOHandler*>(f);
-            handler->seek(offset, whence);
-        } catch (const std::runtime_error& e) {
-            log_error("Exception during seek: {}", e.what());
-            return -1;
-        }
-
+    auto fileHandler = dynamic_cast<FileRequestHandler*>(handler);
+    if (fileHandler == nullptr || fileHandler->getState() == nullptr)
         return 0;
-    });
-    if (ret != UPNP_E_SUCCESS)
-        return ret;
-
-    log_debug("Setting UpnpVirtualDir CloseCallback");
-#ifdef UPNP_HAS_REQUEST_COOKIES
-    UpnpVirtualDir_set_CloseCallback([](UpnpWebFileHandle f, const void* cookie, const void* requestCookie) -> int {
-#else
-    UpnpVirtualDir_set_CloseCallback([](UpnpWebFileHandle f, const void* cookie) -> int {
-#endif
-        int ret_close = 0;
-        //log_debug("%p close()", f);
-        auto handler = static_cast<IOHandler*>(f);
-        try {
-            handler->close();
-        } catch (const std::runtime_error& e) {
-            log_error("Exception during close: {}", e.what());
-            ret_close = -1;
-        }
-
-        delete handler;
-        handler = nullptr;
 
-        return ret_close;
-    });
-
-    return ret;
+    return fileRequestStates->put(urlUnescape(filename), fileHandler->getState());
 }
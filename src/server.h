@@ -33,15 +33,20 @@
 #define __SERVER_H__
 
 #include "action_request.h"
+#include "device_description_handler.h"
 #include "request_handler.h"
 #include "subscription_request.h"
 #include "upnp_cds.h"
 #include "upnp_cm.h"
 #include "upnp_mrreg.h"
+#include "web_callbacks.h"
 
 // forward declaration
 class ConfigManager;
+class FileRequestStateCache;
+class ResourceCache;
 class Storage;
+class TranscodeCache;
 class UpdateManager;
 class Timer;
 namespace web {
@@ -54,7 +59,7 @@ class ContentManager;
 
 /// \brief Provides methods to initialize and shutdown
 /// and to retrieve various information about the server.
-class Server : public std::enable_shared_from_this<Server> {
+class Server : public std::enable_shared_from_this<Server>, public RequestHandlerFactory {
 public:
     Server(std::shared_ptr<ConfigManager> config);
 
@@ -111,10 +116,13 @@ public:
     ///
     /// This function returns true if the server is about to be
     /// terminated. This is the case when upnp_clean() was called.
-    bool getShutdownStatus() const;
+    bool getShutdownStatus() const override;
 
     void sendCDSSubscriptionUpdate(const std::string& updateString);
 
+    /// \brief Returns the number of active ContentDirectory subscriptions.
+    int getCDSSubscriberCount() const;
+
     std::shared_ptr<ContentManager> getContent() { return content; }
 
 protected:
@@ -157,13 +165,12 @@ protected:
     /// is returned by the getVirtualURL() function.
     std::string virtualUrl;
 
-    /// \brief Device description document is created on the fly and
-    /// stored here.
+    /// \brief Device and service description documents, keyed by request path.
     ///
-    /// All necessary values for the device description document are
-    /// read from the configuration and the device desc doc is created
-    /// on the fly.
-    std::string device_description_document;
+    /// The device description is rendered from the configuration and the
+    /// service descriptions are read from the web root once in run(). They
+    /// are dropped on shutdown, so a configuration reload renders them again.
+    std::map<std::string, std::shared_ptr<DescriptionDocument>> descriptionDocuments;
 
     /// \brief Time interval to send ssdp:alive advertisements.
     ///
@@ -172,6 +179,15 @@ protected:
 
     std::unique_ptr<UpnpXMLBuilder> xmlbuilder;
 
+    /// \brief Generated secondary resources, nullptr if caching is disabled.
+    std::shared_ptr<ResourceCache> resourceCache;
+
+    /// \brief Output of transcoding profiles, nullptr if caching is disabled.
+    std::shared_ptr<TranscodeCache> transcodeCache;
+
+    /// \brief Media requests resolved in GetInfo, waiting for their Open callback.
+    std::unique_ptr<FileRequestStateCache> fileRequestStates;
+
     /// \brief ContentDirectoryService instance.
     ///
     /// The ContentDirectoryService class is instantiated in the
@@ -211,24 +227,20 @@ protected:
     /// appropriate service.
     void routeSubscriptionRequest(const std::unique_ptr<SubscriptionRequest>& request) const;
 
-    /// \brief Registers callback functions for the internal web server.
+    /// \brief Renders the device description and loads the service descriptions.
+    /// \param webRoot directory holding the service description files.
+    void renderDescriptionDocuments(const fs::path& webRoot);
+
+    /// \brief Creates the handler for a request to the virtual directory.
     /// \param filename Incoming filename.
+    /// \param requestToken Request cookie set by GetInfo, 0 if there is none.
+    /// \param reuseState Take over the state resolved by GetInfo for the request.
     ///
-    std::unique_ptr<RequestHandler> createRequestHandler(const char* filename) const;
+    std::unique_ptr<RequestHandler> createRequestHandler(const char* filename, std::uintptr_t requestToken = 0, bool reuseState = false) const override;
 
-    /// \brief Registers callback functions for the internal web server.
-    ///
-    /// This function registers callbacks for the internal web server.
-    /// The callback functions are:
-    /// \b web_get_info Query information on a file.
-    /// \b web_open Open a file.
-    /// \b web_read Sequentially read from a file.
-    /// \b web_write Sequentially write to a file (not supported).
-    /// \b web_seek Perform a seek on a file.
-    /// \b web_close Close file.
-    ///
-    /// \return UPNP_E_SUCCESS Callbacks registered successfully, else error code.
-    static int registerVirtualDirCallbacks();
+    /// \brief Keeps the state resolved by handler->getInfo() for the following Open.
+    /// \return token to be stored in the request cookie, 0 if nothing was kept
+    std::uintptr_t keepRequestState(const char* filename, RequestHandler* handler) const override;
 };
 
 #endif // __SERVER_H__
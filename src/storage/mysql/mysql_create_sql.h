@@ -33,13 +33,13 @@
 
 #ifndef __MYSQL_CREATE_SQL_H__
 #define __MYSQL_CREATE_SQL_H__
-#define MS_CREATE_SQL_INFLATED_SIZE 4216
-#define MS_CREATE_SQL_DEFLATED_SIZE 1090
+#define MS_CREATE_SQL_INFLATED_SIZE 4328
+#define MS_CREATE_SQL_DEFLATED_SIZE 1113
 
 /* begin binary data: */
-const unsigned char mysql_create_sql[] = /* 1090 */
-    { 0x78, 0x9C, 0xC5, 0x57, 0x51, 0x6F, 0x9B, 0x48, 0x10, 0x7E, 0xCF, 0xAF, 0xD8, 0x7B, 0x02, 0x57, 0xDC, 0x05, 0xA2, 0x44, 0xEA, 0xA9, 0x8A, 0x14, 0x0E, 0x6F, 0x5B, 0xAB, 0x04, 0x52, 0xC0, 0x77, 0xEA, 0xBD, 0x2C, 0x6B, 0x58, 0xC7, 0x5C, 0x30, 0x58, 0xB0, 0x58, 0xF5, 0xBF, 0xBF, 0x59, 0x30, 0x06, 0xCC, 0xDA, 0xB5, 0xA5, 0x53, 0xEF, 0x25, 0xC1, 0xC3, 0xB7, 0xDF, 0x7E, 0xCC, 0xCC, 0xCE, 0xCE, 0xDC, 0xBE, 0xFB, 0xE5, 0x5E, 0x37, 0x74, 0x03, 0xF9, 0x38, 0x40, 0x4F, 0xAE, 0x3D, 0x25, 0xD6, 0x67, 0xD3, 0x33, 0xAD, 0x00, 0x7B, 0x04, 0x4C, 0xC4, 0xB2, 0x67, 0xD8, 0x09, 0x1E, 0x9F, 0x9E, 0x64, 0x66, 0xF4, 0xEE, 0xF6, 0xC3, 0xCD, 0xED, 0x0F, 0x18, 0x3C, 0xEC, 0xCF, 0xED, 0xC0, 0x1F, 0x51, 0xEC, 0xED, 0xA7, 0x38, 0x5C, 0xDB, 0x36, 0x83, 0x99, 0xEB, 0xC0, 0x93, 0xE3, 0x60, 0x4B, 0x3C, 0x0A, 0x0A, 0x89, 0x79, 0xCC, 0xE0, 0x98, 0xCF, 0xD8, 0x47, 0x15, 0x5F, 0xBE, 0xEF, 0xDE, 0xE9, 0xC6, 0x7D, 0xC7, 0x3E, 0x77, 0x66, 0x5F, 0xE7, 0x18, 0x84, 0x62, 0xEB, 0x8B, 0x50, 0x36, 0xF8, 0xAD, 0xA1, 0xE1, 0x6B, 0xFD, 0x04, 0xC9, 0x47, 0xD7, 0xC3, 0xB3, 0x4F, 0x0E, 0xF9, 0x82, 0xBF, 0x75, 0x4C, 0x63, 0xA3, 0x86, 0x24, 0x40, 0xFD, 0xC4, 0x67, 0xFB, 0x5F, 0x6D, 0xF2, 0xEC, 0x4E, 0x31, 0x30, 0xB5, 0x8F, 0x1A, 0x3A, 0x18, 0x15, 0xC7, 0x25, 0xE6, 0x3C, 0x70, 0xC9, 0x9F, 0xA6, 0x0D, 0xFA, 0xC0, 0x0B, 0x7F, 0x63, 0xCF, 0x55, 0x7A, 0x5C, 0xC6, 0x11, 0x97, 0xE3, 0x06, 0xD8, 0xDF, 0x93, 0xD5, 0xCF, 0x0D, 0x5B, 0x63, 0x6E, 0x44, 0x58, 0x1E, 0x36, 0x03, 0x8C, 0x02, 0xF3, 0x0F, 0x1B, 0xA3, 0x70, 0xCD, 0x49, 0x14, 0x97, 0x24, 0x5F, 0xFC, 0xC3, 0x22, 0x1E, 0x22, 0xF5, 0x06, 0xA1, 0x30, 0x89, 0x43, 0x94, 0x64, 0x5C, 0x35, 0x8C, 0x09, 0x82, 0x95, 0xC8, 0x99, 0xDB, 0x36, 0xA2, 0x15, 0xCF, 0x49, 0x92, 0x45, 0x05, 0x5B, 0xB3, 0x8C, 0x6B, 0x02, 0x57, 0xB0, 0x25, 0xE9, 0x63, 0x63, 0xB6, 0xA4, 0x55, 0xCA, 0x6B, 0x7C, 0x0D, 0xD8, 0xD0, 0x02, 0xB0, 0x44, 0xCA, 0xD7, 0x82, 0x15, 0x5D, 0xA9, 0xB1, 0x8D, 0x02, 0xC2, 0x77, 0x1B, 0x16, 0x22, 0x9E, 0x64, 0x3B, 0xB1, 0xE2, 0x7E, 0x82, 0xAA, 0xAC, 0x4C, 0x5E, 0x33, 0x16, 0x1F, 0x56, 0xD6, 0xE8, 0x6A, 0x93, 0x6D, 0x48, 0x94, 0xD2, 0xB2, 0x0C, 0xD1, 0x96, 0x16, 0xD1, 0x8A, 0x16, 0xEA, 0x7B, 0x5D, 0x22, 0x21, 0x8E, 0x08, 0x4F, 0x78, 0xCA, 0x3A, 0xD8, 0xDD, 0xC3, 0x83, 0x04, 0x97, 0xE6, 0x11, 0xE5, 0x49, 0x9E, 0x85, 0x68, 0x91, 0xE6, 0x8B, 0x81, 0x89, 0xAC, 0x68, 0xB9, 0xEA, 0xBE, 0xE0, 0x20, 0x68, 0xC4, 0xB1, 0x66, 0x9C, 0xC6, 0x94, 0xD3, 0x1E, 0x07, 0xAD, 0xBE, 0x1F, 0x59, 0x0A, 0x56, 0xE6, 0x55, 0x11, 0xB1, 0xB2, 0x67, 0xAB, 0x36, 0x00, 0x62, 0x97, 0xF9, 0x69, 0x9D, 0xAC, 0xD9, 0xDE, 0x4B, 0xED, 0x17, 0xDD, 0xCB, 0x3E, 0x7C, 0x99, 0xD2, 0xD7, 0x52, 0xA2, 0x7A, 0x4C, 0x6C, 0x34, 0xC4, 0xBC, 0xA0, 0xD1, 0x1B, 0xC9, 0xAA, 0xF5, 0x82, 0x15, 0x67, 0x62, 0x5A, 0xB2, 0x62, 0x9B, 0x44, 0x8D, 0xD8, 0xB3, 0x2E, 0x7D, 0xF1, 0x66, 0xCF, 0xA6, 0xF7, 0x0D, 0xC1, 0x29, 0x40, 0x48, 0x15, 0x49, 0x35, 0x11, 0x66, 0xF1, 0x33, 0xEC, 0x52, 0x8E, 0xB4, 0x49, 0xA4, 0xB6, 0xE9, 0x24, 0x45, 0xF5, 0x32, 0x49, 0xED, 0xA5, 0x95, 0x36, 0x48, 0x1B, 0xAD, 0x8B, 0xB6, 0x94, 0x64, 0x90, 0x62, 0xEA, 0x60, 0x69, 0x87, 0x3F, 0x44, 0xBD, 0xD9, 0x45, 0x00, 0x87, 0x89, 0xA0, 0xF5, 0xF6, 0x97, 0x6E, 0x33, 0x74, 0xA4, 0x3A, 0x74, 0xAC, 0x74, 0x45, 0xDF, 0xA7, 0x6A, 0xDF, 0xC3, 0x35, 0x1A, 0x2A, 0x9F, 0x1F, 0x78, 0xE6, 0x0C, 0xEA, 0xEF, 0xF0, 0xB8, 0x92, 0x64, 0xB1, 0x7C, 0x23, 0x46, 0xD8, 0x16, 0x9C, 0x9A, 0xB7, 0xF3, 0x23, 0xF2, 0xF0, 0x47, 0xEC, 0x61, 0xC7, 0x82, 0xDA, 0x38, 0x3A, 0xE7, 0x75, 0x3C, 0x10, 0x14, 0xD3, 0x29, 0xB6, 0x31, 0x94, 0x03, 0xCB, 0xF4, 0x2D, 0x73, 0x8A, 0x85, 0x65, 0xFE, 0x32, 0x35, 0x3B, 0xCB, 0x05, 0x0A, 0xEE, 0x8E, 0x15, 0xF4, 0x1C, 0xF4, 0xDF, 0x88, 0xB8, 0x99, 0x20, 0xEC, 0x7C, 0x9A, 0x39, 0xF8, 0xF1, 0x79, 0x37, 0xF3, 0xCD, 0x67, 0x24, 0xAE, 0x16, 0x28, 0x7C, 0x8F, 0xA2, 0xE6, 0x7F, 0xB8, 0x99, 0x39, 0x3E, 0xF6, 0x02, 0x04, 0xFA, 0xDC, 0xD1, 0x26, 0x75, 0xE9, 0xF4, 0x91, 0xFA, 0xAB, 0xA1, 0xD5, 0x99, 0x09, 0xFF, 0xF5, 0xE6, 0xE9, 0xFC, 0x9F, 0x3D, 0xE8, 0xF7, 0xCE, 0x34, 0xB9, 0x6C, 0x23, 0xFD, 0xB0, 0x8F, 0xA1, 0x29, 0xCD, 0xCB, 0xDF, 0xA2, 0x3C, 0xE3, 0x34, 0xC9, 0x58, 0xA1, 0x68, 0x8A, 0x97, 0xE7, 0x5C, 0xB9, 0x72, 0xDF, 0xBD, 0x37, 0x8E, 0xB7, 0x14, 0xA5, 0x5F, 0xF8, 0xF0, 0x11, 0x8A, 0x03, 0xFA, 0xEB, 0x33, 0xF8, 0x79, 0xFF, 0xD3, 0x50, 0x2E, 0xD3, 0x6A, 0xB4, 0x7B, 0xCA, 0xA5, 0xBE, 0x58, 0x68, 0x9A, 0x14, 0x60, 0xCD, 0x8B, 0xDD, 0xB5, 0x92, 0xA5, 0xD7, 0x0C, 0x8D, 0x78, 0xB2, 0x85, 0xCC, 0xE6, 0x6C, 0x7D, 0xE6, 0xAE, 0x69, 0x2A, 0x67, 0xD4, 0x94, 0xE3, 0x41, 0x8D, 0x19, 0x20, 0x4A, 0x0E, 0x45, 0xF3, 0x0C, 0xE0, 0x44, 0x01, 0x92, 0x24, 0x73, 0x4F, 0xD6, 0x89, 0x33, 0xF5, 0xD3, 0x52, 0x79, 0xE4, 0x36, 0x70, 0x0E, 0x2B, 0x32, 0x9A, 0x42, 0x91, 0xE0, 0x70, 0x2D, 0xBE, 0xEE, 0xFD, 0xF6, 0xC6, 0x76, 0xC3, 0x0B, 0x60, 0xE0, 0x9A, 0x2D, 0x4D, 0xAB, 0x2B, 0x5C, 0x23, 0xC8, 0x26, 0x57, 0x9E, 0xB1, 0xB1, 0xAE, 0x36, 0xA9, 0x94, 0x78, 0x41, 0xB6, 0xAC, 0x28, 0x21, 0x7C, 0x90, 0x43, 0x0F, 0x8A, 0x2C, 0x19, 0x44, 0x37, 0x51, 0x46, 0x34, 0xBB, 0xB2, 0xE3, 0x00, 0x77, 0x9F, 0xEF, 0x38, 0x04, 0x27, 0x49, 0xD9, 0x96, 0xA5, 0x21, 0x62, 0x50, 0x72, 0x55, 0x65, 0x41, 0xCB, 0x24, 0x02, 0x1D, 0xCB, 0x2A, 0x4D, 0x95, 0xE3, 0x0C, 0x12, 0xE8, 0x75, 0x1E, 0xB3, 0x16, 0xCC, 0xE1, 0x72, 0x8D, 0x01, 0x9C, 0x64, 0x39, 0x4F, 0x96, 0xBB, 0x63, 0x3C, 0x1C, 0x85, 0x0A, 0xBE, 0x6B, 0x7B, 0x49, 0x87, 0xB2, 0x4A, 0xE2, 0x98, 0x65, 0x17, 0x00, 0x6B, 0x47, 0x42, 0xC0, 0x2E, 0xE9, 0x30, 0xA0, 0xE1, 0xE1, 0x42, 0x70, 0xB2, 0x4C, 0x18, 0xB8, 0x61, 0x91, 0xBC, 0x8A, 0x35, 0x77, 0xFA, 0xB9, 0x35, 0x1B, 0x11, 0x8A, 0x92, 0xD7, 0x77, 0xD9, 0x39, 0x31, 0xA3, 0x4E, 0x43, 0xD2, 0x12, 0x6D, 0x28, 0x5F, 0x41, 0x00, 0xFA, 0xBD, 0x0B, 0xCF, 0xAB, 0x68, 0x25, 0xC4, 0x5C, 0xC6, 0xDD, 0x34, 0x1B, 0xFD, 0xFC, 0x0B, 0x9B, 0x5B, 0xAF, 0x3D, 0x9E, 0x4D, 0x2F, 0xDE, 0xBC, 0xE9, 0x25, 0x0A, 0x69, 0x43, 0xAF, 0xB6, 0x49, 0x20, 0x3B, 0xCC, 0x07, 0xB4, 0xFC, 0x14, 0xB7, 0x2B, 0xFF, 0x9F, 0x93, 0xDC, 0xB5, 0x87, 0x57, 0xE5, 0x7C, 0x53, 0x95, 0x4E, 0x95, 0xC9, 0x4D, 0x91, 0x43, 0x80, 0xF9, 0x8E, 0x64, 0x74, 0x7D, 0xEE, 0xC4, 0x77, 0xC0, 0x7D, 0x6D, 0xE0, 0xEC, 0x3B, 0x3F, 0x59, 0x13, 0x8E, 0x62, 0xD2, 0x04, 0x63, 0x2F, 0x9F, 0x1C, 0x04, 0xA9, 0x07, 0x6D, 0xB2, 0x58, 0x74, 0xF8, 0x78, 0xF9, 0x36, 0x2E, 0xA8, 0xED, 0xCA, 0x9F, 0x12, 0x8B, 0xC1, 0xE0, 0xD5, 0xCD, 0x5C, 0xFD, 0x09, 0x6C, 0x3C, 0xF4, 0xC9, 0xE6, 0x3D, 0xF9, 0x1C, 0x38, 0x5E, 0x7B, 0x34, 0x70, 0x8E, 0x66, 0xD0, 0xF1, 0x38, 0x28, 0x1F, 0xC3, 0x4F, 0x0D, 0xE8, 0x3F, 0x5A, 0x7F, 0x18, 0xC2, 0x4F, 0xCE, 0xE7, 0x12, 0x06, 0xE9, 0x08, 0x7E, 0x6A, 0x38, 0x1F, 0x0F, 0xA1, 0xBD, 0xF9, 0x73, 0x30, 0x8E, 0xD6, 0xC8, 0x7F, 0x01, 0x8E, 0xC3, 0xF9, 0x67 };
-/* end binary data. size = 1090 bytes */
+const unsigned char mysql_create_sql[] = /* 1113 */
+    { 0x78, 0xDA, 0xC5, 0x58, 0x51, 0x8F, 0x9B, 0x38, 0x10, 0x7E, 0xDF, 0x5F, 0xE1, 0x7B, 0x82, 0x54, 0xDC, 0x2D, 0xAC, 0xB6, 0x55, 0x4F, 0xD5, 0x4A, 0xCB, 0x11, 0xB7, 0x8D, 0xCA, 0xC2, 0x16, 0xC8, 0x9D, 0x7A, 0x2F, 0xC6, 0x01, 0x67, 0xE3, 0x5B, 0x02, 0x11, 0x98, 0xA8, 0xF9, 0xF7, 0x67, 0x43, 0x08, 0x10, 0x0C, 0x4D, 0xA4, 0x53, 0xEF, 0x65, 0x17, 0x86, 0xCF, 0xDF, 0x8C, 0x67, 0xC6, 0xE3, 0x99, 0xDC, 0xBE, 0xF9, 0xE5, 0x5E, 0x37, 0x74, 0x03, 0xF8, 0x30, 0x00, 0x8F, 0xAE, 0x3D, 0x47, 0xD6, 0x67, 0xD3, 0x33, 0xAD, 0x00, 0x7A, 0x88, 0x8B, 0x90, 0x65, 0x2F, 0xA0, 0x13, 0x3C, 0x3C, 0x3E, 0xCA, 0xC4, 0xE0, 0xCD, 0xED, 0x87, 0x9B, 0xDB, 0x1F, 0x30, 0x78, 0xD0, 0x5F, 0xDA, 0x81, 0x3F, 0xA0, 0x38, 0xCA, 0xC7, 0x38, 0x5C, 0xDB, 0x36, 0x83, 0x85, 0xEB, 0xF0, 0x27, 0xC7, 0x81, 0x96, 0x78, 0x14, 0x14, 0x12, 0xF1, 0x90, 0xC1, 0x31, 0x9F, 0xA0, 0x0F, 0x4A, 0xB6, 0x7E, 0xDF, 0x7E, 0xD3, 0x8D, 0xFB, 0x96, 0x7D, 0xE9, 0x2C, 0xBE, 0x2E, 0x21, 0x37, 0x14, 0x5A, 0x5F, 0x84, 0x65, 0xBD, 0x77, 0x0D, 0xF4, 0x3F, 0xEB, 0x23, 0x24, 0x1F, 0x5D, 0x0F, 0x2E, 0x3E, 0x39, 0xE8, 0x0B, 0xFC, 0xD6, 0x32, 0x0D, 0x85, 0x1A, 0x90, 0x00, 0xF5, 0x91, 0x6D, 0xFB, 0x5F, 0x6D, 0xF4, 0xE4, 0xCE, 0x21, 0x67, 0x6A, 0x1E, 0x35, 0x70, 0x12, 0x2A, 0x8E, 0x8B, 0xCC, 0x65, 0xE0, 0xA2, 0x3F, 0x4D, 0x9B, 0xDB, 0xC7, 0xBD, 0xF0, 0x37, 0xF4, 0x5C, 0xA5, 0xC3, 0x65, 0x9C, 0x71, 0x39, 0x6E, 0x00, 0xFD, 0x23, 0x59, 0xF5, 0x5C, 0xB3, 0xD5, 0xE2, 0xDA, 0x08, 0xCB, 0x83, 0x66, 0x00, 0x41, 0x60, 0xFE, 0x61, 0x43, 0x10, 0x6E, 0x19, 0x8A, 0xE2, 0x02, 0x65, 0xAB, 0x7F, 0x48, 0xC4, 0x42, 0xA0, 0xDE, 0x00, 0x10, 0xD2, 0x38, 0x04, 0x34, 0x65, 0xAA, 0x61, 0xCC, 0x00, 0x5F, 0x09, 0x9C, 0xA5, 0x6D, 0x03, 0x5C, 0xB2, 0x0C, 0xD1, 0x34, 0xCA, 0xC9, 0x96, 0xA4, 0x4C, 0x13, 0xB8, 0x9C, 0xAC, 0x51, 0x17, 0x1B, 0x93, 0x35, 0x2E, 0x13, 0x56, 0xE1, 0x2B, 0xC0, 0x0E, 0xE7, 0x1C, 0x8B, 0xA4, 0x7C, 0x0D, 0x58, 0xD1, 0x95, 0x0A, 0x5B, 0x5B, 0x80, 0xD8, 0x61, 0x47, 0x42, 0xC0, 0x68, 0x7A, 0x10, 0x2B, 0xEE, 0x67, 0xA0, 0x4C, 0x0B, 0xFA, 0x92, 0x92, 0xF8, 0xB4, 0xB2, 0x42, 0x97, 0xBB, 0x74, 0x87, 0xA2, 0x04, 0x17, 0x45, 0x08, 0xF6, 0x38, 0x8F, 0x36, 0x38, 0x57, 0xDF, 0xEB, 0x12, 0x13, 0xE2, 0x08, 0x31, 0xCA, 0x12, 0xD2, 0xC2, 0xEE, 0xDE, 0xBE, 0x95, 0xE0, 0x92, 0x2C, 0xC2, 0x8C, 0x66, 0x69, 0x08, 0x56, 0x49, 0xB6, 0xEA, 0x89, 0xD0, 0x06, 0x17, 0x9B, 0x76, 0x07, 0x27, 0x83, 0x06, 0x1C, 0x5B, 0xC2, 0x70, 0x8C, 0x19, 0xEE, 0x70, 0xE0, 0xF2, 0xFB, 0x99, 0x24, 0x27, 0x45, 0x56, 0xE6, 0x11, 0x29, 0x3A, 0xB2, 0x72, 0xC7, 0x41, 0xE4, 0x32, 0x3F, 0x6D, 0xE9, 0x96, 0x1C, 0xBD, 0xD4, 0xEC, 0xE8, 0x5E, 0xB6, 0xF1, 0x75, 0x82, 0x5F, 0x0A, 0x89, 0xD5, 0x43, 0x62, 0xA3, 0x26, 0x66, 0x39, 0x8E, 0x5E, 0x51, 0x5A, 0x6E, 0x57, 0x24, 0x9F, 0x88, 0x69, 0x41, 0xF2, 0x3D, 0x8D, 0x6A, 0x63, 0x27, 0x5D, 0xFA, 0xEC, 0x2D, 0x9E, 0x4C, 0xEF, 0x1B, 0xE0, 0xA7, 0x00, 0x00, 0x55, 0x24, 0xD5, 0x4C, 0x88, 0xC5, 0x6B, 0xD8, 0xA6, 0x1C, 0x6A, 0x92, 0x48, 0x6D, 0xD2, 0x49, 0x8A, 0xEA, 0x64, 0x92, 0xDA, 0x49, 0x2B, 0xAD, 0x97, 0x36, 0x5A, 0x1B, 0x6D, 0x29, 0x49, 0x2F, 0xC5, 0xD4, 0xDE, 0xD2, 0x16, 0x7F, 0x8A, 0x7A, 0xAD, 0x45, 0x00, 0xFB, 0x89, 0xA0, 0x75, 0xF4, 0x4B, 0xD5, 0xF4, 0x1D, 0xA9, 0xF6, 0x1D, 0x2B, 0x5D, 0xD1, 0xF5, 0xA9, 0xDA, 0xF5, 0x70, 0x85, 0xE6, 0x95, 0xCF, 0x0F, 0x3C, 0x73, 0xC1, 0xEB, 0x6F, 0xFF, 0xB8, 0x22, 0xBA, 0x5A, 0xBF, 0x22, 0x23, 0x6C, 0x0A, 0x4E, 0xC5, 0xDB, 0xFA, 0x11, 0x78, 0xF0, 0x23, 0xF4, 0xA0, 0x63, 0xF1, 0xDA, 0x38, 0x38, 0xE7, 0x55, 0x3C, 0x00, 0x2F, 0xA6, 0x73, 0x68, 0x43, 0x5E, 0x0E, 0x2C, 0xD3, 0xB7, 0xCC, 0x39, 0x14, 0x92, 0xE5, 0xF3, 0xDC, 0x6C, 0x25, 0x17, 0x58, 0x70, 0x77, 0x6E, 0x41, 0xC7, 0x41, 0xFF, 0x8D, 0x11, 0x37, 0x33, 0x00, 0x9D, 0x4F, 0x0B, 0x07, 0x3E, 0x3C, 0x1D, 0x16, 0xBE, 0xF9, 0x04, 0xC4, 0xD5, 0xC2, 0x0B, 0xDF, 0x83, 0xA8, 0xF9, 0x1F, 0x6E, 0x16, 0x8E, 0x0F, 0xBD, 0x00, 0x70, 0xFB, 0xDC, 0x81, 0x92, 0xAA, 0x74, 0xFA, 0x40, 0xFD, 0xD5, 0xD0, 0xAA, 0xCC, 0xE4, 0xFF, 0xF5, 0xFA, 0x69, 0xFA, 0xCF, 0x11, 0xF4, 0x7B, 0x2B, 0x9A, 0x5D, 0xA6, 0x48, 0x3F, 0xE9, 0x31, 0x34, 0xA5, 0xFE, 0xF8, 0x5B, 0x94, 0xA5, 0x0C, 0xD3, 0x94, 0xE4, 0x8A, 0xA6, 0x78, 0x59, 0xC6, 0x94, 0x2B, 0xF5, 0x1E, 0xBD, 0x71, 0xAE, 0x52, 0x94, 0x7E, 0xE1, 0xC3, 0x07, 0x5E, 0x1C, 0xC0, 0x5F, 0x9F, 0xB9, 0x9F, 0x8F, 0xAF, 0x86, 0x72, 0x99, 0xAD, 0x46, 0xA3, 0x53, 0x6E, 0xEA, 0xB3, 0x05, 0xE6, 0x34, 0xE7, 0xD2, 0x2C, 0x3F, 0x5C, 0x6B, 0xB2, 0xF4, 0x9A, 0xC1, 0x11, 0xA3, 0x7B, 0x9E, 0xD9, 0x8C, 0x6C, 0x27, 0xEE, 0x9A, 0xBA, 0x72, 0x46, 0x75, 0x39, 0xEE, 0xD5, 0x98, 0x1E, 0xA2, 0x60, 0xBC, 0x68, 0x4E, 0x00, 0x46, 0x0A, 0x90, 0x24, 0x99, 0x3B, 0x66, 0x8D, 0x9C, 0xA9, 0x9F, 0x96, 0xCA, 0x03, 0xB7, 0x71, 0xE7, 0x90, 0x3C, 0xC5, 0x09, 0x2F, 0x12, 0x8C, 0x5F, 0x8B, 0x2F, 0x47, 0xBF, 0xBD, 0x92, 0x43, 0xFF, 0x02, 0xE8, 0xB9, 0x66, 0x8F, 0x93, 0xF2, 0x0A, 0xD7, 0x08, 0xB2, 0xD9, 0x95, 0x67, 0x6C, 0x68, 0x57, 0x93, 0x54, 0x4A, 0xBC, 0x42, 0x7B, 0x92, 0x17, 0x3C, 0x7C, 0x3C, 0x87, 0xDE, 0x29, 0xB2, 0x64, 0x10, 0xDD, 0x44, 0x11, 0xE1, 0xF4, 0xCA, 0x8E, 0x83, 0xBB, 0x7B, 0xBA, 0xE3, 0x10, 0x9C, 0x28, 0x21, 0x7B, 0x92, 0x84, 0x80, 0xF0, 0x92, 0xAB, 0x2A, 0x2B, 0x5C, 0xD0, 0x88, 0xDB, 0xB1, 0x2E, 0x93, 0x44, 0x39, 0xCF, 0x20, 0x81, 0xDE, 0x66, 0x31, 0x69, 0xC0, 0x8C, 0x5F, 0xAE, 0x31, 0x07, 0xD3, 0x34, 0x63, 0x74, 0x7D, 0x38, 0xC7, 0xF3, 0xA3, 0x50, 0xF2, 0x7D, 0xED, 0x2F, 0xE9, 0x50, 0x36, 0x34, 0x8E, 0x49, 0x7A, 0x01, 0xB0, 0x72, 0x24, 0x0F, 0xD8, 0x25, 0x1D, 0x06, 0x6F, 0x78, 0x98, 0x30, 0x98, 0xAE, 0x29, 0xE1, 0x6E, 0x58, 0xD1, 0x17, 0xB1, 0xE6, 0x4E, 0x9F, 0x5A, 0xB3, 0x13, 0xA1, 0x28, 0x58, 0x75, 0x97, 0x4D, 0x19, 0x33, 0xE8, 0x34, 0x24, 0x2D, 0xD1, 0x0E, 0xB3, 0x0D, 0x0F, 0x40, 0xB7, 0x77, 0x61, 0x59, 0x19, 0x6D, 0x84, 0x31, 0x97, 0x71, 0xD7, 0xCD, 0x46, 0x37, 0xFF, 0xC2, 0xFA, 0xD6, 0x6B, 0x8E, 0x67, 0xDD, 0x8B, 0xD7, 0x5F, 0x3A, 0x89, 0x82, 0x9A, 0xD0, 0xAB, 0x4D, 0x12, 0xC8, 0x0E, 0xF3, 0x09, 0x2D, 0x3F, 0xC5, 0xCD, 0xCA, 0xFF, 0xE7, 0x24, 0xB7, 0xED, 0xE1, 0x55, 0x39, 0x5F, 0x57, 0xA5, 0xB1, 0x32, 0xB9, 0xCB, 0x33, 0x1E, 0x60, 0x76, 0x40, 0x29, 0xDE, 0x4E, 0x9D, 0xF8, 0x16, 0x78, 0xAC, 0x0D, 0x8C, 0x7C, 0x67, 0x23, 0x88, 0x22, 0xCB, 0x19, 0xAA, 0x0A, 0x4C, 0x27, 0xC1, 0xA6, 0xDA, 0xBB, 0xB3, 0x10, 0xD6, 0xB1, 0x3B, 0xEE, 0x16, 0x9D, 0xEC, 0x57, 0x4F, 0x5B, 0x91, 0xA0, 0x5A, 0x9D, 0xEA, 0xD9, 0x9E, 0x34, 0x89, 0x61, 0xB2, 0xD8, 0xB7, 0x0A, 0xE3, 0xF5, 0xEB, 0xB0, 0x80, 0x37, 0xAA, 0x7F, 0x4A, 0xEC, 0x7B, 0x83, 0x5E, 0x3B, 0xE3, 0x75, 0x27, 0xBE, 0xE1, 0x90, 0x29, 0x9B, 0x2F, 0xE5, 0x73, 0xE7, 0x70, 0xED, 0xD9, 0x80, 0x3B, 0x98, 0x79, 0x87, 0xE3, 0xA7, 0x7C, 0xEC, 0x1F, 0xFB, 0x41, 0xE0, 0x47, 0xEB, 0x4F, 0x43, 0xFF, 0xE8, 0xEF, 0x01, 0x12, 0x06, 0xE9, 0xC8, 0x3F, 0xF6, 0x63, 0xC0, 0x70, 0xE8, 0xED, 0xCC, 0xBB, 0xBD, 0xF1, 0xB7, 0x42, 0xFE, 0x0B, 0xFB, 0xFB, 0x21, 0xF6 };
+/* end binary data. size = 1113 bytes */
 
 #endif // __MYSQL_CREATE_SQL_H__
 
@@ -72,6 +72,11 @@
 ) ENGINE=MyISAM CHARSET=utf8"
 #define MYSQL_UPDATE_4_5_2 "UPDATE `mt_internal_setting` SET `value`='5' WHERE `key`='db_version' AND `value`='4'"
 
+// updates 5->6
+#define MYSQL_UPDATE_5_6_1 "ALTER TABLE `mt_metadata` ADD `property_sort_key` bigint(20) default NULL"
+#define MYSQL_UPDATE_5_6_2 "ALTER TABLE `mt_metadata` ADD KEY `metadata_sort_key` (`property_name`,`property_sort_key`)"
+#define MYSQL_UPDATE_5_6_3 "UPDATE `mt_internal_setting` SET `value`='6' WHERE `key`='db_version' AND `value`='5'"
+
 using namespace std;
 
 MysqlStorage::MysqlStorage(std::shared_ptr<ConfigManager> config)
@@ -265,9 +270,19 @@ void MysqlStorage::init()
         dbVersion = "5";
     }
 
+    if (dbVersion == "5") {
+        log_info("Doing an automatic database upgrade from database version 5 to version 6...");
+        _exec(MYSQL_UPDATE_5_6_1);
+        _exec(MYSQL_UPDATE_5_6_2);
+        migrateMetadataSortKeys();
+        _exec(MYSQL_UPDATE_5_6_3);
+        log_info("database upgrade successful.");
+        dbVersion = "6";
+    }
+
     /* --- --- ---*/
 
-    if (!string_ok(dbVersion) || dbVersion != "5")
+    if (!string_ok(dbVersion) || dbVersion != "6")
         throw std::runtime_error("The database seems to be from a newer version (database version " + dbVersion + ")!");
 
     lock.unlock();
@@ -353,6 +368,7 @@ int MysqlStorage::exec(const char* query, int length, bool getLastInsertId)
     int insert_id = -1;
     if (getLastInsertId)
         insert_id = mysql_insert_id(&db);
+    dbGeneration++;
     return insert_id;
 }
 
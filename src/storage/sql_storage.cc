@@ -51,6 +51,8 @@ using namespace std;
 
 #define SQL_NULL "NULL"
 
+#define MAX_SEARCH_PLANS 128
+
 #define RESOURCE_SEP '|'
 
 enum {
@@ -140,6 +142,7 @@ SQLStorage::SQLStorage(std::shared_ptr<ConfigManager> config)
     table_quote_end = '\0';
     lastID = INVALID_OBJECT_ID;
     lastMetadataID = INVALID_OBJECT_ID;
+    dbGeneration = 0;
 }
 
 void SQLStorage::init()
@@ -154,6 +157,14 @@ void SQLStorage::init()
     sqlEmitter = std::make_shared<DefaultSQLEmitter>();
 }
 
+static std::string sortKeySQL(const std::string& property, const std::string& value)
+{
+    int64_t sortKey;
+    if (getMetadataSortKey(property, value, sortKey))
+        return std::to_string(sortKey);
+    return SQL_NULL;
+}
+
 void SQLStorage::dbReady()
 {
     loadLastID();
@@ -584,21 +595,87 @@ std::vector<std::shared_ptr<CdsObject>> SQLStorage::browse(const std::unique_ptr
     return arr;
 }
 
-std::vector<std::shared_ptr<CdsObject>> SQLStorage::search(const std::unique_ptr<SearchParam>& param, int* numMatches)
+/// \brief Collapses whitespace outside of quoted strings, so equivalent criteria share a plan.
+static std::string normalizeSearchCriteria(const std::string& criteria)
 {
-    std::unique_ptr<SearchParser> searchParser = std::make_unique<SearchParser>(*sqlEmitter, param->searchCriteria());
+    std::string result;
+    result.reserve(criteria.length());
+    bool quoted = false;
+    bool escaped = false;
+    bool space = false;
+    for (char c : criteria) {
+        if (!quoted && isspace(c)) {
+            space = true;
+            continue;
+        }
+        if (space && !result.empty())
+            result += ' ';
+        space = false;
+        result += c;
+        if (escaped)
+            escaped = false;
+        else if (c == '\\')
+            escaped = quoted;
+        else if (c == '"')
+            quoted = !quoted;
+    }
+    return result;
+}
+
+std::string SQLStorage::getSearchSQL(const std::string& criteria)
+{
+    {
+        std::lock_guard<std::mutex> lock(searchPlanMutex);
+        auto it = searchPlans.find(criteria);
+        if (it != searchPlans.end())
+            return it->second.searchSQL;
+    }
+
+    auto searchParser = std::make_unique<SearchParser>(*sqlEmitter, criteria);
     std::shared_ptr<ASTNode> rootNode = searchParser->parse();
     std::string searchSQL(rootNode->emitSQL());
     if (!searchSQL.length())
         throw std::runtime_error("failed to generate SQL for search");
 
-    std::ostringstream countSQL;
-    countSQL << "select count(*) " << searchSQL << ';';
-    auto sqlResult = select(countSQL);
-    std::unique_ptr<SQLRow> countRow = sqlResult->nextRow();
-    if (countRow != nullptr) {
-        *numMatches = std::stoi(countRow->col(0));
+    std::lock_guard<std::mutex> lock(searchPlanMutex);
+    if (searchPlans.size() >= MAX_SEARCH_PLANS)
+        searchPlans.clear();
+    searchPlans[criteria] = SearchPlan { searchSQL, 0, -1 };
+    return searchSQL;
+}
+
+std::vector<std::shared_ptr<CdsObject>> SQLStorage::search(const std::unique_ptr<SearchParam>& param, int* numMatches)
+{
+    std::string criteria = normalizeSearchCriteria(param->searchCriteria());
+    std::string searchSQL = getSearchSQL(criteria);
+
+    // the count stays valid until something is written to the database
+    unsigned long generation = dbGeneration;
+    int count = -1;
+    {
+        std::lock_guard<std::mutex> lock(searchPlanMutex);
+        auto it = searchPlans.find(criteria);
+        if (it != searchPlans.end() && it->second.count >= 0 && it->second.countGeneration == generation)
+            count = it->second.count;
+    }
+    if (count < 0) {
+        std::ostringstream countSQL;
+        countSQL << "select count(*) " << searchSQL << ';';
+        auto sqlResult = select(countSQL);
+        std::unique_ptr<SQLRow> countRow = sqlResult->nextRow();
+        if (countRow != nullptr) {
+            count = std::stoi(countRow->col(0));
+
+            std::lock_guard<std::mutex> lock(searchPlanMutex);
+            auto it = searchPlans.find(criteria);
+            if (it != searchPlans.end()) {
+                it->second.countGeneration = generation;
+                it->second.count = count;
+            }
+        }
     }
+    if (count >= 0)
+        *numMatches = count;
 
     std::ostringstream retrievalSQL;
     retrievalSQL << SELECT_DATA_FOR_SEARCH << " " << searchSQL;
@@ -611,7 +688,7 @@ std::vector<std::shared_ptr<CdsObject>> SQLStorage::search(const std::unique_ptr
     retrievalSQL << ';';
 
     log_debug("Search resolves to SQL [{}]", retrievalSQL.str().c_str());
-    sqlResult = select(retrievalSQL);
+    auto sqlResult = select(retrievalSQL);
 
     std::vector<std::shared_ptr<CdsObject>> arr;
 
@@ -785,11 +862,13 @@ int SQLStorage::createContainer(int parentID, std::string name, const std::strin
                << TQ("id") << ','
                << TQ("item_id") << ','
                << TQ("property_name") << ','
-               << TQ("property_value") << ") VALUES ("
+               << TQ("property_value") << ','
+               << TQ("property_sort_key") << ") VALUES ("
                << newMetadataID << ','
                << newID << ","
                << quote(it.first) << ","
-               << quote(it.second)
+               << quote(it.second) << ","
+               << sortKeySQL(it.first, it.second)
                << ")";
             exec(ib);
         }
@@ -2157,6 +2236,7 @@ void SQLStorage::generateMetadataDBOperations(const std::shared_ptr<CdsObject>&
             std::map<std::string, std::string> metadataSql;
             metadataSql["property_name"] = quote(it.first);
             metadataSql["property_value"] = quote(it.second);
+            metadataSql["property_sort_key"] = sortKeySQL(it.first, it.second);
             operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, metadataSql, "insert"));
         }
     } else {
@@ -2167,6 +2247,7 @@ void SQLStorage::generateMetadataDBOperations(const std::shared_ptr<CdsObject>&
             std::map<std::string, std::string> metadataSql;
             metadataSql["property_name"] = quote(it.first);
             metadataSql["property_value"] = quote(it.second);
+            metadataSql["property_sort_key"] = sortKeySQL(it.first, it.second);
             operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, metadataSql, operation));
         }
         for (const auto& it : dbMetadata) {
@@ -2231,7 +2312,7 @@ std::unique_ptr<std::ostringstream> SQLStorage::sqlForInsert(const std::shared_p
 std::unique_ptr<std::ostringstream> SQLStorage::sqlForUpdate(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable)
 {
     if (addUpdateTable == nullptr
-        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().size() != 2))
+        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().size() != 3))
         throw std::runtime_error("sqlForUpdate called with invalid arguments");
 
     std::string tableName = addUpdateTable->getTable();
@@ -2326,21 +2407,18 @@ void SQLStorage::migrateMetadata(const std::shared_ptr<CdsObject>& object)
     auto dict = object->getMetadata();
     if (!dict.empty()) {
         log_debug("Migrating metadata for cds object {}", object->getID());
-        std::map<std::string, std::string> metadataSQLVals;
         for (auto& it : dict) {
-            metadataSQLVals[quote(it.first)] = quote(it.second);
-        }
-
-        for (auto& metadataSQLVal : metadataSQLVals) {
             std::ostringstream fields, values;
             fields << TQ("id") << ','
                    << TQ("item_id") << ','
                    << TQ("property_name") << ','
-                   << TQ("property_value");
+                   << TQ("property_value") << ','
+                   << TQ("property_sort_key");
             values << getNextMetadataID() << ','
                    << object->getID() << ','
-                   << metadataSQLVal.first << ','
-                   << metadataSQLVal.second;
+                   << quote(it.first) << ','
+                   << quote(it.second) << ','
+                   << sortKeySQL(it.first, it.second);
             std::ostringstream qb;
             qb << "INSERT INTO " << TQ(METADATA_TABLE)
                << " (" << fields.str()
@@ -2352,3 +2430,31 @@ void SQLStorage::migrateMetadata(const std::shared_ptr<CdsObject>& object)
         log_debug("Skipping migration - no metadata for cds object {}", object->getID());
     }
 }
+
+void SQLStorage::migrateMetadataSortKeys()
+{
+    log_info("Calculating sort keys of existing metadata");
+
+    std::ostringstream qb;
+    qb << "SELECT " << TQ("id") << ','
+       << TQ("property_name") << ','
+       << TQ("property_value")
+       << " FROM " << TQ(METADATA_TABLE);
+    auto res = select(qb);
+    std::unique_ptr<SQLRow> row;
+
+    int rowsUpdated = 0;
+    while ((row = res->nextRow()) != nullptr) {
+        int64_t sortKey;
+        if (!getMetadataSortKey(row->col(1), row->col(2), sortKey))
+            continue;
+
+        std::ostringstream ub;
+        ub << "UPDATE " << TQ(METADATA_TABLE)
+           << " SET " << TQ("property_sort_key") << '=' << sortKey
+           << " WHERE " << TQ("id") << '=' << row->col(0);
+        exec(ub);
+        ++rowsUpdated;
+    }
+    log_info("Calculated sort keys - metadata count: {}", rowsUpdated);
+}
@@ -35,8 +35,10 @@
 #include "cds_objects.h"
 #include "storage.h"
 
+#include <atomic>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 
 #define QTB table_quote_begin
@@ -175,9 +177,18 @@ protected:
     void doMetadataMigration() override;
     void migrateMetadata(const std::shared_ptr<CdsObject>& object);
 
+    /// \brief Fills the sort keys of metadata rows created before they existed.
+    void migrateMetadataSortKeys();
+
     char table_quote_begin;
     char table_quote_end;
 
+    /// \brief Incremented by the drivers after every exec().
+    ///
+    /// Cached query results are only valid for the generation they were
+    /// computed in.
+    std::atomic<unsigned long> dbGeneration;
+
 private:
     std::string sql_query;
 
@@ -262,6 +273,20 @@ private:
 
     std::mutex nextIDMutex;
     using AutoLock = std::lock_guard<std::mutex>;
+
+    /// \brief Compiled search criteria.
+    struct SearchPlan {
+        std::string searchSQL;
+        /// \brief generation the match count was calculated in
+        unsigned long countGeneration;
+        int count;
+    };
+    /// \brief Search plans keyed by the normalized search criteria.
+    std::unordered_map<std::string, SearchPlan> searchPlans;
+    std::mutex searchPlanMutex;
+
+    /// \brief Returns the SQL for the criteria, parsing them only on a cache miss.
+    std::string getSearchSQL(const std::string& criteria);
 };
 
 #endif // __SQL_STORAGE_H__
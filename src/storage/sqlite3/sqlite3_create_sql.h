@@ -33,13 +33,13 @@
 
 #ifndef __SQLITE3_CREATE_SQL_H__
 #define __SQLITE3_CREATE_SQL_H__
-#define SL3_CREATE_SQL_INFLATED_SIZE 3283
-#define SL3_CREATE_SQL_DEFLATED_SIZE 804
+#define SL3_CREATE_SQL_INFLATED_SIZE 3410
+#define SL3_CREATE_SQL_DEFLATED_SIZE 826
 
 /* begin binary data: */
-const unsigned char sqlite3_create_sql[] = /* 804 */
-    { 0x78, 0x9C, 0xB5, 0x56, 0x5B, 0x6F, 0xDA, 0x30, 0x14, 0x7E, 0xE7, 0x57, 0x58, 0x79, 0x49, 0x2A, 0xB1, 0x09, 0xAA, 0x55, 0xDA, 0xD4, 0xA7, 0x14, 0xDC, 0x2A, 0x1A, 0x0D, 0x5B, 0x08, 0xD3, 0xF6, 0x64, 0x99, 0xC4, 0x80, 0x47, 0x6E, 0x72, 0x1C, 0x54, 0xFE, 0xFD, 0xEC, 0xDC, 0x43, 0x2E, 0x44, 0x53, 0x2B, 0x21, 0x04, 0xE7, 0x7C, 0xE7, 0x7E, 0xF3, 0x13, 0x7C, 0x31, 0x4C, 0x60, 0x5B, 0xBA, 0xB9, 0xD1, 0x17, 0xB6, 0xB1, 0x36, 0x1F, 0x27, 0x0B, 0x0B, 0xEA, 0x36, 0x04, 0xB6, 0xFE, 0xB4, 0x82, 0x40, 0xF1, 0x39, 0x72, 0xDC, 0x18, 0x85, 0xBB, 0xBF, 0xC4, 0xE1, 0x0A, 0xD0, 0x26, 0x00, 0x28, 0xD4, 0x55, 0x00, 0x0D, 0x38, 0x39, 0x10, 0x06, 0x22, 0x46, 0x7D, 0xCC, 0x2E, 0xE0, 0x44, 0x2E, 0x53, 0xC9, 0x63, 0x64, 0x8F, 0xEA, 0x7C, 0x97, 0xEC, 0x71, 0xE2, 0x71, 0x60, 0x6E, 0x57, 0xAB, 0x14, 0x10, 0x61, 0x46, 0x02, 0xDE, 0xC0, 0x98, 0x6B, 0x3B, 0xE5, 0x97, 0xE0, 0x59, 0x8A, 0xCC, 0x6C, 0x22, 0x7E, 0x89, 0x88, 0x02, 0x38, 0x0D, 0x2E, 0x02, 0x0F, 0x92, 0x20, 0xA6, 0x87, 0x80, 0xB8, 0xA5, 0x50, 0x0A, 0x4D, 0xA2, 0x20, 0x42, 0x8E, 0x87, 0xE3, 0x58, 0x01, 0x67, 0xCC, 0x9C, 0x23, 0x66, 0xDA, 0xD7, 0xD9, 0x5D, 0xDB, 0xBA, 0xEB, 0x20, 0x4E, 0xB9, 0x47, 0x2A, 0xD8, 0xFD, 0xC3, 0x43, 0x07, 0xCE, 0x0B, 0x1D, 0xCC, 0x69, 0x18, 0x08, 0xC3, 0xE4, 0x8D, 0xF7, 0xF3, 0xD1, 0x11, 0xC7, 0xC7, 0x2A, 0x92, 0xD2, 0xBB, 0x96, 0x80, 0x4F, 0x38, 0x76, 0x31, 0xC7, 0x7D, 0x0A, 0x71, 0xF2, 0x36, 0xC4, 0x66, 0x24, 0x0E, 0x13, 0xE6, 0x90, 0xB8, 0x0F, 0x90, 0x44, 0x42, 0x9C, 0x8C, 0x49, 0xAB, 0x4F, 0x7D, 0x92, 0x27, 0xB5, 0xC8, 0xC1, 0x97, 0xAE, 0x54, 0xED, 0x3D, 0x7C, 0x88, 0x3B, 0x42, 0x6B, 0xA9, 0x9D, 0xA7, 0x70, 0xCE, 0xB0, 0x73, 0x42, 0x41, 0xE2, 0xEF, 0x08, 0x1B, 0x28, 0x7F, 0x4C, 0xD8, 0x99, 0x3A, 0x99, 0xA3, 0x83, 0x25, 0x58, 0xAC, 0xCD, 0x8D, 0xE8, 0x4B, 0xC3, 0xB4, 0x81, 0x52, 0x75, 0x20, 0xA2, 0xBB, 0xFD, 0x09, 0xCD, 0x15, 0xF0, 0xBC, 0xB6, 0xA0, 0xF1, 0x62, 0x82, 0xEF, 0xF0, 0x0F, 0xD0, 0x8A, 0xAE, 0xBB, 0x03, 0x16, 0x7C, 0x86, 0x16, 0x34, 0x17, 0x70, 0xD3, 0x6E, 0x5D, 0x25, 0x45, 0xAC, 0x4D, 0xB0, 0x84, 0x2B, 0x28, 0x3A, 0x7C, 0xA1, 0x6F, 0x16, 0xFA, 0x12, 0x4A, 0xCA, 0xF6, 0xC7, 0x52, 0xAF, 0x28, 0xB7, 0xCC, 0xDF, 0x5F, 0x9B, 0xAF, 0x7A, 0xFA, 0x9D, 0x3C, 0x98, 0xDC, 0x3D, 0x4E, 0x0C, 0x73, 0x03, 0x2D, 0x1B, 0x08, 0x0F, 0xD6, 0x2D, 0x4D, 0xBF, 0xF4, 0xD5, 0x16, 0x6E, 0xB4, 0x4F, 0xF3, 0x69, 0x96, 0x2F, 0x20, 0x7F, 0xCD, 0x8A, 0x3F, 0x63, 0xBE, 0x4B, 0xF0, 0xB7, 0x3A, 0x7D, 0x9C, 0xD9, 0x59, 0xDD, 0xAA, 0xF8, 0xA8, 0x19, 0xFF, 0xB3, 0x13, 0x06, 0x1C, 0xD3, 0x80, 0x30, 0x55, 0xD0, 0xAC, 0x30, 0xE4, 0xEA, 0x47, 0x7A, 0x31, 0xAF, 0x29, 0xE9, 0x73, 0xE2, 0xC7, 0x02, 0x2C, 0x29, 0x13, 0xE4, 0x90, 0x5D, 0xFE, 0xDF, 0x99, 0xCE, 0x8D, 0x88, 0x1D, 0x4E, 0xCF, 0xA2, 0x8F, 0x39, 0xF1, 0x47, 0xAC, 0x45, 0x89, 0x96, 0xDB, 0xA4, 0xD1, 0xF2, 0x8D, 0x15, 0x16, 0x73, 0x31, 0xBF, 0x03, 0x80, 0x7A, 0x43, 0xB6, 0x5D, 0xE8, 0x99, 0x8B, 0xF7, 0xED, 0xC8, 0x56, 0x1E, 0x64, 0xB4, 0x2C, 0xC0, 0x1E, 0x8A, 0x09, 0x17, 0x0B, 0xFA, 0x90, 0x27, 0x42, 0x04, 0xDD, 0xDC, 0x2D, 0xB5, 0x6C, 0x34, 0x83, 0x3E, 0x63, 0x2F, 0xE9, 0x0B, 0xBA, 0x6B, 0x06, 0xDA, 0x06, 0xF3, 0x66, 0x50, 0xDD, 0x1D, 0x3A, 0x13, 0x16, 0x8B, 0x24, 0xCB, 0xBA, 0x3F, 0xA8, 0x5D, 0xEE, 0xE2, 0x84, 0x87, 0xB1, 0x83, 0x83, 0x11, 0xF5, 0x12, 0x09, 0x1A, 0x3E, 0x63, 0x52, 0x0F, 0xF2, 0xC8, 0x99, 0x78, 0x95, 0xFB, 0xF3, 0xD9, 0x75, 0x4D, 0x25, 0xC8, 0x0F, 0x5D, 0x32, 0x80, 0x11, 0xDD, 0x99, 0x08, 0xBF, 0xCF, 0x37, 0x6F, 0xDC, 0x91, 0xBA, 0x2E, 0x09, 0x6E, 0xA1, 0xD2, 0x0C, 0x89, 0xB4, 0x8E, 0xB9, 0x49, 0xE2, 0x5E, 0x72, 0xE9, 0x1E, 0xDD, 0x53, 0xE2, 0x8E, 0x11, 0x88, 0x64, 0x86, 0x63, 0x2E, 0x76, 0xDD, 0x80, 0x1B, 0xA5, 0x98, 0x3A, 0x53, 0x47, 0xDD, 0xD2, 0x08, 0xF3, 0xA3, 0x48, 0x76, 0xEF, 0x69, 0xE3, 0x61, 0xE2, 0x1C, 0xA5, 0x83, 0x23, 0x4C, 0xCE, 0xD5, 0x8E, 0x59, 0x29, 0xEA, 0x9E, 0x56, 0xB4, 0x39, 0x20, 0x79, 0x9D, 0x3F, 0x72, 0x48, 0xAA, 0xCB, 0x7F, 0xB3, 0xEB, 0xB2, 0x49, 0xEE, 0x38, 0xE1, 0x59, 0x9E, 0x58, 0x28, 0x0A, 0xC0, 0x2F, 0x28, 0xC0, 0xFE, 0xD0, 0xA6, 0xA8, 0x80, 0xF9, 0x78, 0xA5, 0x69, 0x1D, 0xD8, 0x25, 0x85, 0x87, 0xC2, 0xF4, 0xFE, 0xD4, 0xDE, 0x21, 0xB9, 0x53, 0xEF, 0x9F, 0x23, 0xC3, 0x5C, 0xC2, 0xDF, 0xA0, 0xA1, 0x09, 0x65, 0x97, 0x5C, 0x8A, 0x35, 0xE8, 0x5A, 0x46, 0x1F, 0x96, 0x2D, 0xCF, 0x70, 0x5B, 0xBC, 0x64, 0x4D, 0x6B, 0xAF, 0xCA, 0x69, 0xF1, 0x1A, 0xEC, 0x50, 0x5B, 0x83, 0xB5, 0xB5, 0xD5, 0x98, 0x1D, 0xA2, 0xE5, 0xDB, 0x30, 0x33, 0xDA, 0x16, 0x6F, 0x3C, 0x1E, 0xA7, 0xA5, 0x6B, 0x1D, 0xAA, 0xEA, 0x8F, 0xAA, 0xB6, 0x9E, 0x3A, 0xB7, 0x43, 0xF8, 0x7A, 0x59, 0x22, 0xB9, 0x7E, 0x33, 0x25, 0xD7, 0x2C, 0x4D, 0xB0, 0x2A, 0x0D, 0x5B, 0xD3, 0xF8, 0xB9, 0xAD, 0x29, 0x2A, 0xE7, 0x27, 0x9B, 0x96, 0x5C, 0x47, 0x41, 0xD5, 0x32, 0xEA, 0x70, 0x69, 0xAA, 0x67, 0x5F, 0x3B, 0x8C, 0x8A, 0xD7, 0xA1, 0xA3, 0xEA, 0xCD, 0xAC, 0x0D, 0x73, 0xF1, 0x82, 0xAC, 0xE5, 0x64, 0x29, 0xB9, 0x7E, 0x7D, 0x35, 0xEC, 0xC7, 0xC9, 0x3F, 0x2B, 0x86, 0xFE, 0x65 };
-/* end binary data. size = 804 bytes */
+const unsigned char sqlite3_create_sql[] = /* 826 */
+    { 0x78, 0xDA, 0xB5, 0x56, 0x5B, 0x6F, 0xDA, 0x30, 0x14, 0x7E, 0xE7, 0x57, 0x58, 0x79, 0x49, 0x2A, 0xB1, 0x09, 0xAA, 0x75, 0xDA, 0xC4, 0x53, 0x0A, 0x6E, 0x15, 0x8D, 0x86, 0x0E, 0xC2, 0xB4, 0x3D, 0x59, 0x26, 0x31, 0xE0, 0x91, 0x9B, 0x1C, 0x07, 0x95, 0x7F, 0x3F, 0x3B, 0xF7, 0x90, 0x0B, 0xD1, 0xD4, 0x4A, 0x08, 0xC1, 0x39, 0xDF, 0xB9, 0xDF, 0xFC, 0x08, 0x9F, 0x0D, 0x13, 0x58, 0x6B, 0xDD, 0xDC, 0xE8, 0x73, 0xCB, 0x58, 0x99, 0xB3, 0xD1, 0x7C, 0x0D, 0x75, 0x0B, 0x02, 0x4B, 0x7F, 0x5C, 0x42, 0xA0, 0x78, 0x1C, 0xD9, 0x4E, 0x84, 0x82, 0xDD, 0x5F, 0x62, 0x73, 0x05, 0x68, 0x23, 0x00, 0x14, 0xEA, 0x28, 0x80, 0xFA, 0x9C, 0x1C, 0x08, 0x03, 0x21, 0xA3, 0x1E, 0x66, 0x17, 0x70, 0x22, 0x97, 0xB1, 0xE4, 0x31, 0xB2, 0x47, 0x55, 0xBE, 0x43, 0xF6, 0x38, 0x76, 0x39, 0x30, 0xB7, 0xCB, 0x65, 0x02, 0x08, 0x31, 0x23, 0x3E, 0xAF, 0x61, 0xCC, 0x95, 0x95, 0xF0, 0x0B, 0xF0, 0x24, 0x41, 0xA6, 0x36, 0x11, 0xBF, 0x84, 0x44, 0x01, 0x9C, 0xFA, 0x17, 0x81, 0x07, 0xB1, 0x1F, 0xD1, 0x83, 0x4F, 0x9C, 0x42, 0x28, 0x81, 0xC6, 0xA1, 0x1F, 0x22, 0xDB, 0xC5, 0x51, 0xA4, 0x80, 0x33, 0x66, 0xF6, 0x11, 0x33, 0xED, 0xDB, 0xE4, 0xAE, 0x69, 0xDD, 0xB1, 0x11, 0xA7, 0xDC, 0x25, 0x25, 0xEC, 0xFE, 0xE1, 0xA1, 0x05, 0xE7, 0x06, 0x36, 0xE6, 0x34, 0xF0, 0x85, 0x61, 0xF2, 0xC6, 0xBB, 0xF9, 0xE8, 0x88, 0xA3, 0x63, 0x19, 0x49, 0xE1, 0x5D, 0x43, 0xC0, 0x23, 0x1C, 0x3B, 0x98, 0xE3, 0x2E, 0x85, 0x38, 0x7E, 0xEB, 0x63, 0x33, 0x12, 0x05, 0x31, 0xB3, 0x49, 0xD4, 0x05, 0x88, 0x43, 0x21, 0x4E, 0x86, 0xA4, 0xD5, 0xA3, 0x1E, 0xC9, 0x92, 0x9A, 0xE7, 0xE0, 0x4B, 0x5B, 0xAA, 0xF6, 0x2E, 0x3E, 0x44, 0x2D, 0xA1, 0x35, 0xD4, 0x4E, 0x13, 0x38, 0x67, 0xD8, 0x3E, 0x21, 0x3F, 0xF6, 0x76, 0x84, 0xF5, 0x94, 0x3F, 0x22, 0xEC, 0x4C, 0xED, 0xD4, 0xD1, 0xDE, 0x12, 0xCC, 0x57, 0xE6, 0x46, 0xF4, 0xA5, 0x61, 0x5A, 0x40, 0x29, 0x3B, 0x10, 0xD1, 0xDD, 0xFE, 0x84, 0xA6, 0x0A, 0x78, 0x5A, 0xAD, 0xA1, 0xF1, 0x6C, 0x82, 0x1F, 0xF0, 0x0F, 0xD0, 0xF2, 0xAE, 0xBB, 0x03, 0x6B, 0xF8, 0x04, 0xD7, 0xD0, 0x9C, 0xC3, 0x4D, 0xB3, 0x75, 0x95, 0x04, 0xB1, 0x32, 0xC1, 0x02, 0x2E, 0xA1, 0xE8, 0xF0, 0xB9, 0xBE, 0x99, 0xEB, 0x0B, 0x28, 0x29, 0xDB, 0xD7, 0x85, 0x5E, 0x52, 0x6E, 0x99, 0xBF, 0xBF, 0x36, 0x5F, 0xF6, 0xF4, 0x3B, 0x79, 0x30, 0xBA, 0x9B, 0x8D, 0x0C, 0x73, 0x03, 0xD7, 0x16, 0x10, 0x1E, 0xAC, 0x1A, 0x9A, 0x7E, 0xE9, 0xCB, 0x2D, 0xDC, 0x68, 0x9F, 0xA6, 0xE3, 0x34, 0x5F, 0x40, 0xFE, 0x9A, 0xE4, 0x7F, 0x86, 0x7C, 0x17, 0xE0, 0xEF, 0x55, 0xFA, 0x30, 0xB3, 0x93, 0xAA, 0x55, 0xF1, 0x51, 0x53, 0xFE, 0x67, 0x3B, 0xF0, 0x39, 0xA6, 0x3E, 0x61, 0xAA, 0xA0, 0xAD, 0x83, 0x80, 0xAB, 0x1F, 0xE9, 0xC5, 0xB4, 0xA2, 0xA4, 0xCB, 0x89, 0xD7, 0x39, 0x58, 0x50, 0x26, 0xC8, 0x01, 0xBB, 0xFC, 0xBF, 0x33, 0xAD, 0x1B, 0x11, 0xDB, 0x9C, 0x9E, 0x45, 0x1F, 0x73, 0xE2, 0x0D, 0x58, 0x8B, 0x12, 0x2D, 0xB7, 0x49, 0xAD, 0xE5, 0x6B, 0x2B, 0x2C, 0xE2, 0x62, 0x7E, 0x7B, 0x00, 0xD5, 0x86, 0x6C, 0xBA, 0xD0, 0x31, 0x17, 0xEF, 0xDB, 0x91, 0x8D, 0x3C, 0xC8, 0x68, 0x99, 0x8F, 0x5D, 0x14, 0x11, 0x2E, 0x16, 0xF4, 0x21, 0x4B, 0x84, 0x08, 0xBA, 0xBE, 0x5B, 0x2A, 0xD9, 0xA8, 0x07, 0x7D, 0xC6, 0x6E, 0xDC, 0x15, 0x74, 0xDB, 0x0C, 0x34, 0x0D, 0x66, 0xCD, 0xA0, 0x3A, 0x3B, 0x74, 0x26, 0x2C, 0x12, 0x49, 0x96, 0x75, 0xFF, 0xAA, 0xB6, 0xB9, 0x8B, 0x63, 0x1E, 0x44, 0x36, 0xF6, 0x07, 0xD4, 0x4B, 0x24, 0xA8, 0xFF, 0x8C, 0x49, 0x3D, 0xC8, 0x25, 0x67, 0xE2, 0x96, 0xEE, 0x4F, 0x27, 0xD7, 0x35, 0x95, 0x20, 0x2F, 0x70, 0x48, 0x0F, 0x46, 0x74, 0x67, 0x2C, 0xFC, 0x3E, 0xDF, 0xBC, 0x71, 0x47, 0xEA, 0x38, 0xC4, 0xBF, 0x85, 0x4A, 0x32, 0x24, 0xD2, 0x3A, 0xE4, 0x26, 0x89, 0x7B, 0xC9, 0xA5, 0x7B, 0x74, 0x4F, 0x89, 0x33, 0x44, 0x20, 0x94, 0x19, 0x8E, 0xB8, 0xD8, 0x75, 0x3D, 0x6E, 0x14, 0x62, 0xEA, 0x44, 0x1D, 0x74, 0x4B, 0x43, 0xCC, 0x8F, 0x22, 0xD9, 0x9D, 0xA7, 0x8D, 0x07, 0xB1, 0x7D, 0x94, 0x0E, 0x0E, 0x30, 0x39, 0x55, 0x5B, 0x66, 0x25, 0xAF, 0x7B, 0x52, 0xD1, 0xFA, 0x80, 0x64, 0x75, 0xFE, 0xC8, 0x21, 0x29, 0x2F, 0xFF, 0xCD, 0xAE, 0x4B, 0x27, 0xB9, 0xE5, 0x84, 0xA7, 0x79, 0x62, 0x81, 0x28, 0x00, 0xBF, 0x20, 0x1F, 0x7B, 0x7D, 0x9B, 0xA2, 0x04, 0x66, 0xE3, 0x95, 0xA4, 0xB5, 0x1D, 0x11, 0x05, 0x8C, 0xA3, 0x64, 0x5E, 0xBB, 0x3A, 0xFD, 0x2A, 0x97, 0x79, 0x34, 0xC2, 0xCD, 0xFD, 0xA9, 0xB9, 0x6F, 0xB2, 0x00, 0xDE, 0x3F, 0x9F, 0x86, 0xB9, 0x80, 0xBF, 0x41, 0x4D, 0x13, 0x4A, 0xAF, 0xBE, 0x14, 0xAB, 0xD1, 0xB5, 0x94, 0xDE, 0x2F, 0x5B, 0x9C, 0xEC, 0xA6, 0x78, 0xC1, 0x1A, 0x57, 0x5E, 0xA0, 0xE3, 0xFC, 0xE5, 0xD8, 0xA2, 0xB6, 0x02, 0x6B, 0x6A, 0xAB, 0x30, 0x5B, 0x44, 0x8B, 0x77, 0x64, 0x6A, 0xB4, 0x29, 0x5E, 0x7B, 0x68, 0x8E, 0x0B, 0xD7, 0x5A, 0x54, 0x55, 0x1F, 0x60, 0x4D, 0x3D, 0x55, 0x6E, 0x8B, 0xF0, 0xF5, 0x62, 0x95, 0x3D, 0x91, 0x29, 0xB9, 0x66, 0x69, 0x82, 0x55, 0x6A, 0xD8, 0x9A, 0xC6, 0xCF, 0x6D, 0x45, 0x51, 0x31, 0x6B, 0xE9, 0x64, 0x65, 0x3A, 0x72, 0xAA, 0x96, 0x52, 0xFB, 0x4B, 0x53, 0x3E, 0x11, 0x9B, 0x61, 0x94, 0xBC, 0x16, 0x1D, 0x65, 0x6F, 0xA6, 0x6D, 0x98, 0x89, 0xE7, 0x64, 0x2D, 0x23, 0xF7, 0x49, 0xE6, 0xF3, 0x70, 0x2D, 0x5A, 0x9B, 0xBD, 0x71, 0x63, 0x7C, 0xA4, 0xCA, 0xD5, 0xCB, 0x8B, 0x61, 0xCD, 0x46, 0xFF, 0x00, 0xA2, 0x2D, 0x2C, 0xA6 };
+/* end binary data. size = 826 bytes */
 
 #endif // __SQLITE3_CREATE_SQL_H__
 
@@ -100,6 +100,11 @@ CREATE INDEX mt_track_number on mt_cds_object (track_number); \
 PRAGMA foreign_keys = ON;"
 #define SQLITE3_UPDATE_4_5_2 "UPDATE mt_internal_setting SET value='5' WHERE key='db_version' AND value='4'"
 
+// updates 5->6: Typed sort keys for metadata
+#define SQLITE3_UPDATE_5_6_1 "ALTER TABLE \"mt_metadata\" ADD \"property_sort_key\" integer default NULL"
+#define SQLITE3_UPDATE_5_6_2 "CREATE INDEX mt_metadata_sort_key ON mt_metadata(property_name,property_sort_key)"
+#define SQLITE3_UPDATE_5_6_3 "UPDATE \"mt_internal_setting\" SET \"value\"='6' WHERE \"key\"='db_version' AND \"value\"='5'"
+
 #define SL3_INITITAL_QUEUE_SIZE 20
 
 using namespace std;
@@ -244,9 +249,19 @@ void Sqlite3Storage::init()
         dbVersion = "5";
     }
 
+    if (dbVersion == "5") {
+        log_info("Running an automatic database upgrade from database version 5 to version 6...");
+        _exec(SQLITE3_UPDATE_5_6_1);
+        _exec(SQLITE3_UPDATE_5_6_2);
+        migrateMetadataSortKeys();
+        _exec(SQLITE3_UPDATE_5_6_3);
+        log_info("Database upgrade successful.");
+        dbVersion = "6";
+    }
+
     /* --- --- ---*/
 
-    if (!string_ok(dbVersion) || dbVersion != "5")
+    if (!string_ok(dbVersion) || dbVersion != "6")
         throw std::runtime_error("The database seems to be from a newer version!");
 
     // add timer for backups
@@ -303,6 +318,7 @@ int Sqlite3Storage::exec(const char* query, int length, bool getLastInsertId)
     auto etask = std::make_shared<SLExecTask>(query, getLastInsertId);
     addTask(etask);
     etask->waitForTask();
+    dbGeneration++;
     return getLastInsertId ? etask->getLastInsertId() : -1;
 }
 
@@ -330,10 +346,12 @@ void Sqlite3Storage::threadProc()
     cond.notify_one();
 
     while (!shutdownFlag) {
-        while (taskQueue.empty()) {
+        while (taskQueue.empty() && !shutdownFlag) {
             /* if nothing to do, sleep until awakened */
             cond.wait(lock);
         }
+        if (shutdownFlag)
+            break;
 
         auto task = taskQueue.front();
         taskQueue.pop();
@@ -0,0 +1,274 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    transcode_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file transcode_cache.cc
+
+#include "transcode_cache.h" // API
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "iohandler/io_handler.h"
+#include "util/tools.h"
+
+#define PART_SUFFIX ".part"
+#define DRAIN_CHUNK_SIZE (64 * 1024)
+
+/// \brief Passes the transcoder output through and writes it to the cache.
+class TranscodeRecordIOHandler : public IOHandler {
+public:
+    TranscodeRecordIOHandler(std::shared_ptr<TranscodeCache> cache, std::string key, fs::path part, int fd, std::unique_ptr<IOHandler> source, off_t announcedLength)
+        : cache(std::move(cache))
+        , key(std::move(key))
+        , part(std::move(part))
+        , fd(fd)
+        , written(0)
+        , announcedLength(announcedLength)
+        , source(std::move(source))
+    {
+    }
+
+    ~TranscodeRecordIOHandler() override
+    {
+        stop();
+    }
+
+    // the transcoder output is open already
+    void open(enum UpnpOpenFileMode mode) override { }
+
+    size_t read(char* buf, size_t length) override
+    {
+        size_t ret = source->read(buf, length);
+        if (fd < 0)
+            return ret;
+
+        if (ret == 0) {
+            finish();
+        } else if (ret == static_cast<size_t>(-1)) {
+            stop();
+        } else if (ret <= length && !store(buf, ret)) {
+            stop();
+        }
+        return ret;
+    }
+
+    // a stream that does not start at 0 can not be cached
+    void seek(off_t offset, int whence) override
+    {
+        stop();
+        source->seek(offset, whence);
+    }
+
+    off_t tell() override
+    {
+        return source->tell();
+    }
+
+    void close() override
+    {
+        // the web server stops at the estimated length, which is usually
+        // close to the end of the stream
+        if (fd >= 0 && announcedLength > 0 && written >= announcedLength)
+            drain();
+        stop();
+        source->close();
+    }
+
+protected:
+    std::shared_ptr<TranscodeCache> cache;
+    std::string key;
+    fs::path part;
+    int fd;
+    off_t written;
+    off_t announcedLength;
+    std::unique_ptr<IOHandler> source;
+
+    bool store(const char* buf, size_t length)
+    {
+        if (written + static_cast<off_t>(length) > cache->maxSize) {
+            log_debug("transcode cache: {} is too large to be cached", key);
+            return false;
+        }
+
+        while (length > 0) {
+            ssize_t ret = ::write(fd, buf, length);
+            if (ret < 0) {
+                if (errno == EINTR)
+                    continue;
+                log_warning("transcode cache: could not write {}: {}", part.c_str(), std::strerror(errno));
+                return false;
+            }
+            buf += ret;
+            length -= ret;
+            written += ret;
+        }
+        return true;
+    }
+
+    /// \brief Stores the rest of the stream that was not served.
+    void drain()
+    {
+        // a far too low estimate would keep the request busy
+        off_t limit = announcedLength + announcedLength / 4;
+        std::vector<char> buf(DRAIN_CHUNK_SIZE);
+        while (fd >= 0) {
+            size_t ret = source->read(buf.data(), buf.size());
+            if (ret == 0)
+                finish();
+            else if (ret > buf.size() || written + static_cast<off_t>(ret) > limit || !store(buf.data(), ret))
+                stop();
+        }
+    }
+
+    void finish()
+    {
+        int ret = ::close(fd);
+        fd = -1;
+        if (ret == 0 && written > 0)
+            cache->commit(key, part, written);
+        else
+            cache->abandon(key, part);
+    }
+
+    void stop()
+    {
+        if (fd < 0)
+            return;
+        ::close(fd);
+        fd = -1;
+        cache->abandon(key, part);
+    }
+};
+
+TranscodeCache::TranscodeCache(fs::path cacheDir, off_t maxSize)
+    : cacheDir(std::move(cacheDir))
+    , maxSize(maxSize)
+    , used(-1)
+{
+    std::error_code ec;
+    if (!fs::create_directories(this->cacheDir, ec) && ec)
+        throw std::runtime_error("transcode cache: could not create " + this->cacheDir.string() + ": " + ec.message());
+
+    // recordings interrupted by a shutdown or crash
+    for (const auto& entry : fs::directory_iterator(this->cacheDir, ec)) {
+        if (entry.path().extension() == PART_SUFFIX)
+            fs::remove(entry.path(), ec);
+    }
+}
+
+std::string TranscodeCache::makeKey(const std::string& profileName, const fs::path& location, time_t mtime)
+{
+    std::string profile = profileName;
+    std::replace_if(
+        profile.begin(), profile.end(), [](char c) { return !isalnum(c) && c != '-'; }, '_');
+    return fmt::format("{}_{}_{}", profile, hex_string_md5(location.string()), mtime);
+}
+
+fs::path TranscodeCache::lookup(const std::string& key)
+{
+    AutoLock lock(mutex);
+    auto path = cacheDir / key;
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec))
+        return "";
+
+    // the modification time orders the entries for eviction
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    log_debug("transcode cache: serving {}", key);
+    return path;
+}
+
+std::unique_ptr<IOHandler> TranscodeCache::record(const std::string& key, std::unique_ptr<IOHandler> source, off_t announcedLength)
+{
+    AutoLock lock(mutex);
+    if (recording.find(key) != recording.end())
+        return source;
+
+    auto part = cacheDir / (key + PART_SUFFIX);
+    int fd = ::open(part.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        log_warning("transcode cache: could not create {}: {}", part.c_str(), std::strerror(errno));
+        return source;
+    }
+
+    log_debug("transcode cache: recording {}", key);
+    recording.insert(key);
+    return std::make_unique<TranscodeRecordIOHandler>(shared_from_this(), key, part, fd, std::move(source), announcedLength);
+}
+
+void TranscodeCache::commit(const std::string& key, const fs::path& part, off_t size)
+{
+    AutoLock lock(mutex);
+    recording.erase(key);
+
+    trim(size);
+    std::error_code ec;
+    fs::rename(part, cacheDir / key, ec);
+    if (ec) {
+        log_warning("transcode cache: could not store {}: {}", key, ec.message());
+        fs::remove(part, ec);
+        return;
+    }
+    used += size;
+    log_debug("transcode cache: stored {} ({} bytes)", key, size);
+}
+
+void TranscodeCache::abandon(const std::string& key, const fs::path& part)
+{
+    AutoLock lock(mutex);
+    recording.erase(key);
+
+    std::error_code ec;
+    fs::remove(part, ec);
+}
+
+void TranscodeCache::trim(off_t needed)
+{
+    if (used >= 0 && used + needed <= maxSize)
+        return;
+
+    std::vector<std::pair<fs::file_time_type, fs::directory_entry>> files;
+    std::error_code ec;
+    used = 0;
+    for (const auto& entry : fs::directory_iterator(cacheDir, ec)) {
+        if (!entry.is_regular_file(ec) || entry.path().extension() == PART_SUFFIX)
+            continue;
+        used += entry.file_size(ec);
+        files.emplace_back(entry.last_write_time(ec), entry);
+    }
+
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& file : files) {
+        if (used + needed <= maxSize)
+            break;
+        auto size = file.second.file_size(ec);
+        if (fs::remove(file.second.path(), ec))
+            used -= size;
+    }
+}
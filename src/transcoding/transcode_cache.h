@@ -0,0 +1,91 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    transcode_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file transcode_cache.h
+/// \brief Definition of the TranscodeCache class.
+#ifndef GERBERA_TRANSCODE_CACHE_H
+#define GERBERA_TRANSCODE_CACHE_H
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+namespace fs = std::filesystem;
+
+// forward declaration
+class IOHandler;
+
+/// \brief Disk cache for the output of transcoding profiles.
+///
+/// The first complete stream of a source is written to the cache while it
+/// is served; later requests get the cached file, which can be seeked like
+/// any other file. Streams that are aborted or seeked are not stored.
+/// Keys contain the profile name and the modification time of the source,
+/// the least recently used entries are removed when the cache is full.
+class TranscodeCache : public std::enable_shared_from_this<TranscodeCache> {
+public:
+    /// \param cacheDir directory holding the cached streams
+    /// \param maxSize maximum number of bytes stored in cacheDir
+    TranscodeCache(fs::path cacheDir, off_t maxSize);
+
+    /// \brief Builds the key of the output of a profile for a source file.
+    static std::string makeKey(const std::string& profileName, const fs::path& location, time_t mtime);
+
+    /// \brief Returns the path of the complete entry or an empty path.
+    fs::path lookup(const std::string& key);
+
+    /// \brief Stores the stream read from source under key.
+    /// \param source open handler of the transcoder output, read from the start
+    /// \param announcedLength estimated length sent to the client, -1 if none;
+    /// once it was served, the rest of the stream is stored on close
+    /// \return handler to be served instead of source; source itself if the
+    /// entry is already being recorded by another request
+    std::unique_ptr<IOHandler> record(const std::string& key, std::unique_ptr<IOHandler> source, off_t announcedLength = -1);
+
+protected:
+    fs::path cacheDir;
+    off_t maxSize;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    /// \brief bytes stored in cacheDir, -1 until the directory was scanned
+    off_t used;
+    /// \brief keys currently being recorded
+    std::set<std::string> recording;
+
+    /// \brief Makes a recorded stream available under key.
+    void commit(const std::string& key, const fs::path& part, off_t size);
+
+    /// \brief Drops a recording that did not complete.
+    void abandon(const std::string& key, const fs::path& part);
+
+    /// \brief Removes the oldest entries until needed more bytes fit.
+    void trim(off_t needed);
+
+    friend class TranscodeRecordIOHandler;
+};
+
+#endif // GERBERA_TRANSCODE_CACHE_H
@@ -47,14 +47,15 @@ TranscodeDispatcher::TranscodeDispatcher(std::shared_ptr<ConfigManager> config,
 std::unique_ptr<IOHandler> TranscodeDispatcher::open(std::shared_ptr<TranscodingProfile> profile,
     std::string location,
     std::shared_ptr<CdsObject> obj,
-    std::string range)
+    std::string range,
+    double start)
 {
     if (profile == nullptr)
         throw std::runtime_error("Transcoding of file " + location + "requested but no profile given ");
 
     if (profile->getType() == TR_External) {
         auto tr_ext = std::make_unique<TranscodeExternalHandler>(config, content);
-        return tr_ext->open(profile, location, obj, range);
+        return tr_ext->open(profile, location, obj, range, start);
     }
 
     throw std::runtime_error("Unknown transcoding type for profile " + profile->getName());
@@ -42,7 +42,8 @@ public:
     std::unique_ptr<IOHandler> open(std::shared_ptr<TranscodingProfile> profile,
         std::string location,
         std::shared_ptr<CdsObject> obj,
-        std::string range) override;
+        std::string range,
+        double start) override;
 };
 
 #endif // __TRANSCODE_DISPATCHER_H__
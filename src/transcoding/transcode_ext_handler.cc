@@ -63,6 +63,35 @@
 #include "iohandler/curl_io_handler.h"
 #endif
 
+// pipe buffer size the kernel starts with
+#define DEFAULT_PIPE_SIZE 65536
+
+/// \brief Creates a pipe for a transcoder, both ends are closed on exec
+/// unless handed to the process explicitly.
+/// \param size requested pipe buffer size, the kernel may grant less
+/// \param writeEnd true if we write to the pipe and the transcoder reads from it
+/// \return false if no pipe could be created and a fifo has to be used instead
+static bool createPipe(int pipeFds[2], int size, bool writeEnd)
+{
+    if (pipe2(pipeFds, O_CLOEXEC) == -1) {
+        log_warning("Failed to create pipe for the transcoding process, falling back to a fifo: {}", strerror(errno));
+        return false;
+    }
+
+#ifdef F_SETPIPE_SZ
+    // unprivileged processes are limited to /proc/sys/fs/pipe-max-size
+    for (int pipeSize = size; pipeSize > DEFAULT_PIPE_SIZE; pipeSize /= 2) {
+        if (fcntl(pipeFds[0], F_SETPIPE_SZ, pipeSize) != -1)
+            break;
+    }
+#endif
+
+    // our end behaves like the fifo opened with O_NONBLOCK
+    int ourFd = writeEnd ? pipeFds[1] : pipeFds[0];
+    fcntl(ourFd, F_SETFL, fcntl(ourFd, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
 TranscodeExternalHandler::TranscodeExternalHandler(std::shared_ptr<ConfigManager> config,
     std::shared_ptr<ContentManager> content)
     : TranscodeHandler(std::move(config), std::move(content))
@@ -72,7 +101,8 @@ TranscodeExternalHandler::TranscodeExternalHandler(std::shared_ptr<ConfigManager
 std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<TranscodingProfile> profile,
     std::string location,
     std::shared_ptr<CdsObject> obj,
-    std::string range)
+    std::string range,
+    double start)
 {
     bool isURL = false;
     //    bool is_srt = false;
@@ -103,12 +133,40 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
         }
     }
 
-    fs::path fifo_name = tempName(config->getOption(CFG_SERVER_TMPDIR), fifo_template);
+    fs::path check;
+    if (profile->getCommand().is_absolute()) {
+        if (!fs::is_regular_file(profile->getCommand()))
+            throw std::runtime_error("Could not find transcoder: " + profile->getCommand().string());
+
+        check = profile->getCommand();
+    } else {
+        check = find_in_path(profile->getCommand());
+
+        if (!string_ok(check))
+            throw std::runtime_error("Could not find transcoder " + profile->getCommand().string() + " in $PATH");
+    }
+
+    int err = 0;
+    if (!is_executable(check, &err))
+        throw std::runtime_error("Transcoder " + profile->getCommand().string() + " is not executable: " + strerror(err));
+
+    bool usePipes = config->getOption(CFG_TRANSCODING_OUTPUT) == "pipe";
+    fs::path fifo_name;
+    std::string output;
+    // location is a reader fifo created for the transcoder
+    bool removeLocation = false;
     std::string arguments;
     std::string temp;
     std::string command;
     std::vector<std::string> arglist;
     std::vector<std::shared_ptr<ProcListItem>> proc_list;
+    // pipe ends handed to the transcoder, closed here once it is launched
+    std::vector<int> childFds;
+    auto closeChildFds = [&childFds]() {
+        for (int fd : childFds)
+            ::close(fd);
+        childFds.clear();
+    };
 
 #ifdef SOPCAST
     service_type_t service = OS_None;
@@ -135,28 +193,44 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
         if (isURL && (!profile->acceptURL())) {
 #ifdef HAVE_CURL
             std::string url = location;
-            strcpy(fifo_template, "mt_transcode_XXXXXX");
-            location = tempName(config->getOption(CFG_SERVER_TMPDIR), fifo_template);
-            log_debug("creating reader fifo: {}", location.c_str());
-            if (mkfifo(location.c_str(), O_RDWR) == -1) {
-                log_error("Failed to create fifo for the remote content "
-                          "reading thread: {}\n",
-                    strerror(errno));
-                throw std::runtime_error("Could not create reader fifo!\n");
+            int inPipe[2] = { -1, -1 };
+            if (usePipes && createPipe(inPipe, config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE), true)) {
+                location = fmt::format("/dev/fd/{}", inPipe[0]);
+                childFds.push_back(inPipe[0]);
+            } else {
+                char reader_template[] = "mt_transcode_XXXXXX";
+                location = tempName(config->getOption(CFG_SERVER_TMPDIR), reader_template);
+                removeLocation = true;
+                log_debug("creating reader fifo: {}", location.c_str());
+                if (mkfifo(location.c_str(), O_RDWR) == -1) {
+                    log_error("Failed to create fifo for the remote content "
+                              "reading thread: {}\n",
+                        strerror(errno));
+                    throw std::runtime_error("Could not create reader fifo!\n");
+                }
+                chmod(location.c_str(), S_IWUSR | S_IRUSR);
             }
 
             try {
-                chmod(location.c_str(), S_IWUSR | S_IRUSR);
-
                 std::unique_ptr<IOHandler> c_ioh = std::make_unique<CurlIOHandler>(url, nullptr,
                     config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE),
-                    config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE));
-                std::unique_ptr<IOHandler> p_ioh = std::make_unique<ProcessIOHandler>(content, location, nullptr);
+                    config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE),
+                    content->getStreamReactor());
+                std::unique_ptr<IOHandler> p_ioh;
+                if (removeLocation)
+                    p_ioh = std::make_unique<ProcessIOHandler>(content, location, nullptr);
+                else
+                    p_ioh = std::make_unique<ProcessIOHandler>(content, inPipe[1], nullptr);
                 auto ch = std::make_shared<IOHandlerChainer>(c_ioh, p_ioh, 16384);
                 auto pr_item = std::make_shared<ProcListItem>(ch);
                 proc_list.push_back(pr_item);
             } catch (const std::runtime_error& ex) {
-                unlink(location.c_str());
+                if (removeLocation) {
+                    unlink(location.c_str());
+                } else {
+                    closeChildFds();
+                    ::close(inPipe[1]);
+                }
                 throw ex;
             }
 #else
@@ -168,45 +242,62 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
     }
 #endif
 
-    fs::path check;
-    if (profile->getCommand().is_absolute()) {
-        if (!fs::is_regular_file(profile->getCommand()))
-            throw std::runtime_error("Could not find transcoder: " + profile->getCommand().string());
-
-        check = profile->getCommand();
+    int outPipe[2];
+    if (usePipes && createPipe(outPipe, profile->getBufferSize(), false)) {
+        output = fmt::format("/dev/fd/{}", outPipe[1]);
+        childFds.push_back(outPipe[1]);
     } else {
-        check = find_in_path(profile->getCommand());
-
-        if (!string_ok(check))
-            throw std::runtime_error("Could not find transcoder " + profile->getCommand().string() + " in $PATH");
-    }
-
-    int err = 0;
-    if (!is_executable(check, &err))
-        throw std::runtime_error("Transcoder " + profile->getCommand().string() + " is not executable: " + strerror(err));
+        usePipes = false;
+        fifo_name = tempName(config->getOption(CFG_SERVER_TMPDIR), fifo_template);
+        log_debug("creating fifo: {}", fifo_name.c_str());
+        if (mkfifo(fifo_name.c_str(), O_RDWR) == -1) {
+            log_error("Failed to create fifo for the transcoding process!: {}", strerror(errno));
+            closeChildFds();
+            throw std::runtime_error("Could not create fifo!\n");
+        }
 
-    log_debug("creating fifo: {}", fifo_name.c_str());
-    if (mkfifo(fifo_name.c_str(), O_RDWR) == -1) {
-        log_error("Failed to create fifo for the transcoding process!: {}", strerror(errno));
-        throw std::runtime_error("Could not create fifo!\n");
+        chmod(fifo_name.c_str(), S_IWUSR | S_IRUSR);
+        output = fifo_name;
     }
 
-    chmod(fifo_name.c_str(), S_IWUSR | S_IRUSR);
-
-    arglist = populateCommandLine(profile->getArguments(), location, fifo_name, range);
+    if (start > 0 && !profile->isTimeSeekable())
+        log_warning("Transcoding profile {} can not start at {}s, add %start to its arguments", profile->getName(), start);
+    arglist = populateCommandLine(profile->getArguments(), location, output, range, start > 0 ? secondsToNpt(start) : "");
 
     log_debug("Command: {}", profile->getCommand().c_str());
     log_debug("Arguments: {}", profile->getArguments().c_str());
-    auto main_proc = std::make_shared<TranscodingProcessExecutor>(profile->getCommand(), arglist);
-    main_proc->removeFile(fifo_name);
-    if (isURL && (!profile->acceptURL())) {
+    std::string ioClass = config->getOption(CFG_TRANSCODING_SCHEDULER_IO_CLASS);
+    std::shared_ptr<TranscodingProcessExecutor> main_proc;
+    try {
+        main_proc = std::make_shared<TranscodingProcessExecutor>(profile->getCommand(), arglist,
+            config->getIntOption(CFG_TRANSCODING_SCHEDULER_NICE),
+            (ioClass == "idle") ? IO_CLASS_IDLE : ((ioClass == "best-effort") ? IO_CLASS_BEST_EFFORT : IO_CLASS_NONE),
+            childFds);
+    } catch (const std::runtime_error& ex) {
+        closeChildFds();
+        if (usePipes)
+            ::close(outPipe[0]);
+        throw ex;
+    }
+    // the transcoder holds its own copies now, our write end would keep
+    // the pipe from reporting the end of the stream
+    closeChildFds();
+    if (removeLocation) {
         main_proc->removeFile(location);
     }
 
-    std::unique_ptr<IOHandler> u_ioh = std::make_unique<ProcessIOHandler>(content, fifo_name, main_proc, proc_list);
-    auto io_handler = std::make_unique<BufferedIOHandler>(
-        u_ioh,
-        profile->getBufferSize(), profile->getBufferChunkSize(), profile->getBufferInitialFillSize());
+    std::unique_ptr<IOHandler> io_handler;
+    if (usePipes) {
+        // the pipe buffers the output in the kernel, no buffer thread needed
+        io_handler = std::make_unique<ProcessIOHandler>(content, outPipe[0], main_proc, proc_list);
+    } else {
+        main_proc->removeFile(fifo_name);
+        std::unique_ptr<IOHandler> u_ioh = std::make_unique<ProcessIOHandler>(content, fifo_name, main_proc, proc_list);
+        io_handler = std::make_unique<BufferedIOHandler>(
+            u_ioh,
+            profile->getBufferSize(), profile->getBufferChunkSize(), profile->getBufferInitialFillSize(),
+            content->getStreamReactor());
+    }
     io_handler->open(UPNP_READ);
     content->triggerPlayHook(obj);
     return io_handler;
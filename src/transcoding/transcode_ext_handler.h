@@ -46,7 +46,8 @@ public:
     std::unique_ptr<IOHandler> open(std::shared_ptr<TranscodingProfile> profile,
         std::string location,
         std::shared_ptr<CdsObject> obj,
-        std::string range) override;
+        std::string range,
+        double start) override;
 };
 
 #endif // __TRANSCODE_EXTERNAL_HANDLER_H__
@@ -50,10 +50,15 @@ public:
         std::shared_ptr<ContentManager> content)
         : config(config)
         , content(content) {};
+
+    /// \brief Starts transcoding of the given location.
+    /// \param start position in seconds to start at, only honoured by
+    /// profiles that are time seekable
     virtual std::unique_ptr<IOHandler> open(std::shared_ptr<TranscodingProfile> profile,
         std::string location,
         std::shared_ptr<CdsObject> obj,
-        std::string range)
+        std::string range,
+        double start)
         = 0;
 
 protected:
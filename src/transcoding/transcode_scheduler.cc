@@ -0,0 +1,167 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    transcode_scheduler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file transcode_scheduler.cc
+
+#include "transcode_scheduler.h" // API
+
+#include <utility>
+
+#include "exceptions.h"
+
+TranscodeJob::TranscodeJob(std::shared_ptr<TranscodeScheduler> scheduler, int id, std::string profileName)
+    : scheduler(std::move(scheduler))
+    , id(id)
+    , profileName(std::move(profileName))
+    , started(std::chrono::steady_clock::now())
+    , bytes(0)
+{
+}
+
+TranscodeJob::~TranscodeJob()
+{
+    scheduler->release(id, profileName);
+}
+
+std::chrono::milliseconds TranscodeJob::getElapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+}
+
+off_t TranscodeJob::getThroughput() const
+{
+    auto elapsed = getElapsed().count();
+    return elapsed > 0 ? bytes * 1000 / elapsed : 0;
+}
+
+TranscodeScheduler::TranscodeScheduler(int maxJobs, int maxQueue, std::chrono::milliseconds queueTimeout)
+    : maxJobs(maxJobs)
+    , maxQueue(maxQueue)
+    , queueTimeout(queueTimeout)
+    , lastID(0)
+    , waiting(0)
+{
+}
+
+std::shared_ptr<TranscodeJob> TranscodeScheduler::admit(const std::string& profileName, int profileMaxJobs)
+{
+    AutoLockU lock(mutex);
+    auto available = [&]() { return isAvailable(profileName, profileMaxJobs); };
+
+    if (!available()) {
+        if (waiting >= maxQueue)
+            throw TranscodingBusyException("transcoding queue is full, rejecting stream of profile " + profileName);
+
+        log_debug("waiting for a transcoding slot for profile {}", profileName);
+        waiting++;
+        bool admitted = cond.wait_for(lock, queueTimeout, available);
+        waiting--;
+        if (!admitted)
+            throw TranscodingBusyException("no transcoding slot got free for profile " + profileName);
+    }
+
+    auto job = std::make_shared<TranscodeJob>(shared_from_this(), ++lastID, profileName);
+    jobs[job->getID()] = job;
+    profileJobs[profileName]++;
+    log_debug("admitted transcoding job {} for profile {}, {} running", job->getID(), profileName, jobs.size());
+    return job;
+}
+
+bool TranscodeScheduler::canAdmit(const std::string& profileName, int profileMaxJobs)
+{
+    AutoLock lock(mutex);
+    return waiting < maxQueue || isAvailable(profileName, profileMaxJobs);
+}
+
+bool TranscodeScheduler::isAvailable(const std::string& profileName, int profileMaxJobs) const
+{
+    if (maxJobs > 0 && static_cast<int>(jobs.size()) >= maxJobs)
+        return false;
+    auto it = profileJobs.find(profileName);
+    return profileMaxJobs <= 0 || it == profileJobs.end() || it->second < profileMaxJobs;
+}
+
+void TranscodeScheduler::release(int id, const std::string& profileName)
+{
+    {
+        AutoLock lock(mutex);
+        jobs.erase(id);
+        if (--profileJobs[profileName] <= 0)
+            profileJobs.erase(profileName);
+    }
+    cond.notify_all();
+}
+
+int TranscodeScheduler::getQueueDepth()
+{
+    AutoLock lock(mutex);
+    return waiting;
+}
+
+std::vector<std::shared_ptr<TranscodeJob>> TranscodeScheduler::getJobs()
+{
+    AutoLock lock(mutex);
+    std::vector<std::shared_ptr<TranscodeJob>> result;
+    for (const auto& entry : jobs) {
+        auto job = entry.second.lock();
+        if (job != nullptr)
+            result.push_back(job);
+    }
+    return result;
+}
+
+TranscodeJobIOHandler::TranscodeJobIOHandler(std::shared_ptr<TranscodeJob> job, std::unique_ptr<IOHandler> handler)
+    : job(std::move(job))
+    , handler(std::move(handler))
+{
+}
+
+// the transcoder output is open already
+void TranscodeJobIOHandler::open(enum UpnpOpenFileMode mode)
+{
+}
+
+size_t TranscodeJobIOHandler::read(char* buf, size_t length)
+{
+    size_t ret = handler->read(buf, length);
+    if (ret > 0 && ret <= length)
+        job->addBytes(ret);
+    return ret;
+}
+
+void TranscodeJobIOHandler::seek(off_t offset, int whence)
+{
+    handler->seek(offset, whence);
+}
+
+off_t TranscodeJobIOHandler::tell()
+{
+    return handler->tell();
+}
+
+void TranscodeJobIOHandler::close()
+{
+    handler->close();
+    job = nullptr;
+}
@@ -0,0 +1,139 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    transcode_scheduler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file transcode_scheduler.h
+/// \brief Definition of the TranscodeScheduler class.
+#ifndef GERBERA_TRANSCODE_SCHEDULER_H
+#define GERBERA_TRANSCODE_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "iohandler/io_handler.h"
+
+// forward declaration
+class TranscodeScheduler;
+
+/// \brief A running transcoding stream, its slot is freed when the job is destroyed.
+class TranscodeJob {
+public:
+    TranscodeJob(std::shared_ptr<TranscodeScheduler> scheduler, int id, std::string profileName);
+    ~TranscodeJob();
+
+    int getID() const { return id; }
+    std::string getProfileName() const { return profileName; }
+
+    /// \brief Accounts bytes delivered to the client.
+    void addBytes(size_t bytes) { this->bytes += bytes; }
+    off_t getBytes() const { return bytes; }
+
+    /// \brief Time since the job was admitted.
+    std::chrono::milliseconds getElapsed() const;
+
+    /// \brief Average throughput in bytes per second.
+    off_t getThroughput() const;
+
+protected:
+    std::shared_ptr<TranscodeScheduler> scheduler;
+    int id;
+    std::string profileName;
+    std::chrono::steady_clock::time_point started;
+    std::atomic<off_t> bytes;
+};
+
+/// \brief Limits the number of concurrent transcoding streams.
+///
+/// Every stream needs a job before its transcoder is started. If the global
+/// or the profile limit is reached, requests wait in a bounded queue for a
+/// free slot; a request is rejected if the queue is full or no slot got
+/// free within the queue timeout.
+class TranscodeScheduler : public std::enable_shared_from_this<TranscodeScheduler> {
+public:
+    /// \param maxJobs maximum number of concurrent jobs, 0 for no limit
+    /// \param maxQueue maximum number of waiting requests
+    /// \param queueTimeout maximum time a request waits for a slot
+    TranscodeScheduler(int maxJobs, int maxQueue, std::chrono::milliseconds queueTimeout);
+
+    /// \brief Waits for a slot and returns the job occupying it.
+    /// \param profileName transcoding profile of the stream
+    /// \param profileMaxJobs maximum number of concurrent jobs of the profile, 0 for no limit
+    /// \throws TranscodingBusyException if no slot is available
+    std::shared_ptr<TranscodeJob> admit(const std::string& profileName, int profileMaxJobs);
+
+    /// \brief Checks whether admit() would get a slot or could wait for one.
+    bool canAdmit(const std::string& profileName, int profileMaxJobs);
+
+    /// \brief Number of requests waiting for a slot.
+    int getQueueDepth();
+
+    /// \brief Returns the running jobs.
+    std::vector<std::shared_ptr<TranscodeJob>> getJobs();
+
+protected:
+    int maxJobs;
+    int maxQueue;
+    std::chrono::milliseconds queueTimeout;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    using AutoLockU = std::unique_lock<decltype(mutex)>;
+    std::condition_variable cond;
+
+    int lastID;
+    int waiting;
+    std::map<int, std::weak_ptr<TranscodeJob>> jobs;
+    std::map<std::string, int> profileJobs;
+
+    /// \brief Checks for a free slot, mutex must be held.
+    bool isAvailable(const std::string& profileName, int profileMaxJobs) const;
+
+    /// \brief Frees the slot of a finished job.
+    void release(int id, const std::string& profileName);
+
+    friend class TranscodeJob;
+};
+
+/// \brief Keeps the job of a transcoded stream while it is served and counts its bytes.
+class TranscodeJobIOHandler : public IOHandler {
+public:
+    TranscodeJobIOHandler(std::shared_ptr<TranscodeJob> job, std::unique_ptr<IOHandler> handler);
+
+    void open(enum UpnpOpenFileMode mode) override;
+    size_t read(char* buf, size_t length) override;
+    void seek(off_t offset, int whence) override;
+    off_t tell() override;
+    void close() override;
+
+protected:
+    std::shared_ptr<TranscodeJob> job;
+    std::unique_ptr<IOHandler> handler;
+};
+
+#endif // GERBERA_TRANSCODE_SCHEDULER_H
@@ -49,6 +49,8 @@ TranscodingProfile::TranscodingProfile()
     thumbnail = false;
     sample_frequency = SOURCE; // keep original
     number_of_channels = SOURCE;
+    bitrate = 0;
+    max_jobs = 0;
     fourcc_mode = FCC_None;
 }
 
@@ -67,7 +69,8 @@ TranscodingProfile::TranscodingProfile(transcoding_type_t tr_type, std::string n
     buffer_size = 0;
     chunk_size = 0;
     initial_fill_size = 0;
-    tr_type = TR_None;
+    bitrate = 0;
+    max_jobs = 0;
     fourcc_mode = FCC_None;
 }
 
@@ -111,6 +111,25 @@ public:
     /// \brief retrieves the argument string
     std::string getArguments() { return args; }
 
+    /// \brief Identifies if the transcoder can start at a given time.
+    ///
+    /// This is the case if the argument string contains the special %start
+    /// token, which is replaced by the requested start position in seconds.
+    bool isTimeSeekable() { return args.find("%start") != std::string::npos; }
+
+    /// \brief Nominal bitrate of the transcoded stream in bits per second.
+    ///
+    /// If set on a time seekable profile, the stream length is estimated
+    /// from the duration of the source and byte offsets are mapped to
+    /// start times, allowing clients to seek with byte ranges. 0 disables
+    /// the mapping.
+    void setBitrate(int bitrate) { this->bitrate = bitrate; }
+    int getBitrate() { return bitrate; }
+
+    /// \brief Maximum number of concurrent streams of this profile, 0 for no limit.
+    void setMaxJobs(int jobs) { max_jobs = jobs; }
+    int getMaxJobs() { return max_jobs; }
+
     /// \brief identifies if the profile should be set as the first resource
     void setFirstResource(bool fr) { first_resource = fr; }
     bool firstResource() { return first_resource; }
@@ -194,6 +213,8 @@ protected:
     transcoding_type_t tr_type;
     int number_of_channels;
     int sample_frequency;
+    int bitrate;
+    int max_jobs;
     std::map<std::string, std::string> attributes;
     std::vector<std::string> fourcc_list;
     avi_fourcc_listmode_t fourcc_mode;
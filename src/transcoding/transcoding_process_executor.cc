@@ -34,8 +34,8 @@
 
 #include <utility>
 
-TranscodingProcessExecutor::TranscodingProcessExecutor(const std::string& command, const std::vector<std::string>& arglist)
-    : ProcessExecutor(command, arglist) {};
+TranscodingProcessExecutor::TranscodingProcessExecutor(const std::string& command, const std::vector<std::string>& arglist, int niceness, io_class_t ioClass, const std::vector<int>& inheritFds)
+    : ProcessExecutor(command, arglist, niceness, ioClass, inheritFds) {};
 
 void TranscodingProcessExecutor::removeFile(const std::string& filename)
 {
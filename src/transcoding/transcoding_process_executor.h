@@ -37,7 +37,9 @@
 class TranscodingProcessExecutor : public ProcessExecutor {
 public:
     TranscodingProcessExecutor(const std::string& command,
-        const std::vector<std::string>& arglist);
+        const std::vector<std::string>& arglist,
+        int niceness = 0, io_class_t ioClass = IO_CLASS_NONE,
+        const std::vector<int>& inheritFds = std::vector<int>());
     /// \brief This function adds a filename to a list, files in that list
     /// will be removed once the class is destroyed.
     void removeFile(const std::string& filename);
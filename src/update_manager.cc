@@ -35,25 +35,114 @@
 #include "storage/storage.h"
 #include "upnp_cds.h"
 #include "util/tools.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <csignal>
 #include <sys/types.h>
 #include <utility>
 
 /* following constants in milliseconds */
 #define SPEC_INTERVAL 2000
+#define MAX_INTERVAL 10000
+#define SUBSCRIBER_INTERVAL 250
+#define RATE_WINDOW 1000
 #define MIN_SLEEP 1
 
-#define MAX_OBJECT_IDS 1000
+/* following constants in container ids per second */
+#define LOW_CHANGE_RATE 20
+#define HIGH_CHANGE_RATE 200
+#define RATE_WEIGHT 0.5
+
+#define MAX_EVENT_BYTES 16384
+#define AVG_ID_BYTES 12
 #define MAX_OBJECT_IDS_OVERLOAD 30
-#define OBJECT_ID_HASH_CAPACITY 3109
 
 using namespace std;
 
+static long currentMillis()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+UpdateModerator::UpdateModerator(size_t maxEventBytes)
+    : maxEventBytes(maxEventBytes)
+    , subscribers(0)
+    , rate(0)
+    , windowStart(0)
+    , windowCount(0)
+{
+}
+
+void UpdateModerator::updateRate(long now)
+{
+    long windows = (now - windowStart) / RATE_WINDOW;
+    if (windows <= 0)
+        return;
+
+    // close the current window and decay over the ones without changes
+    rate = rate * (1 - RATE_WEIGHT) + RATE_WEIGHT * windowCount * 1000.0 / RATE_WINDOW;
+    if (windows > 1)
+        rate *= pow(1 - RATE_WEIGHT, windows - 1);
+    windowCount = 0;
+    windowStart += windows * RATE_WINDOW;
+}
+
+void UpdateModerator::recordChanges(size_t count, long now)
+{
+    updateRate(now);
+    windowCount += count;
+}
+
+double UpdateModerator::getChangeRate(long now)
+{
+    updateRate(now);
+    // changes of the running window are a lower bound for the current rate
+    return max(rate, windowCount * 1000.0 / RATE_WINDOW);
+}
+
+long UpdateModerator::getFlushInterval(long now)
+{
+    double changeRate = getChangeRate(now);
+
+    long interval = SPEC_INTERVAL;
+    if (changeRate >= HIGH_CHANGE_RATE)
+        interval = MAX_INTERVAL;
+    else if (changeRate > LOW_CHANGE_RATE)
+        interval += static_cast<long>((MAX_INTERVAL - SPEC_INTERVAL) * (changeRate - LOW_CHANGE_RATE) / (HIGH_CHANGE_RATE - LOW_CHANGE_RATE));
+
+    // every event goes out to every subscriber
+    if (subscribers > 1)
+        interval += SUBSCRIBER_INTERVAL * (subscribers - 1);
+
+    return min(interval, static_cast<long>(MAX_INTERVAL));
+}
+
+size_t UpdateModerator::getMaxObjectIDs() const
+{
+    return max(maxEventBytes / AVG_ID_BYTES, static_cast<size_t>(1));
+}
+
+bool UpdateModerator::shouldCollapse(const std::string& updateString, long now)
+{
+    return updateString.length() > maxEventBytes || getChangeRate(now) >= HIGH_CHANGE_RATE;
+}
+
+void UpdateModerator::eventSent(size_t ids, size_t bytes, bool collapsed)
+{
+    stats.eventsSent++;
+    if (collapsed)
+        stats.eventsCollapsed++;
+    stats.idsSent += ids;
+    stats.bytesSent += bytes;
+}
+
 UpdateManager::UpdateManager(std::shared_ptr<Storage> storage, std::shared_ptr<Server> server)
     : storage(std::move(storage))
     , server(std::move(server))
+    , updateThread(0)
     , objectIDHash(make_unique<unordered_set<int>>())
+    , moderator(MAX_EVENT_BYTES)
     , shutdownFlag(false)
     , flushPolicy(FLUSH_SPEC)
     , lastContainerChanged(INVALID_OBJECT_ID)
@@ -108,24 +197,29 @@ void UpdateManager::containersChanged(const std::vector<int>& objectIDs, int flu
         signal = true;
     }
     size_t size = objectIDs.size();
-    int hashSize = objectIDHash->size();
+    size_t hashSize = objectIDHash->size();
+    moderator.recordChanges(size, currentMillis());
+    size_t maxObjectIDs = moderator.getMaxObjectIDs();
 
-    bool split = (hashSize + size >= MAX_OBJECT_IDS + MAX_OBJECT_IDS_OVERLOAD);
+    bool split = (hashSize + size >= maxObjectIDs + MAX_OBJECT_IDS_OVERLOAD);
     for (int objectID : objectIDs) {
         if (objectID != lastContainerChanged) {
             //log_debug("containerChanged. id: {}, signal: {}", objectID, signal);
-            objectIDHash->insert(objectID);
-            if (split && objectIDHash->size() > MAX_OBJECT_IDS) {
-                while (objectIDHash->size() > MAX_OBJECT_IDS) {
+            if (!objectIDHash->insert(objectID).second)
+                moderator.idsCoalesced(1);
+            if (split && objectIDHash->size() > maxObjectIDs) {
+                while (objectIDHash->size() > maxObjectIDs) {
                     log_debug("in-between signalling...");
                     cond.notify_one();
                     lock.unlock();
                     lock.lock();
                 }
             }
+        } else {
+            moderator.idsCoalesced(1);
         }
     }
-    if (objectIDHash->size() >= MAX_OBJECT_IDS)
+    if (objectIDHash->size() >= maxObjectIDs)
         signal = true;
     if (signal) {
         log_debug("signalling...");
@@ -138,15 +232,17 @@ void UpdateManager::containerChanged(int objectID, int flushPolicy)
     if (objectID == INVALID_OBJECT_ID)
         return;
     AutoLock lock(mutex);
+    moderator.recordChanges(1, currentMillis());
     if (objectID != lastContainerChanged || flushPolicy > this->flushPolicy) {
         // signalling thread if it could have been idle, because
         // there were no unprocessed updates
         bool signal = (!haveUpdates());
         log_debug("containerChanged. id: {}, signal: {}", objectID, signal);
-        objectIDHash->insert(objectID);
+        if (!objectIDHash->insert(objectID).second)
+            moderator.idsCoalesced(1);
 
         // signalling if the hash gets too full
-        if (objectIDHash->size() >= MAX_OBJECT_IDS)
+        if (objectIDHash->size() >= moderator.getMaxObjectIDs())
             signal = true;
 
         // very simple caching, but it get's a lot of hits
@@ -164,9 +260,16 @@ void UpdateManager::containerChanged(int objectID, int flushPolicy)
         }
     } else {
         log_debug("last container changed!");
+        moderator.idsCoalesced(1);
     }
 }
 
+UpdateStats UpdateManager::getStats()
+{
+    AutoLock lock(mutex);
+    return moderator.getStats();
+}
+
 /* private stuff */
 
 void UpdateManager::threadProc()
@@ -182,16 +285,17 @@ void UpdateManager::threadProc()
             struct timespec now;
             getTimespecNow(&now);
             long timeDiff = getDeltaMillis(&lastUpdate, &now);
+            moderator.setSubscriberCount(server->getCDSSubscriberCount());
             switch (flushPolicy) {
             case FLUSH_SPEC:
-                sleepMillis = SPEC_INTERVAL - timeDiff;
+                sleepMillis = moderator.getFlushInterval(currentMillis()) - timeDiff;
                 break;
             case FLUSH_ASAP:
                 sleepMillis = 0;
                 break;
             }
             bool sendUpdates = true;
-            if (sleepMillis >= MIN_SLEEP && objectIDHash->size() < MAX_OBJECT_IDS) {
+            if (sleepMillis >= MIN_SLEEP && objectIDHash->size() < moderator.getMaxObjectIDs()) {
                 struct timespec timeout;
                 getTimespecAfterMillis(sleepMillis, &timeout, &now);
                 log_debug("threadProc: sleeping for {} millis", sleepMillis);
@@ -210,6 +314,7 @@ void UpdateManager::threadProc()
                 lastContainerChanged = INVALID_OBJECT_ID;
                 flushPolicy = FLUSH_SPEC;
                 std::string updateString;
+                size_t ids = objectIDHash->size();
 
                 try {
                     updateString = storage->incrementUpdateIDs(objectIDHash);
@@ -219,8 +324,19 @@ void UpdateManager::threadProc()
                     log_error("Forcing Gerbera shutdown.");
                     kill(0, SIGINT);
                 }
+
+                bool collapse = string_ok(updateString) && moderator.shouldCollapse(updateString, currentMillis());
+                if (collapse) {
+                    log_debug("collapsing update of {} containers to SystemUpdateID", ids);
+                    moderator.idsCoalesced(ids);
+                    updateString = "";
+                }
+                bool send = string_ok(updateString) || collapse;
+                if (send)
+                    moderator.eventSent(collapse ? 0 : ids, updateString.length(), collapse);
+
                 lock.unlock(); // we don't need to hold the lock during the sending of the updates
-                if (string_ok(updateString)) {
+                if (send) {
                     try {
                         log_debug("updates sent: \"{}\"", updateString.c_str());
                         server->sendCDSSubscriptionUpdate(updateString);
@@ -34,6 +34,8 @@
 
 #include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -46,6 +48,76 @@
 class Storage;
 class Server;
 
+/// \brief Counters of the ContainerUpdateIDs eventing.
+struct UpdateStats {
+    /// \brief number of events sent to the subscribers
+    unsigned long eventsSent = 0;
+    /// \brief number of events that only carried the SystemUpdateID
+    unsigned long eventsCollapsed = 0;
+    /// \brief number of container ids listed in sent events
+    unsigned long idsSent = 0;
+    /// \brief number of container changes merged into an already pending change
+    unsigned long idsCoalesced = 0;
+    /// \brief total size of the ContainerUpdateIDs values that were sent
+    unsigned long bytesSent = 0;
+};
+
+/// \brief Adaptive moderation policy for ContainerUpdateIDs events.
+///
+/// Keeps track of the container change rate and the number of subscribers
+/// and derives from it how long changes are collected before an event is
+/// sent. The interval never drops below the moderation rate required by
+/// the CDS spec. When changes come in faster than the subscribers can
+/// reasonably follow, or when the value would exceed the size cap, the
+/// event is collapsed to the SystemUpdateID only, which tells the control
+/// points to refresh whatever they are showing.
+///
+/// All times are milliseconds of a monotonic clock, passed in by the caller.
+class UpdateModerator {
+public:
+    explicit UpdateModerator(size_t maxEventBytes);
+
+    /// \brief Accounts count container changes that happened at time now.
+    void recordChanges(size_t count, long now);
+
+    /// \brief Sets the number of control points subscribed to the CDS.
+    void setSubscriberCount(int subscribers) { this->subscribers = subscribers; }
+
+    /// \brief Returns the current change rate in container ids per second.
+    double getChangeRate(long now);
+
+    /// \brief Returns the time that has to pass between two events.
+    long getFlushInterval(long now);
+
+    /// \brief Returns the number of pending container ids that forces an event.
+    size_t getMaxObjectIDs() const;
+
+    /// \brief Returns true if the event should only carry the SystemUpdateID.
+    /// \param updateString the ContainerUpdateIDs value that would be sent
+    bool shouldCollapse(const std::string& updateString, long now);
+
+    /// \brief Accounts an event that was sent.
+    void eventSent(size_t ids, size_t bytes, bool collapsed);
+
+    /// \brief Accounts container changes that were merged into pending ones.
+    void idsCoalesced(size_t count) { stats.idsCoalesced += count; }
+
+    const UpdateStats& getStats() const { return stats; }
+
+protected:
+    size_t maxEventBytes;
+    int subscribers;
+
+    /// \brief exponentially weighted change rate, ids per second
+    double rate;
+    long windowStart;
+    size_t windowCount;
+
+    UpdateStats stats;
+
+    void updateRate(long now);
+};
+
 class UpdateManager {
 public:
     UpdateManager(std::shared_ptr<Storage> storage, std::shared_ptr<Server> server);
@@ -56,6 +128,9 @@ public:
     void containerChanged(int objectID, int flushPolicy = FLUSH_SPEC);
     void containersChanged(const std::vector<int>& objectIDs, int flushPolicy = FLUSH_SPEC);
 
+    /// \brief Returns a snapshot of the eventing counters.
+    UpdateStats getStats();
+
 protected:
     std::shared_ptr<Storage> storage;
     std::shared_ptr<Server> server;
@@ -68,6 +143,7 @@ protected:
     using AutoLockU = std::unique_lock<decltype(mutex)>;
 
     std::unique_ptr<std::unordered_set<int>> objectIDHash;
+    UpdateModerator moderator;
 
     bool shutdownFlag;
     int flushPolicy;
@@ -34,11 +34,15 @@
 #include "search_handler.h"
 #include "server.h"
 #include "storage/storage.h"
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+/// \brief Longest subscription lease granted to control points, in seconds.
+#define SUBSCRIPTION_TIMEOUT 1800
+
 ContentDirectoryService::ContentDirectoryService(std::shared_ptr<ConfigManager> config,
     std::shared_ptr<Storage> storage,
     UpnpXMLBuilder* xmlBuilder, UpnpDevice_Handle deviceHandle, int stringLimit)
@@ -48,7 +52,14 @@ ContentDirectoryService::ContentDirectoryService(std::shared_ptr<ConfigManager>
     , storage(std::move(storage))
     , deviceHandle(deviceHandle)
     , xmlBuilder(xmlBuilder)
+    , rootUpdateID(-1)
 {
+    serverUDN = this->config->getOption(CFG_SERVER_UDN);
+
+    // the SDK grants the requested lease up to this limit and renews it
+    // without telling us, so the limit is the lease a subscription is
+    // counted with
+    UpnpSetMaxSubscriptionTimeOut(deviceHandle, SUBSCRIPTION_TIMEOUT);
 }
 
 ContentDirectoryService::~ContentDirectoryService() = default;
@@ -270,58 +281,105 @@ void ContentDirectoryService::processSubscriptionRequest(const std::unique_ptr<S
 {
     log_debug("start");
 
-    auto propset = UpnpXMLBuilder::createEventPropertySet();
-    auto property = propset->document_element().first_child();
-    property.append_child("SystemUpdateID").append_child(pugi::node_pcdata).set_value(std::to_string(systemUpdateID).c_str());
-    auto obj = storage->loadObject(0);
-    auto cont = std::static_pointer_cast<CdsContainer>(obj);
-    property.append_child("ContainerUpdateIDs").append_child(pugi::node_pcdata).set_value(fmt::format("0,{}", +cont->getUpdateID()).c_str());
+    int updateID = rootUpdateID;
+    if (updateID < 0) {
+        auto obj = storage->loadObject(0);
+        int loaded = std::static_pointer_cast<CdsContainer>(obj)->getUpdateID();
+        // a container change may have set a newer value in the meantime
+        if (rootUpdateID.compare_exchange_strong(updateID, loaded))
+            updateID = loaded;
+    }
+
+    std::string systemUpdateIDValue = std::to_string(systemUpdateID);
+    std::string containerUpdateIDs = fmt::format("0,{}", updateID);
 
-    std::ostringstream buf;
-    propset->print(buf, "", 0);
-    std::string xml = buf.str();
+    const char* names[] = { "SystemUpdateID", "ContainerUpdateIDs" };
+    const char* values[] = { systemUpdateIDValue.c_str(), containerUpdateIDs.c_str() };
 
-    IXML_Document* event = nullptr;
-    int err = ixmlParseBufferEx(xml.c_str(), &event);
-    if (err != IXML_SUCCESS) {
-        throw UpnpException(UPNP_E_SUBSCRIPTION_FAILED, "Could not convert property set to ixml");
+    int err = UpnpAcceptSubscription(deviceHandle, serverUDN.c_str(),
+        DESC_CDS_SERVICE_ID, names, values, 2, request->getSubscriptionID().c_str());
+    if (err != UPNP_E_SUCCESS) {
+        removeSubscription(request->getSubscriptionID());
+        throw UpnpException(UPNP_E_SUBSCRIPTION_FAILED, fmt::format("Could not accept subscription: {}", err));
     }
 
-    UpnpAcceptSubscriptionExt(deviceHandle,
-        config->getOption(CFG_SERVER_UDN).c_str(),
-        DESC_CDS_SERVICE_ID, event, request->getSubscriptionID().c_str());
-
-    ixmlDocument_free(event);
+    addSubscription(request->getSubscriptionID(), SUBSCRIPTION_TIMEOUT);
     log_debug("end");
 }
 
+void ContentDirectoryService::addSubscription(const std::string& sid, int timeout)
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    time_t now = time(nullptr);
+    for (auto it = subscriptions.begin(); it != subscriptions.end();) {
+        if (it->second <= now)
+            it = subscriptions.erase(it);
+        else
+            ++it;
+    }
+    subscriptions[sid] = now + timeout;
+}
+
+void ContentDirectoryService::removeSubscription(const std::string& sid)
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    subscriptions.erase(sid);
+}
+
 void ContentDirectoryService::sendSubscriptionUpdate(const std::string& containerUpdateIDs_CSV)
 {
     log_debug("start");
 
     systemUpdateID++;
+    updateRootUpdateID(containerUpdateIDs_CSV);
 
-    auto propset = UpnpXMLBuilder::createEventPropertySet();
-    auto property = propset->document_element().first_child();
-    property.append_child("ContainerUpdateIDs").append_child(pugi::node_pcdata).set_value(containerUpdateIDs_CSV.c_str());
-    property.append_child("SystemUpdateID").append_child(pugi::node_pcdata).set_value(std::to_string(systemUpdateID).c_str());
+    std::string systemUpdateIDValue = std::to_string(systemUpdateID);
 
-    std::ostringstream buf;
-    propset->print(buf, "", 0);
-    std::string xml = buf.str();
+    // an empty list only announces the SystemUpdateID
+    const char* names[] = { "SystemUpdateID", "ContainerUpdateIDs" };
+    const char* values[] = { systemUpdateIDValue.c_str(), containerUpdateIDs_CSV.c_str() };
+    int count = containerUpdateIDs_CSV.empty() ? 1 : 2;
 
-    IXML_Document* event = nullptr;
-    int err = ixmlParseBufferEx(xml.c_str(), &event);
-    if (err != IXML_SUCCESS) {
+    int err = UpnpNotify(deviceHandle, serverUDN.c_str(), DESC_CDS_SERVICE_ID, names, values, count);
+    if (err != UPNP_E_SUCCESS) {
         /// \todo add another error code
-        throw UpnpException(UPNP_E_SUBSCRIPTION_FAILED, "Could not convert property set to ixml");
+        throw UpnpException(UPNP_E_SUBSCRIPTION_FAILED, fmt::format("Could not send subscription update: {}", err));
     }
 
-    UpnpNotifyExt(deviceHandle,
-        config->getOption(CFG_SERVER_UDN).c_str(),
-        DESC_CDS_SERVICE_ID, event);
+    log_debug("end");
+}
+
+void ContentDirectoryService::updateRootUpdateID(const std::string& containerUpdateIDs_CSV)
+{
+    if (containerUpdateIDs_CSV.empty()) {
+        // root container may have changed without being listed
+        rootUpdateID = -1;
+        return;
+    }
 
-    ixmlDocument_free(event);
+    // the list holds pairs of container id and update id
+    const char* pos = containerUpdateIDs_CSV.c_str();
+    while (*pos) {
+        char* end;
+        long id = strtol(pos, &end, 10);
+        if (*end != ',')
+            break;
+        pos = end + 1;
+        long updateID = strtol(pos, &end, 10);
+        if (id == 0) {
+            rootUpdateID = static_cast<int>(updateID);
+            return;
+        }
+        if (*end != ',')
+            break;
+        pos = end + 1;
+    }
+}
 
-    log_debug("end");
+int ContentDirectoryService::getSubscriberCount() const
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    time_t now = time(nullptr);
+    return std::count_if(subscriptions.begin(), subscriptions.end(),
+        [=](const auto& subscription) { return subscription.second > now; });
 }
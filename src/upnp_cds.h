@@ -32,7 +32,10 @@
 #ifndef __UPNP_CDS_H__
 #define __UPNP_CDS_H__
 
+#include <map>
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include "action_request.h"
 #include "common.h"
@@ -100,6 +103,20 @@ protected:
 
     UpnpDevice_Handle deviceHandle;
     UpnpXMLBuilder* xmlBuilder;
+    std::string serverUDN;
+
+    /// \brief Update ID of the root container, -1 if it has to be loaded.
+    ///
+    /// Every new subscription gets the root update ID in its initial event,
+    /// it is taken from the ContainerUpdateIDs that are sent out.
+    std::atomic<int> rootUpdateID;
+
+    /// \brief Subscription IDs accepted by the service and when their lease ends.
+    std::map<std::string, time_t> subscriptions;
+    mutable std::mutex subscriptionMutex;
+
+    /// \brief Picks the root update ID from a ContainerUpdateIDs list.
+    void updateRootUpdateID(const std::string& containerUpdateIDs_CSV);
 
 public:
     /// \brief Constructor for the CDS, saves the service type and service id
@@ -129,7 +146,22 @@ public:
     /// When something in the content directory chagnes, we will send out
     /// an event to all subscribed devices. Container updates are supported,
     /// and of course the mimimum required - systemUpdateID.
+    /// An empty list only announces the new systemUpdateID, telling the
+    /// control points to refresh everything they display.
     void sendSubscriptionUpdate(const std::string& containerUpdateIDs_CSV);
+
+    /// \brief Counts a subscription until its lease ends.
+    /// \param sid Subscription ID.
+    /// \param timeout Lease granted to the control point in seconds.
+    ///
+    /// A known subscription ID is renewed, its lease starts again.
+    void addSubscription(const std::string& sid, int timeout);
+
+    /// \brief Stops counting a subscription that was cancelled.
+    void removeSubscription(const std::string& sid);
+
+    /// \brief Returns the number of subscriptions whose lease has not ended.
+    int getSubscriberCount() const;
 };
 
 #endif // __UPNP_CDS_H__
@@ -34,6 +34,7 @@
 #include "common.h"
 #include "config/config_manager.h"
 #include "metadata/metadata_handler.h"
+#include "metadata/sidecar_handler.h"
 #include "server.h"
 #include "storage/storage.h"
 #include <utility>
@@ -413,20 +414,18 @@ void UpnpXMLBuilder::renderResource(const std::string& URL, const std::map<std::
     }
 }
 
-void UpnpXMLBuilder::renderCaptionInfo(const std::string& URL, pugi::xml_node* parent)
+void UpnpXMLBuilder::renderCaptionInfo(const std::string& URL, const std::string& ext, pugi::xml_node* parent)
 {
     auto cap = parent->append_child("sec:CaptionInfoEx");
 
     // Samsung DLNA clients don't follow this URL and
     // obtain subtitle location from video HTTP headers.
-    // We don't need to know here what the subtitle type
-    // is and even if there is a subtitle.
     // This tag seems to be only a hint for Samsung devices,
     // though it's necessary.
 
     size_t endp = URL.rfind('.');
-    cap.append_child(pugi::node_pcdata).set_value((URL.substr(0, endp) + ".srt").c_str());
-    cap.append_attribute("sec:type") = "srt";
+    cap.append_child(pugi::node_pcdata).set_value((URL.substr(0, endp) + ext).c_str());
+    cap.append_attribute("sec:type") = ext.substr(1).c_str();
 }
 
 void UpnpXMLBuilder::renderCreator(const std::string& creator, pugi::xml_node* parent)
@@ -805,6 +804,10 @@ void UpnpXMLBuilder::addResources(const std::shared_ptr<CdsItem>& item, pugi::xm
                     continue;
                 }
             }
+
+            // sidecar files are served by their own URL, they are not media
+            if (handlerType == CH_SIDECAR)
+                continue;
         }
 
         if (!isExtThumbnail) {
@@ -827,9 +830,9 @@ void UpnpXMLBuilder::addResources(const std::shared_ptr<CdsItem>& item, pugi::xm
                 int y;
                 if (string_ok(resolution) && check_resolution(resolution, &x, &y)) {
 
-                    if ((i > 0) && (((item->getResource(i)->getHandlerType() == CH_LIBEXIF) && (item->getResource(i)->getParameter(RESOURCE_CONTENT_TYPE) == EXIF_THUMBNAIL)) || (item->getResource(i)->getOption(RESOURCE_CONTENT_TYPE) == EXIF_THUMBNAIL) || (item->getResource(i)->getOption(RESOURCE_CONTENT_TYPE) == THUMBNAIL)) && (x <= 160) && (y <= 160))
+                    if ((i > 0) && (((item->getResource(i)->getHandlerType() == CH_LIBEXIF) && (item->getResource(i)->getParameter(RESOURCE_CONTENT_TYPE) == EXIF_THUMBNAIL)) || (item->getResource(i)->getOption(RESOURCE_CONTENT_TYPE) == EXIF_THUMBNAIL) || (item->getResource(i)->getOption(RESOURCE_CONTENT_TYPE) == THUMBNAIL) || (item->getResource(i)->getHandlerType() == CH_IMAGE_SCALE)) && (x <= 160) && (y <= 160))
                         extend = std::string(D_PROFILE) + "=" + D_JPEG_TN + ";";
-                    else if ((x <= 640) && (y <= 420))
+                    else if ((x <= 640) && (y <= 480))
                         extend = std::string(D_PROFILE) + "=" + D_JPEG_SM + ";";
                     else if ((x <= 1024) && (y <= 768))
                         extend = std::string(D_PROFILE) + "=" + D_JPEG_MED + ";";
@@ -843,10 +846,16 @@ void UpnpXMLBuilder::addResources(const std::shared_ptr<CdsItem>& item, pugi::xm
                     extend.append(";");
             }
 
-            // we do not support seeking at all, so 00
-            // and the media is converted, so set CI to 1
+            // transcoded media can be seeked by time if the profile can start
+            // the transcoder at an offset, by bytes if its bitrate is known;
+            // the media is converted, so set CI to 1
             if (!isExtThumbnail && transcoded) {
-                extend.append(D_OP).append("=").append(D_OP_SEEK_DISABLED).append(";").append(D_CONVERSION_INDICATOR).append("=" D_CONVERSION);
+                auto tp = config->getTranscodingProfileListOption(CFG_TRANSCODING_PROFILE_LIST)
+                              ->getByName(getValueOrDefault(res_params, URL_PARAM_TRANSCODE_PROFILE_NAME));
+                std::string op = D_OP_SEEK_DISABLED;
+                if (tp != nullptr && tp->isTimeSeekable())
+                    op = (tp->getBitrate() > 0) ? D_OP_SEEK_BOTH : D_OP_SEEK_TIME;
+                extend.append(D_OP).append("=").append(op).append(";").append(D_CONVERSION_INDICATOR).append("=" D_CONVERSION);
 
                 if (startswith(mimeType, "audio") || startswith(mimeType, "video"))
                     extend.append(";" D_FLAGS "=" D_TR_FLAGS_AV);
@@ -862,8 +871,9 @@ void UpnpXMLBuilder::addResources(const std::shared_ptr<CdsItem>& item, pugi::xm
             res_attrs[MetadataHandler::getResAttrName(R_PROTOCOLINFO)] = protocolInfo;
 
             if (config->getBoolOption(CFG_SERVER_EXTEND_PROTOCOLINFO_SM_HACK)) {
-                if (startswith(mimeType, "video")) {
-                    renderCaptionInfo(url, parent);
+                fs::path subtitlePath = startswith(mimeType, "video") ? SidecarHandler::getSubtitlePath(item) : "";
+                if (!subtitlePath.empty()) {
+                    renderCaptionInfo(url, subtitlePath.extension().string(), parent);
                 }
             }
 
@@ -90,7 +90,8 @@ public:
 
     /// \brief Renders a subtitle resource tag (Samsung proprietary extension)
     /// \param URL download location of the video item
-    static void renderCaptionInfo(const std::string& URL, pugi::xml_node* parent);
+    /// \param ext extension of the subtitle file, i.e. ".srt"
+    static void renderCaptionInfo(const std::string& URL, const std::string& ext, pugi::xml_node* parent);
 
     static void renderCreator(const std::string& creator, pugi::xml_node* parent);
     static void renderAlbumArtURI(const std::string& uri, pugi::xml_node* parent);
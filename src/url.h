@@ -71,7 +71,8 @@ public:
     ///
     /// This function uses an already initialized curl_handle, the reason
     /// is, that curl might keep the connection open if we do subsequent
-    /// requests to the same server.
+    /// requests to the same server. Handles from CurlHandlePool keep the
+    /// connection across callers.
     ///
     /// \param curl_handle an initialized and ready to use curl handle
     /// \param URL
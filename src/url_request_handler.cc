@@ -124,7 +124,8 @@ void URLRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
 
         log_debug("Online content url: {}", url.c_str());
         try {
-            auto st = URL::getInfo(url);
+            auto curl_handle = content->getCurlPool()->acquire();
+            auto st = URL::getInfo(url, curl_handle.get());
             UpnpFileInfo_set_FileLength(info, st->getSize());
             header = "Accept-Ranges: bytes";
             log_debug("URL used for request: {}", st->getURL().c_str());
@@ -218,12 +219,12 @@ std::unique_ptr<IOHandler> URLRequestHandler::open(const char* filename,
             throw std::runtime_error("Transcoding of file " + url + " but no profile matching the name " + tr_profile + " found");
 
         auto tr_d = std::make_unique<TranscodeDispatcher>(config, content);
-        return tr_d->open(tp, url, item, range);
+        return tr_d->open(tp, url, item, range, 0);
     }
 
-    auto u = std::make_unique<URL>();
     try {
-        auto st = u->getInfo(url);
+        auto curl_handle = content->getCurlPool()->acquire();
+        auto st = URL::getInfo(url, curl_handle.get());
         // info->file_length = st->getSize();
         header = "Accept-Ranges: bytes";
         log_debug("URL used for request: {}", st->getURL().c_str());
@@ -240,7 +241,8 @@ std::unique_ptr<IOHandler> URLRequestHandler::open(const char* filename,
     */
 
     ///\todo make curl io handler configurable for url request handler
-    auto io_handler = std::make_unique<CurlIOHandler>(url, nullptr, 1024 * 1024, 0);
+    auto io_handler = std::make_unique<CurlIOHandler>(url, nullptr, 1024 * 1024, 0,
+        content->getStreamReactor(), content->getCurlPool());
     io_handler->open(mode);
     content->triggerPlayHook(obj);
     return io_handler;
@@ -0,0 +1,159 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    bandwidth_shaper.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file bandwidth_shaper.cc
+
+#include "bandwidth_shaper.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std::chrono;
+
+BandwidthShaper::BandwidthShaper(size_t totalRate, size_t clientRate, size_t burst)
+    : totalRate(totalRate)
+    , clientRate(clientRate)
+    , burst(burst)
+    , total { static_cast<double>(totalRate), static_cast<double>(burst), static_cast<double>(burst), steady_clock::now() }
+    , lastStreamID(0)
+{
+}
+
+std::shared_ptr<BandwidthShaper::Stream> BandwidthShaper::addStream(const std::string& client, const std::string& name)
+{
+    auto now = steady_clock::now();
+    auto stream = std::make_shared<Stream>();
+    stream->stats.client = client;
+    stream->stats.name = name;
+    stream->stats.started = now;
+    stream->stats.bytes = 0;
+    stream->stats.rate = 0;
+    stream->windowStart = now;
+    stream->windowBytes = 0;
+
+    AutoLock lock(mutex);
+    stream->stats.id = ++lastStreamID;
+    if (clientRate > 0) {
+        auto& entry = clients[client];
+        stream->clientBucket = entry.lock();
+        if (stream->clientBucket == nullptr) {
+            stream->clientBucket = std::make_shared<Bucket>(Bucket { static_cast<double>(clientRate), static_cast<double>(burst), static_cast<double>(burst), now });
+            entry = stream->clientBucket;
+        }
+    }
+    streams.push_back(stream);
+    return stream;
+}
+
+void BandwidthShaper::removeStream(const std::shared_ptr<Stream>& stream)
+{
+    AutoLock lock(mutex);
+    streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+    stream->clientBucket = nullptr;
+
+    auto it = clients.find(stream->stats.client);
+    if (it != clients.end() && it->second.expired())
+        clients.erase(it);
+}
+
+size_t BandwidthShaper::getQuantum(size_t length) const
+{
+    size_t rate = (totalRate > 0 && clientRate > 0) ? std::min(totalRate, clientRate) : std::max(totalRate, clientRate);
+    if (rate == 0)
+        return length;
+
+    // a quantum takes at most 100ms, so waits stay short and turns fine grained
+    size_t quantum = std::clamp(rate / 10, size_t(1024), MAX_QUANTUM);
+    return std::min(length, quantum);
+}
+
+void BandwidthShaper::consume(Stream& stream, size_t length)
+{
+    auto now = steady_clock::now();
+    auto until = now;
+
+    // do not hold tokens of the total bucket while waiting for the client's
+    if (stream.clientBucket != nullptr) {
+        {
+            AutoLock lock(mutex);
+            until = stream.clientBucket->take(length, now);
+        }
+        if (until > now) {
+            std::this_thread::sleep_until(until);
+            now = steady_clock::now();
+        }
+    }
+
+    {
+        AutoLock lock(mutex);
+        if (totalRate > 0)
+            until = total.take(length, now);
+        account(stream, length, now);
+    }
+    if (until > now)
+        std::this_thread::sleep_until(until);
+}
+
+void BandwidthShaper::account(Stream& stream, size_t length, steady_clock::time_point now)
+{
+    stream.stats.bytes += length;
+    stream.windowBytes += length;
+
+    duration<double> elapsed = now - stream.windowStart;
+    if (elapsed >= RATE_WINDOW) {
+        stream.stats.rate = stream.windowBytes / elapsed.count();
+        stream.windowStart = now;
+        stream.windowBytes = 0;
+    }
+}
+
+std::vector<BandwidthShaper::StreamStats> BandwidthShaper::getStreamStats()
+{
+    auto now = steady_clock::now();
+    std::vector<StreamStats> result;
+
+    AutoLock lock(mutex);
+    result.reserve(streams.size());
+    for (const auto& stream : streams) {
+        result.push_back(stream->stats);
+        // a stalled stream does not update its rate
+        duration<double> elapsed = now - stream->windowStart;
+        if (elapsed >= 2 * RATE_WINDOW)
+            result.back().rate = stream->windowBytes / elapsed.count();
+    }
+    return result;
+}
+
+steady_clock::time_point BandwidthShaper::Bucket::take(size_t length, steady_clock::time_point now)
+{
+    if (now > last) {
+        tokens = std::min(burst, tokens + duration<double>(now - last).count() * rate);
+        last = now;
+    }
+    tokens -= length;
+    if (tokens >= 0)
+        return now;
+
+    // waiting streams line up behind each other's debt
+    return now + duration_cast<steady_clock::duration>(duration<double>(-tokens / rate));
+}
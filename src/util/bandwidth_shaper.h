@@ -0,0 +1,122 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    bandwidth_shaper.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file bandwidth_shaper.h
+/// \brief Definition of the BandwidthShaper class.
+#ifndef GERBERA_BANDWIDTH_SHAPER_H
+#define GERBERA_BANDWIDTH_SHAPER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// \brief Token bucket shaper for the media streams sent to clients.
+///
+/// A stream draws tokens from the bucket of its client address and then from
+/// the bucket shared by all clients. Tokens are handed out in the order they
+/// are asked for and every read asks for a small quantum only, so streams
+/// waiting for the same bucket take turns and get an even share of its rate.
+/// A stream needing less than its share leaves the rest to the others.
+class BandwidthShaper {
+public:
+    /// \brief Transfer statistics of a stream.
+    struct StreamStats {
+        int id;
+        std::string client;
+        std::string name;
+        std::chrono::steady_clock::time_point started;
+        off_t bytes;
+        /// \brief bytes per second during the last measuring window
+        double rate;
+    };
+
+    struct Bucket;
+
+    /// \brief Registered stream, the members are protected by the shaper.
+    struct Stream {
+        StreamStats stats;
+        std::shared_ptr<Bucket> clientBucket;
+        std::chrono::steady_clock::time_point windowStart;
+        off_t windowBytes;
+    };
+
+    /// \param totalRate bytes per second for all streams, 0 for no limit
+    /// \param clientRate bytes per second for each client address, 0 for no limit
+    /// \param burst bytes a stream may send at once after being idle
+    BandwidthShaper(size_t totalRate, size_t clientRate, size_t burst);
+
+    /// \brief Registers a stream sent to client.
+    std::shared_ptr<Stream> addStream(const std::string& client, const std::string& name);
+
+    /// \brief Unregisters a stream, the bucket of its client is dropped with the last stream.
+    void removeStream(const std::shared_ptr<Stream>& stream);
+
+    /// \brief Returns the number of bytes a read of up to length bytes should ask for.
+    size_t getQuantum(size_t length) const;
+
+    /// \brief Waits until length bytes may be sent on the stream and accounts them.
+    void consume(Stream& stream, size_t length);
+
+    /// \brief Returns the statistics of all registered streams.
+    std::vector<StreamStats> getStreamStats();
+
+    size_t getTotalRate() const { return totalRate; }
+    size_t getClientRate() const { return clientRate; }
+
+    struct Bucket {
+        double rate;
+        double burst;
+        double tokens;
+        std::chrono::steady_clock::time_point last;
+
+        /// \brief Takes length tokens, possibly running into debt.
+        /// \return the time at which the debt is paid off
+        std::chrono::steady_clock::time_point take(size_t length, std::chrono::steady_clock::time_point now);
+    };
+
+protected:
+    /// \brief streams do not read more than this at once
+    static constexpr size_t MAX_QUANTUM = 64 * 1024;
+    /// \brief rates are measured over windows of this length
+    static constexpr std::chrono::seconds RATE_WINDOW = std::chrono::seconds(2);
+
+    size_t totalRate;
+    size_t clientRate;
+    size_t burst;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    Bucket total;
+    /// \brief buckets of the clients with open streams
+    std::map<std::string, std::weak_ptr<Bucket>> clients;
+    std::vector<std::shared_ptr<Stream>> streams;
+    int lastStreamID;
+
+    void account(Stream& stream, size_t length, std::chrono::steady_clock::time_point now);
+};
+
+#endif // GERBERA_BANDWIDTH_SHAPER_H
@@ -0,0 +1,106 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    curl_handle_pool.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file curl_handle_pool.cc
+
+#ifdef HAVE_CURL
+
+#include "curl_handle_pool.h"
+
+#include <stdexcept>
+
+CurlHandlePool::CurlHandlePool(size_t maxIdle)
+    : maxIdle(maxIdle)
+    , reuseCount(0)
+{
+    share = curl_share_init();
+    if (share == nullptr)
+        throw std::runtime_error("failed to init curl share handle");
+
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, CurlHandlePool::lockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, CurlHandlePool::unlockShare);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+CurlHandlePool::~CurlHandlePool()
+{
+    // all handles using the share are back, Handle keeps the pool alive
+    for (auto handle : idle)
+        curl_easy_cleanup(handle);
+    curl_share_cleanup(share);
+}
+
+CurlHandlePool::Handle CurlHandlePool::acquire()
+{
+    CURL* handle = nullptr;
+    {
+        AutoLock lock(mutex);
+        if (!idle.empty()) {
+            handle = idle.back();
+            idle.pop_back();
+            reuseCount++;
+        }
+    }
+
+    if (handle == nullptr) {
+        handle = curl_easy_init();
+        if (handle == nullptr)
+            throw std::runtime_error("failed to init curl");
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    }
+
+    return Handle(handle, Release { shared_from_this() });
+}
+
+void CurlHandlePool::release(CURL* handle)
+{
+    if (handle == nullptr)
+        return;
+
+    curl_easy_reset(handle);
+
+    {
+        AutoLock lock(mutex);
+        if (idle.size() < maxIdle) {
+            idle.push_back(handle);
+            return;
+        }
+    }
+    curl_easy_cleanup(handle);
+}
+
+void CurlHandlePool::lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr)
+{
+    auto pool = static_cast<CurlHandlePool*>(userptr);
+    pool->shareMutexes.at(data).lock();
+}
+
+void CurlHandlePool::unlockShare(CURL* handle, curl_lock_data data, void* userptr)
+{
+    auto pool = static_cast<CurlHandlePool*>(userptr);
+    pool->shareMutexes.at(data).unlock();
+}
+
+#endif // HAVE_CURL
@@ -0,0 +1,93 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    curl_handle_pool.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file curl_handle_pool.h
+/// \brief Definition of the CurlHandlePool class.
+
+#ifdef HAVE_CURL
+
+#ifndef GERBERA_CURL_HANDLE_POOL_H
+#define GERBERA_CURL_HANDLE_POOL_H
+
+#include <array>
+#include <atomic>
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// \brief Reusable curl easy handles.
+///
+/// A handle keeps its open connections when it is given back, so the next
+/// request to the same server skips the TCP and TLS handshakes. All handles
+/// use one share handle for the DNS and TLS session caches, a handle that
+/// has to connect still finds the name lookups and sessions of the others.
+/// Connections themselves are not shared, libcurl does not support using
+/// them from several threads at once.
+class CurlHandlePool : public std::enable_shared_from_this<CurlHandlePool> {
+protected:
+    struct Release {
+        std::shared_ptr<CurlHandlePool> pool;
+        void operator()(CURL* handle) const { pool->release(handle); }
+    };
+
+public:
+    /// \brief Easy handle that goes back to the pool when destroyed.
+    using Handle = std::unique_ptr<CURL, Release>;
+
+    /// \param maxIdle number of handles kept for reuse, further handles
+    /// are cleaned up when they are given back
+    explicit CurlHandlePool(size_t maxIdle = 8);
+    ~CurlHandlePool();
+
+    CurlHandlePool(const CurlHandlePool&) = delete;
+    CurlHandlePool& operator=(const CurlHandlePool&) = delete;
+
+    /// \brief Returns an idle handle or a new one, ready to be configured.
+    Handle acquire();
+
+    /// \brief Number of handles that were served from the pool.
+    size_t getReuseCount() const { return reuseCount; }
+
+protected:
+    /// \brief Resets the options of a handle and keeps it for reuse.
+    ///
+    /// Resetting keeps both the connections and the share handle.
+    void release(CURL* handle);
+
+    static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+    static void unlockShare(CURL* handle, curl_lock_data data, void* userptr);
+
+    size_t maxIdle;
+    CURLSH* share;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> shareMutexes;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    std::vector<CURL*> idle;
+    std::atomic<size_t> reuseCount;
+};
+
+#endif // GERBERA_CURL_HANDLE_POOL_H
+
+#endif // HAVE_CURL
@@ -12,7 +12,8 @@ enum task_type_t {
     RemoveObject,
     LoadAccounting,
     RescanDirectory,
-    FetchOnlineContent
+    FetchOnlineContent,
+    GenerateResources
 };
 
 enum task_owner_t {
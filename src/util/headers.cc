@@ -26,6 +26,8 @@ Gerbera - https://gerbera.io/
 #include "headers.h"
 #include <string>
 
+#include "tools.h"
+
 std::string Headers::stripInvalid(const std::string& value)
 {
     std::string result = value;
@@ -103,3 +105,19 @@ void Headers::writeHeaders(UpnpFileInfo* fileInfo) const
     UpnpFileInfo_set_ExtraHeaders(fileInfo, ixmlCloneDOMString(result.c_str()));
 #endif
 }
+
+std::map<std::string, std::string> Headers::readHeaders(UpnpFileInfo* fileInfo)
+{
+    std::map<std::string, std::string> result;
+#ifdef UPNP_1_12_LIST
+    auto head = const_cast<UpnpListHead*>(UpnpFileInfo_get_ExtraHeadersList(fileInfo));
+    for (auto pos = UpnpListBegin(head); pos != UpnpListEnd(head); pos = UpnpListNext(head, pos)) {
+        auto extra = reinterpret_cast<UpnpExtraHeaders*>(pos);
+        const char* name = UpnpExtraHeaders_get_name_cstr(extra);
+        const char* value = UpnpExtraHeaders_get_value_cstr(extra);
+        if (name != nullptr && value != nullptr)
+            result[tolower_string(name)] = value;
+    }
+#endif
+    return result;
+}
@@ -38,6 +38,13 @@ public:
     void addHeader(const std::string& header, const std::string& value);
     void writeHeaders(UpnpFileInfo* fileInfo) const;
 
+    /// \brief Returns the request headers passed along by the web server.
+    ///
+    /// Header names are converted to lower case. Only libupnp with the
+    /// extra headers list hands the request headers to the callbacks,
+    /// otherwise the result is empty.
+    static std::map<std::string, std::string> readHeaders(UpnpFileInfo* fileInfo);
+
 private:
     std::unique_ptr<std::vector<std::pair<std::string, std::string>>> headers;
     static std::string formatHeader(const std::pair<std::string, std::string>& header, bool crlf);
@@ -0,0 +1,111 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    lock_free_queue.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file lock_free_queue.h
+/// \brief Definition of the LockFreeQueue class.
+#ifndef GERBERA_LOCK_FREE_QUEUE_H
+#define GERBERA_LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+/// \brief Bounded queue for any number of producers and consumers.
+///
+/// Each slot carries a sequence number telling whether it is free for the
+/// producer of a given position or filled for its consumer, so push() and
+/// pop() only race on their position counter (Dmitry Vyukov's design).
+template <typename T>
+class LockFreeQueue {
+public:
+    /// \param capacity number of slots, has to be a power of two
+    explicit LockFreeQueue(size_t capacity)
+        : slots(new Slot[capacity])
+        , mask(capacity - 1)
+    {
+        if (capacity < 2 || (capacity & mask) != 0)
+            throw std::runtime_error("LockFreeQueue capacity has to be a power of two");
+        for (size_t i = 0; i < capacity; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// \return false if the queue is full
+    bool push(const T& value)
+    {
+        size_t pos = pushPos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = pushPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// \return false if the queue is empty
+    bool pop(T& value)
+    {
+        size_t pos = popPos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = slot.value;
+                    slot.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = popPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+protected:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    // keep the producer and the consumer position on separate cache lines
+    alignas(64) std::atomic<size_t> pushPos { 0 };
+    alignas(64) std::atomic<size_t> popPos { 0 };
+};
+
+#endif // GERBERA_LOCK_FREE_QUEUE_H
@@ -0,0 +1,75 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    mime_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file mime_cache.cc
+
+#ifdef HAVE_MAGIC
+
+#include "mime_cache.h" // API
+
+#include "util/tools.h"
+
+MimeCache::MimeCache(size_t maxEntries)
+    : maxEntries(maxEntries)
+{
+}
+
+std::string MimeCache::getMimeType(const fs::path& path, time_t mtime, off_t size)
+{
+    {
+        AutoLock lock(mutex);
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second.mtime == mtime && it->second.size == size) {
+            lru.splice(lru.begin(), lru, it->second.lruPos);
+            hits++;
+            return it->second.mimeType;
+        }
+    }
+
+    // classify without holding the lock, concurrent misses for the same
+    // file just do the work twice
+    misses++;
+    std::string mimeType = getMIMETypeFromFile(path);
+    if (mimeType.empty() || maxEntries == 0)
+        return mimeType;
+
+    AutoLock lock(mutex);
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        it->second.mtime = mtime;
+        it->second.size = size;
+        it->second.mimeType = mimeType;
+        return mimeType;
+    }
+
+    if (entries.size() >= maxEntries) {
+        entries.erase(lru.back());
+        lru.pop_back();
+    }
+    lru.push_front(path);
+    entries.emplace(path, Entry { mtime, size, mimeType, lru.begin() });
+    return mimeType;
+}
+
+#endif // HAVE_MAGIC
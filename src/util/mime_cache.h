@@ -0,0 +1,78 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    mime_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file mime_cache.h
+/// \brief Definition of the MimeCache class.
+#ifndef GERBERA_MIME_CACHE_H
+#define GERBERA_MIME_CACHE_H
+
+#ifdef HAVE_MAGIC
+
+#include <atomic>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+namespace fs = std::filesystem;
+
+/// \brief Remembers the mime types filemagic found for files.
+///
+/// Entries are only valid for the modification time and size of the file
+/// they were computed for, the least recently used ones are dropped first.
+class MimeCache {
+public:
+    /// \param maxEntries number of files to remember
+    explicit MimeCache(size_t maxEntries);
+
+    /// \brief Returns the mime type of a file, classifying it on a miss.
+    /// \return empty string if filemagic failed
+    std::string getMimeType(const fs::path& path, time_t mtime, off_t size);
+
+    size_t getHitCount() const { return hits; }
+    size_t getMissCount() const { return misses; }
+
+protected:
+    using Lru = std::list<std::string>;
+    struct Entry {
+        time_t mtime;
+        off_t size;
+        std::string mimeType;
+        Lru::iterator lruPos;
+    };
+
+    size_t maxEntries;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    /// \brief paths, most recently used first
+    Lru lru;
+    std::unordered_map<std::string, Entry> entries;
+
+    std::atomic<size_t> hits { 0 };
+    std::atomic<size_t> misses { 0 };
+};
+
+#endif // HAVE_MAGIC
+#endif // GERBERA_MIME_CACHE_H
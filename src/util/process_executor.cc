@@ -33,11 +33,21 @@
 #include "logger.h"
 #include "process.h"
 
+#include <cerrno>
 #include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
 
-ProcessExecutor::ProcessExecutor(const std::string& command, const std::vector<std::string>& arglist)
+// ioprio_set(2) has no libc wrapper
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_LOWEST_LEVEL 7
+
+ProcessExecutor::ProcessExecutor(const std::string& command, const std::vector<std::string>& arglist, int niceness, io_class_t ioClass, const std::vector<int>& inheritFds)
 {
 #define MAX_ARGS 255
     const char* argv[MAX_ARGS];
@@ -63,6 +73,17 @@ ProcessExecutor::ProcessExecutor(const std::string& command, const std::vector<s
     case 0:
         sigset_t mask_set;
         pthread_sigmask(SIG_SETMASK, &mask_set, nullptr);
+        if (niceness != 0 && setpriority(PRIO_PROCESS, 0, niceness) != 0)
+            log_warning("Failed to set priority of process {}: {}", command.c_str(), strerror(errno));
+#ifdef SYS_ioprio_set
+        if (ioClass != IO_CLASS_NONE) {
+            int level = (ioClass == IO_CLASS_BEST_EFFORT) ? IOPRIO_LOWEST_LEVEL : 0;
+            if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, (ioClass << IOPRIO_CLASS_SHIFT) | level) != 0)
+                log_warning("Failed to set I/O class of process {}: {}", command.c_str(), strerror(errno));
+        }
+#endif
+        for (int fd : inheritFds)
+            fcntl(fd, F_SETFD, 0);
         log_debug("Launching process: {}", command.c_str());
         execvp(command.c_str(), const_cast<char** const>(argv));
     default:
@@ -37,10 +37,25 @@
 
 #include "executor.h"
 
+/// \brief I/O scheduling classes as defined by ioprio_set(2)
+typedef enum {
+    IO_CLASS_NONE = 0,
+    IO_CLASS_BEST_EFFORT = 2,
+    IO_CLASS_IDLE = 3
+} io_class_t;
+
 class ProcessExecutor : public Executor {
 public:
+    /// \brief Launches command.
+    /// \param niceness nice value of the process, 0 to inherit ours
+    /// \param ioClass I/O scheduling class of the process, best-effort uses
+    /// the lowest priority of the class; ignored where not supported
+    /// \param inheritFds descriptors opened with O_CLOEXEC that the process
+    /// should still inherit, e.g. the ends of pipes handed over as /dev/fd/N
     ProcessExecutor(const std::string& command,
-        const std::vector<std::string>& arglist);
+        const std::vector<std::string>& arglist,
+        int niceness = 0, io_class_t ioClass = IO_CLASS_NONE,
+        const std::vector<int>& inheritFds = std::vector<int>());
     bool isAlive() override;
     bool kill() override;
     int getStatus() override;
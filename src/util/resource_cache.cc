@@ -0,0 +1,209 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    resource_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file resource_cache.cc
+
+#include "resource_cache.h" // API
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "iohandler/io_handler.h"
+#include "util/tools.h"
+
+/// \brief Entries larger than this fraction of the memory cache are not kept in memory.
+#define MAX_ENTRY_FRACTION 4
+
+ResourceCache::ResourceCache(size_t memorySize, fs::path cacheDir, size_t diskSize)
+    : memorySize(memorySize)
+    , cacheDir(std::move(cacheDir))
+    , diskSize(diskSize)
+    , memoryUsed(0)
+    , diskUsed(-1)
+{
+}
+
+std::string ResourceCache::makeKey(const fs::path& source, time_t mtime, const std::string& variant)
+{
+    return fmt::format("{}_{}_{}", hex_string_md5(source.string()), hex_string_md5(variant), mtime);
+}
+
+std::shared_ptr<const std::string> ResourceCache::get(const std::string& key)
+{
+    {
+        AutoLock lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            lru.splice(lru.begin(), lru, it->second.lruPos);
+            return it->second.data;
+        }
+    }
+
+    auto data = readDisk(key);
+    if (data != nullptr)
+        putMemory(key, data);
+    return data;
+}
+
+void ResourceCache::put(const std::string& key, const std::shared_ptr<const std::string>& data)
+{
+    putMemory(key, data);
+    writeDisk(key, *data);
+}
+
+std::shared_ptr<const std::string> ResourceCache::getOrCreate(const std::string& key, const std::function<std::unique_ptr<IOHandler>()>& create)
+{
+    auto data = get(key);
+    if (data != nullptr) {
+        log_debug("resource {} served from cache", key);
+        return data;
+    }
+
+    auto handler = create();
+    if (handler == nullptr)
+        throw std::runtime_error("resource " + key + " is not available");
+
+    data = std::make_shared<const std::string>(readAll(*handler));
+    put(key, data);
+    return data;
+}
+
+std::string ResourceCache::readAll(IOHandler& handler)
+{
+    std::string result;
+    char buffer[16384];
+
+    handler.open(UPNP_READ);
+    try {
+        size_t bytesRead;
+        while ((bytesRead = handler.read(buffer, sizeof(buffer))) > 0) {
+            if (bytesRead == static_cast<size_t>(-1))
+                throw std::runtime_error("failed to read resource");
+            result.append(buffer, bytesRead);
+        }
+    } catch (const std::runtime_error&) {
+        handler.close();
+        throw;
+    }
+    handler.close();
+    return result;
+}
+
+void ResourceCache::putMemory(const std::string& key, const std::shared_ptr<const std::string>& data)
+{
+    if (data->size() > memorySize / MAX_ENTRY_FRACTION)
+        return;
+
+    AutoLock lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        memoryUsed -= it->second.data->size();
+        lru.erase(it->second.lruPos);
+        entries.erase(it);
+    }
+
+    while (!lru.empty() && memoryUsed + data->size() > memorySize) {
+        auto last = entries.find(lru.back());
+        memoryUsed -= last->second.data->size();
+        entries.erase(last);
+        lru.pop_back();
+    }
+
+    lru.push_front(key);
+    entries[key] = { data, lru.begin() };
+    memoryUsed += data->size();
+}
+
+std::shared_ptr<const std::string> ResourceCache::readDisk(const std::string& key)
+{
+    if (cacheDir.empty())
+        return nullptr;
+
+    auto path = cacheDir / key;
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec))
+        return nullptr;
+
+    try {
+        auto data = std::make_shared<const std::string>(readTextFile(path));
+        // keep recently used files from being trimmed
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+        return data;
+    } catch (const std::runtime_error& e) {
+        log_warning("resource cache: {}", e.what());
+        return nullptr;
+    }
+}
+
+void ResourceCache::writeDisk(const std::string& key, const std::string& data)
+{
+    if (cacheDir.empty() || data.size() > diskSize)
+        return;
+
+    std::lock_guard<std::mutex> lock(diskMutex);
+    std::error_code ec;
+    if (!fs::create_directories(cacheDir, ec) && ec) {
+        log_warning("resource cache: could not create {}: {}", cacheDir.c_str(), ec.message());
+        return;
+    }
+
+    trimDisk(data.size());
+
+    // write under a temporary name so readers never see partial files
+    auto path = cacheDir / key;
+    auto tmpPath = cacheDir / (key + ".tmp");
+    try {
+        writeTextFile(tmpPath, data);
+        fs::rename(tmpPath, path);
+        diskUsed += data.size();
+    } catch (const std::exception& e) {
+        log_warning("resource cache: could not store {}: {}", key, e.what());
+        fs::remove(tmpPath, ec);
+    }
+}
+
+void ResourceCache::trimDisk(size_t needed)
+{
+    if (diskUsed >= 0 && static_cast<size_t>(diskUsed) + needed <= diskSize)
+        return;
+
+    std::vector<std::pair<fs::file_time_type, fs::directory_entry>> files;
+    std::error_code ec;
+    diskUsed = 0;
+    for (const auto& entry : fs::directory_iterator(cacheDir, ec)) {
+        if (!entry.is_regular_file(ec))
+            continue;
+        diskUsed += entry.file_size(ec);
+        files.emplace_back(entry.last_write_time(ec), entry);
+    }
+
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& file : files) {
+        if (static_cast<size_t>(diskUsed) + needed <= diskSize)
+            break;
+        auto size = file.second.file_size(ec);
+        if (fs::remove(file.second.path(), ec))
+            diskUsed -= size;
+    }
+}
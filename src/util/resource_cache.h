@@ -0,0 +1,107 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    resource_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file resource_cache.h
+/// \brief Definition of the ResourceCache class.
+#ifndef GERBERA_RESOURCE_CACHE_H
+#define GERBERA_RESOURCE_CACHE_H
+
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+namespace fs = std::filesystem;
+
+// forward declaration
+class IOHandler;
+
+/// \brief Size bounded cache for generated secondary resources.
+///
+/// Thumbnails, album art and other resources produced by the metadata
+/// handlers are kept in memory (least recently used entries are dropped
+/// first) and, if a directory is configured, on disk. Keys contain the
+/// path and modification time of the source file and the resource
+/// settings, so entries of changed files or settings are never served.
+class ResourceCache {
+public:
+    /// \brief Initializes the cache.
+    /// \param memorySize maximum number of bytes held in memory
+    /// \param cacheDir directory for the disk cache, empty to disable it
+    /// \param diskSize maximum number of bytes stored in cacheDir
+    ResourceCache(size_t memorySize, fs::path cacheDir, size_t diskSize);
+
+    /// \brief Builds the key of a resource generated from a file.
+    /// \param source file the resource is generated from
+    /// \param mtime modification time of source
+    /// \param variant everything else the content depends on, see
+    /// MetadataHandler::getContentVariant()
+    static std::string makeKey(const fs::path& source, time_t mtime, const std::string& variant);
+
+    /// \brief Returns the cached data or nullptr.
+    std::shared_ptr<const std::string> get(const std::string& key);
+
+    /// \brief Stores data in memory and on disk.
+    void put(const std::string& key, const std::shared_ptr<const std::string>& data);
+
+    /// \brief Returns the cached data, reading it from a new handler on a miss.
+    /// \param create returns the (unopened) handler generating the resource
+    std::shared_ptr<const std::string> getOrCreate(const std::string& key, const std::function<std::unique_ptr<IOHandler>()>& create);
+
+    /// \brief Reads an unopened handler to its end.
+    static std::string readAll(IOHandler& handler);
+
+protected:
+    using Lru = std::list<std::string>;
+    struct Entry {
+        std::shared_ptr<const std::string> data;
+        Lru::iterator lruPos;
+    };
+
+    size_t memorySize;
+    fs::path cacheDir;
+    size_t diskSize;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    /// \brief keys, most recently used first
+    Lru lru;
+    std::unordered_map<std::string, Entry> entries;
+    size_t memoryUsed;
+
+    /// \brief bytes stored in cacheDir, -1 until the directory was scanned
+    off_t diskUsed;
+    std::mutex diskMutex;
+
+    void putMemory(const std::string& key, const std::shared_ptr<const std::string>& data);
+    std::shared_ptr<const std::string> readDisk(const std::string& key);
+    void writeDisk(const std::string& key, const std::string& data);
+
+    /// \brief Removes the oldest files until needed more bytes fit into the disk cache.
+    void trimDisk(size_t needed);
+};
+
+#endif // GERBERA_RESOURCE_CACHE_H
@@ -182,5 +182,7 @@ void Timer::shutdown()
 {
     shutdownFlag = true;
     cond.notify_all();
-    pthread_join(thread, nullptr);
+    if (thread)
+        pthread_join(thread, nullptr);
+    thread = 0;
 }
@@ -591,6 +591,77 @@ int HMSToSeconds(const std::string& time)
     return (hours * 3600) + (minutes * 60) + seconds;
 }
 
+bool parseNptTime(const std::string& time, double& seconds)
+{
+    // npt-sec is "S+[.S*]", npt-hhmmss is "H+:MM:SS[.S*]"
+    auto isNumber = [](const std::string& part) { return !part.empty() && part.find_first_not_of("0123456789") == std::string::npos; };
+
+    std::string whole = time;
+    std::string fraction;
+    size_t dot = time.find('.');
+    if (dot != std::string::npos) {
+        whole = time.substr(0, dot);
+        fraction = time.substr(dot + 1);
+        if (!fraction.empty() && !isNumber(fraction))
+            return false;
+    }
+
+    try {
+        size_t first = whole.find(':');
+        if (first == std::string::npos) {
+            if (!isNumber(whole))
+                return false;
+            seconds = std::stod(whole);
+        } else {
+            size_t second = whole.find(':', first + 1);
+            if (second == std::string::npos)
+                return false;
+            std::string hours = whole.substr(0, first);
+            std::string minutes = whole.substr(first + 1, second - first - 1);
+            std::string secs = whole.substr(second + 1);
+            if (!isNumber(hours) || minutes.length() != 2 || !isNumber(minutes) || secs.length() != 2 || !isNumber(secs))
+                return false;
+            if (std::stoi(minutes) > 59 || std::stoi(secs) > 59)
+                return false;
+            seconds = std::stod(hours) * 3600 + std::stoi(minutes) * 60 + std::stoi(secs);
+        }
+        if (!fraction.empty())
+            seconds += std::stod("0." + fraction);
+    } catch (const std::logic_error&) {
+        return false;
+    }
+    return true;
+}
+
+bool parseNptRange(const std::string& value, double& start, double& end)
+{
+    std::string range = trim_string(value);
+    if (!startswith(range, "npt="))
+        return false;
+    range = range.substr(4);
+
+    size_t dash = range.find('-');
+    if (dash == std::string::npos)
+        return false;
+
+    if (!parseNptTime(trim_string(range.substr(0, dash)), start))
+        return false;
+
+    end = -1;
+    std::string endTime = trim_string(range.substr(dash + 1));
+    if (!endTime.empty() && !parseNptTime(endTime, end))
+        return false;
+
+    return end < 0 || end >= start;
+}
+
+std::string secondsToNpt(double seconds)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3f", seconds);
+    return buf;
+}
+
 #ifdef HAVE_MAGIC
 std::string getMIMETypeFromFile(const fs::path& file)
 {
@@ -602,32 +673,58 @@ std::string getMIMETypeFromBuffer(const void* buffer, size_t length)
     return getMIME("", buffer, length);
 }
 
-std::string getMIME(const fs::path& filepath, const void* buffer, size_t length)
-{
-    /* MAGIC_MIME_TYPE tells magic to return ONLY the mimetype */
-    magic_t magic_cookie = magic_open(MAGIC_MIME_TYPE);
+/// \brief libmagic handle of the current thread.
+///
+/// Handles must not be shared between threads and loading the database is
+/// expensive, so each thread loads it once and keeps the handle until it exits.
+class MagicCookie {
+public:
+    MagicCookie()
+    {
+        /* MAGIC_MIME_TYPE tells magic to return ONLY the mimetype */
+        cookie = magic_open(MAGIC_MIME_TYPE);
+        if (cookie == nullptr) {
+            log_warning("Failed to initialize libmagic");
+            return;
+        }
 
-    if (magic_cookie == nullptr) {
-        log_warning("Failed to initialize libmagic");
-        return "";
+        if (magic_load(cookie, nullptr) != 0) {
+            log_warning("Failed to load magic database: {}", magic_error(cookie));
+            magic_close(cookie);
+            cookie = nullptr;
+        }
     }
 
-    if (magic_load(magic_cookie, nullptr) != 0) {
-        log_warning("Failed to load magic database: {}", magic_error(magic_cookie));
-        magic_close(magic_cookie);
-        return "";
+    ~MagicCookie()
+    {
+        if (cookie != nullptr)
+            magic_close(cookie);
     }
 
+    MagicCookie(const MagicCookie&) = delete;
+    MagicCookie& operator=(const MagicCookie&) = delete;
+
+    magic_t cookie;
+};
+
+std::string getMIME(const fs::path& filepath, const void* buffer, size_t length)
+{
+    thread_local MagicCookie magic;
+    if (magic.cookie == nullptr)
+        return "";
+
     const char* mime;
     if (!string_ok(filepath)) {
-        mime = magic_buffer(magic_cookie, buffer, length);
+        mime = magic_buffer(magic.cookie, buffer, length);
     } else {
-        mime = magic_file(magic_cookie, filepath.c_str());
+        mime = magic_file(magic.cookie, filepath.c_str());
     }
 
-    std::string out = mime;
-    magic_close(magic_cookie);
-    return out;
+    if (mime == nullptr) {
+        log_debug("libmagic failed on {}: {}", filepath.c_str(), magic_error(magic.cookie));
+        return "";
+    }
+    return mime;
 }
 #endif
 
@@ -854,13 +951,6 @@ std::string getValueOrDefault(const std::map<std::string, std::string>& m, const
     return getValueOrDefault<std::string, std::string>(m, key, defval);
 }
 
-std::string toCSV(const shared_ptr<unordered_set<int>>& array)
-{
-    if (array->empty())
-        return "";
-    return join(*array, ",");
-}
-
 void getTimespecNow(struct timespec* ts)
 {
     struct timeval tv;
@@ -999,14 +1089,30 @@ std::string ipToInterface(const std::string& ip)
     return "";
 }
 
+std::string sockAddrToString(const struct sockaddr_storage* addr)
+{
+    if (addr == nullptr || (addr->ss_family != AF_INET && addr->ss_family != AF_INET6))
+        return "";
+
+    char host[NI_MAXHOST];
+    int s = getnameinfo(reinterpret_cast<const struct sockaddr*>(addr),
+        (addr->ss_family == AF_INET) ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6),
+        host, NI_MAXHOST, nullptr, 0, NI_NUMERICHOST);
+    if (s != 0) {
+        log_error("getnameinfo() failed: {}", gai_strerror(s));
+        return "";
+    }
+    return host;
+}
+
 bool validateYesNo(const std::string& value)
 {
     return !((value != "yes") && (value != "no"));
 }
 
-std::vector<std::string> populateCommandLine(const std::string& line, const std::string& in, const std::string& out, const std::string& range)
+std::vector<std::string> populateCommandLine(const std::string& line, const std::string& in, const std::string& out, const std::string& range, const std::string& start)
 {
-    log_debug("Template: '{}', in: '{}', out: '{}', range: '{}'", line, in, out, range);
+    log_debug("Template: '{}', in: '{}', out: '{}', range: '{}', start: '{}'", line, in, out, range, start);
     std::vector<std::string> params = split_string(line, ' ');
     if (in.empty() && out.empty())
         return params;
@@ -1024,7 +1130,12 @@ std::vector<std::string> populateCommandLine(const std::string& line, const std:
 
         size_t rangePos = param.find("%range");
         if (rangePos != string::npos) {
-            std::string newParam = param.replace(rangePos, 5, range);
+            std::string newParam = param.replace(rangePos, 6, range);
+        }
+
+        size_t startPos = param.find("%start");
+        if (startPos != string::npos) {
+            std::string newParam = param.replace(startPos, 6, string_ok(start) ? start : "0");
         }
     }
 
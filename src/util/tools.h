@@ -40,6 +40,7 @@
 #include <vector>
 namespace fs = std::filesystem;
 
+#include <sys/socket.h>
 #include <sys/time.h>
 
 #include "common.h"
@@ -189,6 +190,21 @@ std::string secondsToHMS(int seconds);
 /// \brief converts a "H:MM:SS:" representation to seconds
 int HMSToSeconds(const std::string& time);
 
+/// \brief Parses an npt time, either seconds or "H:MM:SS" with optional fraction.
+/// \return false if time is not a valid npt time
+bool parseNptTime(const std::string& time, double& seconds);
+
+/// \brief Parses a DLNA TimeSeekRange.dlna.org value like "npt=10.5-" or
+/// "npt=0:01:10.500-0:02:00".
+/// \param value header value
+/// \param start set to the start of the range in seconds
+/// \param end set to the end of the range in seconds, -1 if the range is open
+/// \return false if the value is not a valid npt range
+bool parseNptRange(const std::string& value, double& start, double& end);
+
+/// \brief Renders seconds as npt time in seconds with millisecond precision.
+std::string secondsToNpt(double seconds);
+
 #ifdef HAVE_MAGIC
 /// \brief Extracts mimetype from a file using filemagic
 std::string getMIMETypeFromFile(const fs::path& file);
@@ -273,8 +289,6 @@ V getValueOrDefault(const std::map<K, V>& m, const K& key, const V& defval)
 }
 std::string getValueOrDefault(const std::map<std::string, std::string>& m, const std::string& key, const std::string& defval = "");
 
-std::string toCSV(const std::shared_ptr<std::unordered_set<int>>& array);
-
 //inline void getTimeval(struct timeval *now) { gettimeofday(now, NULL); }
 
 void getTimespecNow(struct timespec* ts);
@@ -294,6 +308,9 @@ std::string interfaceToIP(const std::string& interface);
 /// \return Interface name or nullptr if IP was not found.
 std::string ipToInterface(const std::string& ip);
 
+/// \brief Returns the numeric address of a socket address, empty if there is none.
+std::string sockAddrToString(const struct sockaddr_storage* addr);
+
 /// \brief Returns true if the given string is eitehr "yes" or "no", otherwise
 /// returns false.
 bool validateYesNo(const std::string& value);
@@ -302,13 +319,14 @@ bool validateYesNo(const std::string& value);
 /// substitutes %in and %out tokens with given strings.
 ///
 /// This function splits a string into array parts, where space is used as the
-/// separator. In addition special %in and %out tokens are replaced by given
-/// strings.
+/// separator. In addition special %in, %out, %range and %start tokens are
+/// replaced by given strings; %start falls back to "0" if start is empty.
 /// \todo add escaping
 std::vector<std::string> populateCommandLine(const std::string& line,
     const std::string& in,
     const std::string& out,
-    const std::string& range);
+    const std::string& range,
+    const std::string& start = "");
 
 /// \brief this is the mkstemp routine from glibc, the only difference is that
 /// it does not return an fd but just the name that we could use.
@@ -31,8 +31,8 @@
 
 /// \file xml_to_json.cc
 
+#include <algorithm>
 #include <iostream>
-#include <regex>
 
 #include "util/tools.h"
 #include "xml_to_json.h"
@@ -126,7 +126,8 @@ std::string Xml2Json::getValue(const char* text)
         return str;
 
     // number
-    if (std::regex_match(str, std::regex("-?\\d+")))
+    size_t start = (str[0] == '-') ? 1 : 0;
+    if (str.length() > start && std::all_of(str.begin() + start, str.end(), [](char c) { return c >= '0' && c <= '9'; }))
         return str;
 
     return getAsString(text);
@@ -134,13 +135,11 @@ std::string Xml2Json::getValue(const char* text)
 
 bool Xml2Json::isArray(pugi::xml_node& node, const Hints* hints, std::string* arrayName)
 {
-    for (const auto& hint : hints->asArray) {
-        if (hint.first == node) {
-            if (arrayName != nullptr)
-                *arrayName = hint.second;
-            return true;
-        }
-    }
+    auto hint = hints->asArray.find(node);
+    if (hint == hints->asArray.end())
+        return false;
 
-    return false;
+    if (arrayName != nullptr)
+        *arrayName = hint->second;
+    return true;
 }
@@ -51,28 +51,26 @@ void web::containers::process()
     if (parentID == INVALID_OBJECT_ID)
         throw std::runtime_error("web::containers: no parent_id given");
 
-    auto root = xmlDoc->document_element();
-
-    auto containers = root.append_child("containers");
-    xml2JsonHints->setArrayName(containers, "container");
-    containers.append_attribute("parent_id") = parentID;
-    containers.append_attribute("type") = "database";
+    writer->beginObject("containers");
+    writer->add("parent_id", parentID);
+    writer->add("type", "database");
     if (string_ok(param("select_it")))
-        containers.append_attribute("select_it") = param("select_it").c_str();
+        writer->add("select_it", param("select_it"));
 
     auto param = std::make_unique<BrowseParam>(parentID, BROWSE_DIRECT_CHILDREN | BROWSE_CONTAINERS);
     auto arr = storage->browse(param);
 
+    writer->beginArray("container");
     for (const auto& obj : arr) {
         //if (IS_CDS_CONTAINER(obj->getObjectType()))
         //{
         auto cont = std::static_pointer_cast<CdsContainer>(obj);
-        auto ce = containers.append_child("container");
-        ce.append_attribute("id") = cont->getID();
+        writer->beginObject();
+        writer->add("id", cont->getID());
         int childCount = cont->getChildCount();
-        ce.append_attribute("child_count") = childCount;
+        writer->add("child_count", childCount);
         int autoscanType = cont->getAutoscanType();
-        ce.append_attribute("autoscan_type") = mapAutoscanType(autoscanType).c_str();
+        writer->add("autoscan_type", mapAutoscanType(autoscanType));
 
         std::string autoscanMode = "none";
         if (autoscanType > 0) {
@@ -85,8 +83,11 @@ void web::containers::process()
             }
 #endif
         }
-        ce.append_attribute("autoscan_mode") = autoscanMode.c_str();
-        ce.append_attribute("title") = cont->getTitle().c_str();
+        writer->add("autoscan_mode", autoscanMode);
+        writer->add("title", cont->getTitle());
+        writer->endObject();
         //}
     }
+    writer->endArray();
+    writer->endObject();
 }
@@ -54,14 +54,11 @@ void web::directories::process()
     else
         path = hex_decode_string(parentID);
 
-    auto root = xmlDoc->document_element();
-
-    auto containers = root.append_child("containers");
-    xml2JsonHints->setArrayName(containers, "container");
-    containers.append_attribute("parent_id") = parentID.c_str();
+    writer->beginObject("containers");
+    writer->add("parent_id", parentID);
     if (string_ok(param("select_it")))
-        containers.append_attribute("select_it") = param("select_it").c_str();
-    containers.append_attribute("type") = "filesystem";
+        writer->add("select_it", param("select_it"));
+    writer->add("type", "filesystem");
 
     // don't bother users with system directorties
     std::vector<fs::path> excludes_fullpath = {
@@ -85,6 +82,7 @@ void web::directories::process()
     };
     bool exclude_config_dirs = true;
 
+    writer->beginArray("container");
     for (auto& it : fs::directory_iterator(path)) {
         const fs::path& filepath = it.path();
 
@@ -107,14 +105,14 @@ void web::directories::process()
         /// \todo replace hex_encode with base64_encode?
         std::string id = hex_encode(filepath.c_str(), filepath.string().length());
 
-        auto ce = containers.append_child("container");
-        ce.append_attribute("id") = id.c_str();
-        if (hasContent)
-            ce.append_attribute("child_count") = 1;
-        else
-            ce.append_attribute("child_count") = 0;
+        writer->beginObject();
+        writer->add("id", id);
+        writer->add("child_count", hasContent ? 1 : 0);
 
         auto f2i = StringConverter::f2i(config);
-        ce.append_attribute("title") = f2i->convert(filepath.filename()).c_str();
+        writer->add("title", f2i->convert(filepath.filename()));
+        writer->endObject();
     }
+    writer->endArray();
+    writer->endObject();
 }
@@ -55,11 +55,8 @@ void web::items::process()
     if (count < 0)
         throw std::runtime_error("illegal count parameter");
 
-    auto root = xmlDoc->document_element();
-
-    auto items = root.append_child("items");
-    xml2JsonHints->setArrayName(items, "item");
-    items.append_attribute("parent_id") = parentID;
+    writer->beginObject("items");
+    writer->add("parent_id", parentID);
 
     auto obj = storage->loadObject(parentID);
     auto param = std::make_unique<BrowseParam>(parentID, BROWSE_DIRECT_CHILDREN | BROWSE_ITEMS);
@@ -72,12 +69,12 @@ void web::items::process()
 
     std::string location = obj->getVirtualPath();
     if (string_ok(location))
-        items.append_attribute("location") = location.c_str();
-    items.append_attribute("virtual") = obj->isVirtual();
+        writer->add("location", location);
+    writer->add("virtual", obj->isVirtual());
 
-    items.append_attribute("start") = start;
-    //items.append_attribute("returned") = arr->size();
-    items.append_attribute("total_matches") = param->getTotalMatches();
+    writer->add("start", start);
+    //writer->add("returned", static_cast<int>(arr.size()));
+    writer->add("total_matches", param->getTotalMatches());
 
     bool protectContainer = false;
     bool protectItems = false;
@@ -108,23 +105,27 @@ void web::items::process()
         }
     }
 #endif
-    items.append_attribute("autoscan_mode") = autoscanMode.c_str();
-    items.append_attribute("autoscan_type") = mapAutoscanType(autoscanType).c_str();
-    items.append_attribute("protect_container") = protectContainer;
-    items.append_attribute("protect_items") = protectItems;
+    writer->add("autoscan_mode", autoscanMode);
+    writer->add("autoscan_type", mapAutoscanType(autoscanType));
+    writer->add("protect_container", protectContainer);
+    writer->add("protect_items", protectItems);
 
+    writer->beginArray("item");
     for (const auto& obj : arr) {
         //if (IS_CDS_ITEM(obj->getObjectType()))
         //{
-        auto item = items.append_child("item");
-        item.append_attribute("id") = obj->getID();
-        item.append_child("title").append_child(pugi::node_pcdata).set_value(obj->getTitle().c_str());
+        writer->beginObject();
+        writer->add("id", obj->getID());
+        writer->add("title", obj->getTitle());
         /// \todo clean this up, should have more generic options for online
         /// services
         // FIXME
         std::string res = UpnpXMLBuilder::getFirstResourcePath(std::static_pointer_cast<CdsItem>(obj));
-        item.append_child("res").append_child(pugi::node_pcdata).set_value(res.c_str());
-        //item.append_attribute("virtual") = obj->isVirtual();
+        writer->add("res", res);
+        //writer->add("virtual", obj->isVirtual());
+        writer->endObject();
         //}
     }
+    writer->endArray();
+    writer->endObject();
 }
@@ -66,6 +66,10 @@ std::unique_ptr<WebRequestHandler> createWebRequestHandler(
         return std::make_unique<web::tasks>(config, storage, content, sessionManager);
     if (page == "action")
         return std::make_unique<web::action>(config, storage, content, sessionManager);
+    if (page == "transcoding")
+        return std::make_unique<web::transcoding>(config, storage, content, sessionManager);
+    if (page == "streams")
+        return std::make_unique<web::streams>(config, storage, content, sessionManager);
 
     throw std::runtime_error("Unknown page: " + page);
 }
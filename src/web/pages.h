@@ -143,7 +143,7 @@ public:
     void process() override;
 
 protected:
-    static void autoscan2XML(const std::shared_ptr<AutoscanDirectory>& adir, pugi::xml_node* element);
+    static void writeAutoscan(const std::shared_ptr<AutoscanDirectory>& adir, ResponseWriter* writer);
 };
 
 /// \brief nothing :)
@@ -163,6 +163,22 @@ public:
     void process() override;
 };
 
+/// \brief running transcoding jobs and queue depth
+class transcoding : public WebRequestHandler {
+public:
+    transcoding(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
+        std::shared_ptr<ContentManager> content, std::shared_ptr<SessionManager> sessionManager);
+    void process() override;
+};
+
+/// \brief media streams with their current rates
+class streams : public WebRequestHandler {
+public:
+    streams(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
+        std::shared_ptr<ContentManager> content, std::shared_ptr<SessionManager> sessionManager);
+    void process() override;
+};
+
 /// \brief UI action button
 class action : public WebRequestHandler {
 public:
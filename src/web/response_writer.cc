@@ -0,0 +1,242 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    response_writer.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file response_writer.cc
+
+#include "response_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace web {
+
+JsonResponseWriter::JsonResponseWriter()
+    : hasMembers(false)
+{
+    buf.reserve(4096);
+    buf += '{';
+}
+
+void JsonResponseWriter::beginMember(const char* name)
+{
+    if (hasMembers)
+        buf += ',';
+    hasMembers = true;
+
+    // members of arrays have no name
+    if (name != nullptr && (scopes.empty() || scopes.back() == '}')) {
+        appendString(name, strlen(name));
+        buf += ':';
+    }
+}
+
+void JsonResponseWriter::appendString(const char* str, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    buf += '"';
+    for (size_t i = 0; i < length; i++) {
+        auto c = static_cast<unsigned char>(str[i]);
+        switch (c) {
+        case '"':
+            buf += "\\\"";
+            break;
+        case '\\':
+            buf += "\\\\";
+            break;
+        case '\n':
+            buf += "\\n";
+            break;
+        case '\r':
+            buf += "\\r";
+            break;
+        case '\t':
+            buf += "\\t";
+            break;
+        default:
+            if (c < 0x20) {
+                buf += "\\u00";
+                buf += hex[c >> 4];
+                buf += hex[c & 0xf];
+            } else {
+                buf += static_cast<char>(c);
+            }
+        }
+    }
+    buf += '"';
+}
+
+void JsonResponseWriter::appendValue(const char* str, size_t length)
+{
+    // same guess as Xml2Json::getValue(), the web UI relies on these types
+    if ((length == 4 && strncmp(str, "true", 4) == 0) || (length == 5 && strncmp(str, "false", 5) == 0)) {
+        buf.append(str, length);
+        return;
+    }
+
+    size_t start = (length > 0 && str[0] == '-') ? 1 : 0;
+    if (length > start && std::all_of(str + start, str + length, [](char c) { return c >= '0' && c <= '9'; })) {
+        buf.append(str, length);
+        return;
+    }
+
+    appendString(str, length);
+}
+
+void JsonResponseWriter::beginObject(const char* name)
+{
+    beginMember(name);
+    buf += '{';
+    scopes.push_back('}');
+    hasMembers = false;
+}
+
+void JsonResponseWriter::endObject()
+{
+    if (scopes.empty() || scopes.back() != '}')
+        throw std::runtime_error("endObject() called without open object");
+    buf += '}';
+    scopes.pop_back();
+    hasMembers = true;
+}
+
+void JsonResponseWriter::beginArray(const char* name)
+{
+    beginMember(name);
+    buf += '[';
+    scopes.push_back(']');
+    hasMembers = false;
+}
+
+void JsonResponseWriter::endArray()
+{
+    if (scopes.empty() || scopes.back() != ']')
+        throw std::runtime_error("endArray() called without open array");
+    buf += ']';
+    scopes.pop_back();
+    hasMembers = true;
+}
+
+void JsonResponseWriter::add(const char* name, const char* value)
+{
+    beginMember(name);
+    appendValue(value, strlen(value));
+}
+
+void JsonResponseWriter::add(const char* name, const std::string& value)
+{
+    beginMember(name);
+    appendValue(value.c_str(), value.length());
+}
+
+void JsonResponseWriter::add(const char* name, int value)
+{
+    beginMember(name);
+    buf += std::to_string(value);
+}
+
+void JsonResponseWriter::add(const char* name, bool value)
+{
+    beginMember(name);
+    buf += value ? "true" : "false";
+}
+
+void JsonResponseWriter::endAll()
+{
+    while (!scopes.empty()) {
+        buf += scopes.back();
+        scopes.pop_back();
+    }
+    hasMembers = true;
+}
+
+std::string JsonResponseWriter::getJson()
+{
+    endAll();
+    return buf + '}';
+}
+
+XmlResponseWriter::XmlResponseWriter(pugi::xml_node root, std::shared_ptr<Xml2Json::Hints> hints)
+    : hints(std::move(hints))
+{
+    scopes.push_back({ root, "" });
+}
+
+void XmlResponseWriter::beginObject(const char* name)
+{
+    auto& scope = scopes.back();
+    if (scope.arrayName.empty())
+        scopes.push_back({ scope.node.append_child(name), "" });
+    else
+        scopes.push_back({ scope.node.append_child(scope.arrayName.c_str()), "" });
+}
+
+void XmlResponseWriter::endObject()
+{
+    if (scopes.size() < 2 || !scopes.back().arrayName.empty())
+        throw std::runtime_error("endObject() called without open object");
+    scopes.pop_back();
+}
+
+void XmlResponseWriter::beginArray(const char* name)
+{
+    auto node = scopes.back().node;
+    hints->setArrayName(node, name);
+    scopes.push_back({ node, name });
+}
+
+void XmlResponseWriter::endArray()
+{
+    if (scopes.back().arrayName.empty())
+        throw std::runtime_error("endArray() called without open array");
+    scopes.pop_back();
+}
+
+void XmlResponseWriter::add(const char* name, const char* value)
+{
+    scopes.back().node.append_attribute(name) = value;
+}
+
+void XmlResponseWriter::add(const char* name, const std::string& value)
+{
+    scopes.back().node.append_attribute(name) = value.c_str();
+}
+
+void XmlResponseWriter::add(const char* name, int value)
+{
+    scopes.back().node.append_attribute(name) = value;
+}
+
+void XmlResponseWriter::add(const char* name, bool value)
+{
+    scopes.back().node.append_attribute(name) = value;
+}
+
+void XmlResponseWriter::endAll()
+{
+    scopes.resize(1);
+}
+
+} // namespace web
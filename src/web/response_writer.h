@@ -0,0 +1,135 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    response_writer.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file response_writer.h
+/// \brief Definition of the ResponseWriter classes.
+#ifndef GERBERA_WEB_RESPONSE_WRITER_H
+#define GERBERA_WEB_RESPONSE_WRITER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pugixml.hpp>
+
+#include "util/xml_to_json.h"
+
+namespace web {
+
+/// \brief Builds the response of a ui request.
+///
+/// Objects contain named values, objects and at most one array of
+/// objects, which has to be the last member. This is what can be
+/// expressed in the xml responses as well.
+class ResponseWriter {
+public:
+    virtual ~ResponseWriter() = default;
+
+    /// \brief Opens an object, it is called name inside of an object
+    /// and unnamed inside of an array.
+    virtual void beginObject(const char* name = nullptr) = 0;
+    virtual void endObject() = 0;
+
+    /// \brief Opens an array of objects called name.
+    virtual void beginArray(const char* name) = 0;
+    virtual void endArray() = 0;
+
+    virtual void add(const char* name, const char* value) = 0;
+    virtual void add(const char* name, const std::string& value) = 0;
+    virtual void add(const char* name, int value) = 0;
+    virtual void add(const char* name, bool value) = 0;
+
+    /// \brief Closes everything but the root object, used when processing
+    /// the request was aborted.
+    virtual void endAll() = 0;
+};
+
+/// \brief Writes JSON directly into a string while the response is built.
+class JsonResponseWriter : public ResponseWriter {
+public:
+    JsonResponseWriter();
+
+    void beginObject(const char* name = nullptr) override;
+    void endObject() override;
+    void beginArray(const char* name) override;
+    void endArray() override;
+
+    void add(const char* name, const char* value) override;
+    void add(const char* name, const std::string& value) override;
+    void add(const char* name, int value) override;
+    void add(const char* name, bool value) override;
+
+    void endAll() override;
+
+    /// \brief Closes all open scopes and returns the JSON document.
+    std::string getJson();
+
+protected:
+    /// \brief Writes the separator and the name of the next member.
+    void beginMember(const char* name);
+    void appendString(const char* str, size_t length);
+    /// \brief Writes str as JSON boolean or number if it looks like one, as Xml2Json does.
+    void appendValue(const char* str, size_t length);
+
+    std::string buf;
+
+    /// \brief Closing character of each open scope, the root object excluded.
+    std::vector<char> scopes;
+    /// \brief Whether the innermost scope has got members yet.
+    bool hasMembers;
+};
+
+/// \brief Builds the response as xml document, which is rendered as is or
+/// converted by Xml2Json.
+///
+/// Values become attributes and arrays set a hint on their element.
+class XmlResponseWriter : public ResponseWriter {
+public:
+    XmlResponseWriter(pugi::xml_node root, std::shared_ptr<Xml2Json::Hints> hints);
+
+    void beginObject(const char* name = nullptr) override;
+    void endObject() override;
+    void beginArray(const char* name) override;
+    void endArray() override;
+
+    void add(const char* name, const char* value) override;
+    void add(const char* name, const std::string& value) override;
+    void add(const char* name, int value) override;
+    void add(const char* name, bool value) override;
+
+    void endAll() override;
+
+protected:
+    struct Scope {
+        pugi::xml_node node;
+        /// \brief Name of the elements in an array scope, empty for objects.
+        std::string arrayName;
+    };
+
+    std::shared_ptr<Xml2Json::Hints> hints;
+    std::vector<Scope> scopes;
+};
+
+} // namespace web
+
+#endif // GERBERA_WEB_RESPONSE_WRITER_H
@@ -29,8 +29,8 @@
 
 /// \file session_manager.cc
 
+#include <algorithm>
 #include <memory>
-#include <unordered_set>
 #include <utility>
 
 #include "config/config_manager.h"
@@ -38,8 +38,9 @@
 #include "util/timer.h"
 #include "util/tools.h"
 
-#define UI_UPDATE_ID_HASH_SIZE 61
-#define MAX_UI_UPDATE_IDS 10
+/// \brief Number of container changes queued between two web requests
+/// before every session has to reload all containers
+#define UI_UPDATE_QUEUE_SIZE 1024
 
 using namespace std;
 
@@ -50,9 +51,9 @@ Session::Session(long timeout)
     this->timeout = timeout;
     loggedIn = false;
     sessionID = "";
-    uiUpdateIDs = make_shared<unordered_set<int>>();
-    //(new DBRHash<int>(UI_UPDATE_ID_HASH_SIZE, MAX_UI_UPDATE_IDS + 5, INVALID_OBJECT_ID, INVALID_OBJECT_ID_2));
+    uiUpdateIDCount = 0;
     updateAll = false;
+    interrupted = false;
     access();
 }
 
@@ -70,124 +71,152 @@ std::string Session::get(const std::string& key)
 
 void Session::containerChangedUI(int objectID)
 {
-    if (objectID == INVALID_OBJECT_ID)
-        return;
-    if (!updateAll) {
-        AutoLock lock(mutex);
-        if (!updateAll) {
-            if (uiUpdateIDs->size() >= MAX_UI_UPDATE_IDS) {
-                updateAll = true;
-                uiUpdateIDs->clear();
-            } else
-                uiUpdateIDs->insert(objectID);
-        }
-    }
+    containerChangedUI(std::vector<int> { objectID });
 }
 
 void Session::containerChangedUI(const std::vector<int>& objectIDs)
 {
-    if (updateAll)
-        return;
-
-    size_t arSize = objectIDs.size();
     AutoLock lock(mutex);
-
     if (updateAll)
         return;
 
-    if (uiUpdateIDs->size() + arSize >= MAX_UI_UPDATE_IDS) {
-        updateAll = true;
-        uiUpdateIDs->clear();
-        return;
-    }
-    for (int objectId : objectIDs) {
-        uiUpdateIDs->insert(objectId);
+    auto end = uiUpdateIDs.begin() + uiUpdateIDCount;
+    for (int objectID : objectIDs) {
+        if (objectID == INVALID_OBJECT_ID || std::find(uiUpdateIDs.begin(), end, objectID) != end)
+            continue;
+        if (uiUpdateIDCount >= MAX_UI_UPDATE_IDS) {
+            updateAll = true;
+            uiUpdateIDCount = 0;
+            break;
+        }
+        uiUpdateIDs[uiUpdateIDCount++] = objectID;
+        end = uiUpdateIDs.begin() + uiUpdateIDCount;
     }
 }
 
+void Session::containerChangedUI()
+{
+    AutoLock lock(mutex);
+    updateAll = true;
+    uiUpdateIDCount = 0;
+}
+
 std::string Session::getUIUpdateIDs()
 {
-    if (!hasUIUpdateIDs())
-        return "";
     AutoLock lock(mutex);
     if (updateAll) {
         updateAll = false;
         return "all";
     }
-    std::string ret = toCSV(uiUpdateIDs);
-    if (!ret.empty())
-        uiUpdateIDs->clear();
+    std::string ret = join(std::vector<int>(uiUpdateIDs.begin(), uiUpdateIDs.begin() + uiUpdateIDCount), ",");
+    uiUpdateIDCount = 0;
     return ret;
 }
 
 bool Session::hasUIUpdateIDs()
 {
-    if (updateAll)
-        return true;
-    // AutoLock lock(mutex); only accessing an int - shouldn't be necessary
-    return (!uiUpdateIDs->empty());
+    AutoLock lock(mutex);
+    return updateAll || uiUpdateIDCount > 0;
 }
 
 void Session::clearUpdateIDs()
 {
     log_debug("clearing UI updateIDs");
     AutoLock lock(mutex);
-    uiUpdateIDs->clear();
+    uiUpdateIDCount = 0;
     updateAll = false;
 }
 
+void Session::interrupt()
+{
+    AutoLock lock(mutex);
+    interrupted = true;
+}
+
+bool Session::isInterrupted()
+{
+    AutoLock lock(mutex);
+    return interrupted;
+}
+
 SessionManager::SessionManager(const std::shared_ptr<ConfigManager>& config, std::shared_ptr<Timer> timer)
+    : uiUpdateQueue(UI_UPDATE_QUEUE_SIZE)
 {
     this->timer = std::move(timer);
     accounts = config->getDictionaryOption(CFG_SERVER_UI_ACCOUNT_LIST);
+    for (auto& shard : shards)
+        shard.sessions = std::make_shared<SessionMap>();
+    sessionCount = 0;
     timerAdded = false;
+    uiUpdateOverflow = false;
+    uiUpdateSequence = 0;
+    waitingRequests = 0;
+    maxWaitingRequests = config->getIntOption(CFG_SERVER_UI_MAX_LONG_POLLS);
+    shutdownFlag = false;
+}
+
+SessionManager::Shard& SessionManager::getShard(const std::string& sessionID)
+{
+    return shards[std::hash<std::string>()(sessionID) % SESSION_SHARDS];
+}
+
+template <typename F>
+void SessionManager::modifyShard(Shard& shard, F modify)
+{
+    auto sessions = std::make_shared<SessionMap>(*shard.sessions);
+    modify(*sessions);
+    std::atomic_store(&shard.sessions, std::shared_ptr<const SessionMap>(std::move(sessions)));
 }
 
 std::shared_ptr<Session> SessionManager::createSession(long timeout)
 {
     auto newSession = std::make_shared<Session>(timeout);
-    AutoLock lock(mutex);
 
     int count = 0;
     std::string sessionID;
-    do {
+    for (;;) {
         sessionID = generate_random_id();
         if (count++ > 100)
             throw std::runtime_error("There seems to be something wrong with the random numbers. I tried to get a unique id 100 times and failed. last sessionID: " + sessionID);
-    } while (getSession(sessionID, false) != nullptr); // for the rare case, where we get a random id, that is already taken
 
-    newSession->setID(sessionID);
-    sessions.push_back(newSession);
+        auto& shard = getShard(sessionID);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // for the rare case, where we get a random id, that is already taken
+        if (shard.sessions->find(sessionID) != shard.sessions->end())
+            continue;
+
+        newSession->setID(sessionID);
+        modifyShard(shard, [&](SessionMap& sessions) { sessions[sessionID] = newSession; });
+        break;
+    }
+
+    sessionCount++;
     checkTimer();
     return newSession;
 }
 
-std::shared_ptr<Session> SessionManager::getSession(const std::string& sessionID, bool doLock)
+std::shared_ptr<Session> SessionManager::getSession(const std::string& sessionID)
 {
-    unique_lock<decltype(mutex)> lock(mutex, std::defer_lock);
-    if (doLock)
-        lock.lock();
-    for (const auto& s : sessions) {
-        if (s->getID() == sessionID)
-            return s;
-    }
-    return nullptr;
+    auto sessions = std::atomic_load(&getShard(sessionID).sessions);
+    auto it = sessions->find(sessionID);
+    return it != sessions->end() ? it->second : nullptr;
 }
 
 void SessionManager::removeSession(const std::string& sessionID)
 {
-    AutoLock lock(mutex);
-
-    for (auto it = sessions.begin(); it != sessions.end(); /*++it*/) {
-        auto& s = *it;
-
-        if (s->getID() == sessionID) {
-            it = sessions.erase(it);
-            checkTimer();
+    auto& shard = getShard(sessionID);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sessions->find(sessionID);
+        if (it == shard.sessions->end())
             return;
-        }
-        ++it;
+
+        it->second->interrupt();
+        modifyShard(shard, [&](SessionMap& sessions) { sessions.erase(sessionID); });
     }
+    notifyWaitingRequests();
+    sessionCount--;
+    checkTimer();
 }
 
 std::string SessionManager::getUserPassword(const std::string& user)
@@ -197,32 +226,124 @@ std::string SessionManager::getUserPassword(const std::string& user)
 
 void SessionManager::containerChangedUI(int objectID)
 {
-    if (sessions.empty())
+    if (objectID == INVALID_OBJECT_ID || sessionCount == 0)
         return;
-    AutoLock lock(mutex);
-    for (const auto& session : sessions) {
-        if (session->isLoggedIn())
-            session->containerChangedUI(objectID);
-    }
+    if (!uiUpdateQueue.push(objectID))
+        uiUpdateOverflow = true;
+
+    uiUpdateSequence++;
+    notifyWaitingRequests();
 }
 
 void SessionManager::containerChangedUI(const std::vector<int>& objectIDs)
 {
-    if (sessions.empty())
+    if (sessionCount == 0)
         return;
-    AutoLock lock(mutex);
-    for (const auto& session : sessions) {
-        if (session->isLoggedIn())
-            session->containerChangedUI(objectIDs);
+    for (int objectID : objectIDs) {
+        if (!uiUpdateQueue.push(objectID)) {
+            uiUpdateOverflow = true;
+            break;
+        }
+    }
+
+    uiUpdateSequence++;
+    notifyWaitingRequests();
+}
+
+void SessionManager::notifyWaitingRequests()
+{
+    // pairs with the increment in waitForUIUpdateIDs(), either the waiting
+    // request sees the change or this thread sees the waiting request
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitingRequests == 0)
+        return;
+
+    // a request that checked for changes before they were queued is
+    // waiting once the mutex is free
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+    }
+    waitCond.notify_all();
+}
+
+void SessionManager::dispatchUIUpdates()
+{
+    std::lock_guard<std::mutex> lock(dispatchMutex);
+
+    bool overflow = uiUpdateOverflow.exchange(false);
+    std::vector<int> objectIDs;
+    int objectID;
+    while (uiUpdateQueue.pop(objectID)) {
+        // more than a session remembers anyway
+        if (objectIDs.size() > Session::MAX_UI_UPDATE_IDS)
+            overflow = true;
+        else if (std::find(objectIDs.begin(), objectIDs.end(), objectID) == objectIDs.end())
+            objectIDs.push_back(objectID);
+    }
+    if (objectIDs.empty() && !overflow)
+        return;
+
+    for (auto& shard : shards) {
+        auto sessions = std::atomic_load(&shard.sessions);
+        for (const auto& entry : *sessions) {
+            auto& session = entry.second;
+            if (!session->isLoggedIn())
+                continue;
+            if (overflow)
+                session->containerChangedUI();
+            else
+                session->containerChangedUI(objectIDs);
+        }
+    }
+}
+
+bool SessionManager::waitForUIUpdateIDs(const std::shared_ptr<Session>& session, std::chrono::milliseconds timeout)
+{
+    if (++waitingRequests > maxWaitingRequests || shutdownFlag) {
+        waitingRequests--;
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(waitMutex);
+    for (;;) {
+        unsigned long sequence = uiUpdateSequence;
+        lock.unlock();
+
+        dispatchUIUpdates();
+        if (session->hasUIUpdateIDs() || session->isInterrupted() || shutdownFlag)
+            break;
+
+        lock.lock();
+        bool woken = waitCond.wait_until(lock, deadline, [&] {
+            return uiUpdateSequence != sequence || shutdownFlag || session->isInterrupted();
+        });
+        if (!woken)
+            break;
+    }
+    waitingRequests--;
+    return true;
+}
+
+void SessionManager::shutdown()
+{
+    shutdownFlag = true;
+    for (auto& shard : shards) {
+        auto sessions = std::atomic_load(&shard.sessions);
+        for (const auto& entry : *sessions)
+            entry.second->interrupt();
     }
+    notifyWaitingRequests();
 }
 
 void SessionManager::checkTimer()
 {
-    if (!sessions.empty() && !timerAdded) {
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (sessionCount > 0 && !timerAdded) {
         timer->addTimerSubscriber(this, SESSION_TIMEOUT_CHECK_INTERVAL);
         timerAdded = true;
-    } else if (sessions.empty() && timerAdded) {
+    } else if (sessionCount == 0 && timerAdded) {
         timer->removeTimerSubscriber(this);
         timerAdded = false;
     }
@@ -230,23 +351,33 @@ void SessionManager::checkTimer()
 
 void SessionManager::timerNotify(std::shared_ptr<Timer::Parameter> parameter)
 {
-    log_debug("notified... {} web sessions.", sessions.size());
-
-    AutoLock lock(mutex);
+    log_debug("notified... {} web sessions.", sessionCount);
 
     struct timespec now;
     getTimespecNow(&now);
 
-    for (auto it = sessions.begin(); it != sessions.end(); /*++it*/) {
-        auto& session = *it;
-
-        if (getDeltaMillis(session->getLastAccessTime(), &now) > 1000 * session->getTimeout()) {
-            log_debug("session timeout: {} - diff: {}", session->getID().c_str(), getDeltaMillis(session->getLastAccessTime(), &now));
-            it = sessions.erase(it);
-            checkTimer();
-        } else
-            ++it;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<std::string> expired;
+        for (const auto& entry : *shard.sessions) {
+            auto& session = entry.second;
+            if (getDeltaMillis(session->getLastAccessTime(), &now) > 1000 * session->getTimeout()) {
+                log_debug("session timeout: {} - diff: {}", session->getID().c_str(), getDeltaMillis(session->getLastAccessTime(), &now));
+                session->interrupt();
+                expired.push_back(entry.first);
+            }
+        }
+        if (expired.empty())
+            continue;
+
+        modifyShard(shard, [&](SessionMap& sessions) {
+            for (const auto& sessionID : expired)
+                sessions.erase(sessionID);
+        });
+        sessionCount -= expired.size();
+        notifyWaitingRequests();
     }
+    checkTimer();
 }
 
 } // namespace web
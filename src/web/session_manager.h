@@ -32,10 +32,15 @@
 #ifndef __SESSION_MANAGER_H__
 #define __SESSION_MANAGER_H__
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
+#include "util/lock_free_queue.h"
 #include "util/timer.h"
 
 // forward declaration
@@ -91,6 +96,12 @@ public:
 
     void clearUpdateIDs();
 
+    /// \brief Ends the requests waiting for ui update ids of the session,
+    /// later ones return right away. Used when the session ends.
+    void interrupt();
+
+    bool isInterrupted();
+
 protected:
     /// \brief Is called by SessionManager if UI update is needed
     /// \param objectID the container that needs to be updated
@@ -98,6 +109,14 @@ protected:
 
     void containerChangedUI(const std::vector<int>& objectIDs);
 
+    /// \brief Makes the UI reload every container, used when more changes
+    /// happened than could be remembered
+    void containerChangedUI();
+
+    /// \brief Maximum number of containers remembered until the UI has to
+    /// reload every container
+    static constexpr size_t MAX_UI_UPDATE_IDS = 10;
+
     std::recursive_mutex mutex;
     using AutoLock = std::lock_guard<decltype(mutex)>;
     std::map<std::string, std::string> dict;
@@ -106,7 +125,9 @@ protected:
     /// the UI shall update every container
     bool updateAll;
 
-    std::shared_ptr<std::unordered_set<int>> uiUpdateIDs;
+    /// \brief Changed containers, the first uiUpdateIDCount entries are used
+    std::array<int, MAX_UI_UPDATE_IDS> uiUpdateIDs;
+    size_t uiUpdateIDCount;
 
     /// \brief maximum time the session can be idle (starting from last_access)
     long timeout;
@@ -119,25 +140,70 @@ protected:
 
     bool loggedIn;
 
+    bool interrupted;
+
     friend class SessionManager;
 };
 
 /// \brief This class offers ways to create new sessoins, stores all available sessions and provides access to them.
+///
+/// Sessions are spread over shards by the hash of their ID. Each shard holds
+/// an immutable map which is replaced when a session is added or removed, so
+/// looking up a session only loads the map of its shard.
+///
+/// Container changes are queued without taking a lock and only wake up the
+/// requests waiting for them, so the import does not wait for web requests.
+/// The requests asking for update ids hand the queued changes to the
+/// sessions.
 class SessionManager : public Timer::Subscriber {
 protected:
     std::shared_ptr<Timer> timer;
 
-    std::mutex mutex;
-    using AutoLock = std::lock_guard<decltype(mutex)>;
+    using SessionMap = std::unordered_map<std::string, std::shared_ptr<Session>>;
 
-    /// \brief This array is holding available sessions.
-    std::vector<std::shared_ptr<Session>> sessions;
+    struct Shard {
+        /// \brief Serializes changes to the shard, not needed for reading
+        std::mutex mutex;
+        std::shared_ptr<const SessionMap> sessions;
+    };
+
+    static constexpr size_t SESSION_SHARDS = 16;
+    std::array<Shard, SESSION_SHARDS> shards;
+    std::atomic<size_t> sessionCount;
+
+    Shard& getShard(const std::string& sessionID);
+
+    /// \brief Replaces the session map of the shard by a modified copy,
+    /// has to be called with the shard locked
+    template <typename F>
+    void modifyShard(Shard& shard, F modify);
 
     std::map<std::string, std::string> accounts;
 
+    std::mutex timerMutex;
     void checkTimer();
     bool timerAdded;
 
+    /// \brief Container changes not yet handed to the sessions
+    LockFreeQueue<int> uiUpdateQueue;
+    /// \brief Set when uiUpdateQueue was full, every container has to be reloaded
+    std::atomic<bool> uiUpdateOverflow;
+    std::mutex dispatchMutex;
+    /// \brief Counts the queued changes, waiting requests compare it to
+    /// notice new ones
+    std::atomic<unsigned long> uiUpdateSequence;
+
+    /// \brief Wakes up the requests waiting in waitForUIUpdateIDs(), the
+    /// mutex is only held to check for changes before waiting
+    std::mutex waitMutex;
+    std::condition_variable waitCond;
+    void notifyWaitingRequests();
+
+    /// \brief Number of requests blocked in waitForUIUpdateIDs()
+    std::atomic<int> waitingRequests;
+    int maxWaitingRequests;
+    std::atomic<bool> shutdownFlag;
+
 public:
     /// \brief Constructor, initializes the array.
     SessionManager(const std::shared_ptr<ConfigManager>& config, std::shared_ptr<Timer> timer);
@@ -150,7 +216,7 @@ public:
     /// \brief Returns the instance to a Session with a given sessionID
     /// \param ID of the Session.
     /// \return intance of the Session with a given ID or nullptr if no session with that ID was found.
-    std::shared_ptr<Session> getSession(const std::string& sessionID, bool doLock = true);
+    std::shared_ptr<Session> getSession(const std::string& sessionID);
 
     /// \brief Removes a session
     void removeSession(const std::string& sessionID);
@@ -165,6 +231,21 @@ public:
 
     void containerChangedUI(const std::vector<int>& objectIDs);
 
+    /// \brief Hands the queued container changes to the logged in sessions,
+    /// has to be called by the request before reading the update ids of a session.
+    void dispatchUIUpdates();
+
+    /// \brief Blocks the request until the session gets ui update ids or
+    /// the timeout expires.
+    ///
+    /// Each waiting request occupies a web server thread, so only a
+    /// limited number of requests waits at the same time.
+    /// \return false if the request did not wait because the limit is reached
+    bool waitForUIUpdateIDs(const std::shared_ptr<Session>& session, std::chrono::milliseconds timeout);
+
+    /// \brief Wakes up all waiting requests, called when the server shuts down.
+    void shutdown();
+
     virtual void timerNotify(std::shared_ptr<Timer::Parameter> parameter) override;
 };
 
@@ -0,0 +1,61 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    streams.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file streams.cc
+
+#include <utility>
+
+#include "common.h"
+#include "content_manager.h"
+#include "pages.h"
+#include "util/bandwidth_shaper.h"
+
+web::streams::streams(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
+    std::shared_ptr<ContentManager> content, std::shared_ptr<SessionManager> sessionManager)
+    : WebRequestHandler(std::move(config), std::move(storage), std::move(content), std::move(sessionManager))
+{
+}
+
+void web::streams::process()
+{
+    check_request();
+
+    auto shaper = content->getBandwidthShaper();
+    auto root = xmlDoc->document_element();
+    auto streamsEl = root.append_child("streams");
+    streamsEl.append_attribute("total-rate") = static_cast<long long>(shaper->getTotalRate());
+    streamsEl.append_attribute("client-rate") = static_cast<long long>(shaper->getClientRate());
+    xml2JsonHints->setArrayName(streamsEl, "stream");
+
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& stats : shaper->getStreamStats()) {
+        auto streamEl = streamsEl.append_child("stream");
+        streamEl.append_attribute("id") = stats.id;
+        streamEl.append_attribute("client") = stats.client.c_str();
+        streamEl.append_attribute("name") = stats.name.c_str();
+        streamEl.append_attribute("bytes") = static_cast<long long>(stats.bytes);
+        streamEl.append_attribute("elapsed") = static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(now - stats.started).count());
+        streamEl.append_attribute("rate") = static_cast<long long>(stats.rate);
+    }
+}
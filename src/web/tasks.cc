@@ -48,15 +48,15 @@ void web::tasks::process()
     if (!string_ok(action))
         throw std::runtime_error("web:tasks called with illegal action");
 
-    auto root = xmlDoc->document_element();
-
     if (action == "list") {
-        auto tasksEl = root.append_child("tasks");
-        xml2JsonHints->setArrayName(tasksEl, "tasks");
+        writer->beginObject("tasks");
+        writer->beginArray("task");
         auto taskList = content->getTasklist();
         for (const auto& i : taskList) {
-            appendTask(i, &tasksEl);
+            appendTask(i, writer.get());
         }
+        writer->endArray();
+        writer->endObject();
     } else if (action == "cancel") {
         int taskID = intParam("task_id");
         content->invalidateTask(taskID);
@@ -0,0 +1,59 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    transcoding.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file transcoding.cc
+
+#include <utility>
+
+#include "common.h"
+#include "content_manager.h"
+#include "pages.h"
+#include "transcoding/transcode_scheduler.h"
+
+web::transcoding::transcoding(std::shared_ptr<ConfigManager> config, std::shared_ptr<Storage> storage,
+    std::shared_ptr<ContentManager> content, std::shared_ptr<SessionManager> sessionManager)
+    : WebRequestHandler(std::move(config), std::move(storage), std::move(content), std::move(sessionManager))
+{
+}
+
+void web::transcoding::process()
+{
+    check_request();
+
+    auto scheduler = content->getTranscodeScheduler();
+    auto root = xmlDoc->document_element();
+    auto transcodingEl = root.append_child("transcoding");
+    transcodingEl.append_attribute("queue") = scheduler->getQueueDepth();
+
+    auto jobsEl = transcodingEl.append_child("jobs");
+    xml2JsonHints->setArrayName(jobsEl, "job");
+    for (const auto& job : scheduler->getJobs()) {
+        auto jobEl = jobsEl.append_child("job");
+        jobEl.append_attribute("id") = job->getID();
+        jobEl.append_attribute("profile") = job->getProfileName().c_str();
+        jobEl.append_attribute("bytes") = static_cast<long long>(job->getBytes());
+        jobEl.append_attribute("elapsed") = static_cast<long long>(job->getElapsed().count());
+        jobEl.append_attribute("throughput") = static_cast<long long>(job->getThroughput());
+    }
+}
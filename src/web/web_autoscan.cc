@@ -65,21 +65,20 @@ void web::autoscan::process()
             path = hex_decode_string(objID);
     }
 
-    auto root = xmlDoc->document_element();
-
     if (action == "as_edit_load") {
-        auto autoscan = root.append_child("autoscan");
+        writer->beginObject("autoscan");
         if (fromFs) {
-            autoscan.append_child("from_fs").append_child(pugi::node_pcdata).set_value("1");
-            autoscan.append_child("object_id").append_child(pugi::node_pcdata).set_value(objID.c_str());
+            writer->add("from_fs", 1);
+            writer->add("object_id", objID);
             std::shared_ptr<AutoscanDirectory> adir = content->getAutoscanDirectory(path);
-            autoscan2XML(adir, &autoscan);
+            writeAutoscan(adir, writer.get());
         } else {
-            autoscan.append_child("from_fs").append_child(pugi::node_pcdata).set_value("0");
-            autoscan.append_child("object_id").append_child(pugi::node_pcdata).set_value(objID.c_str());
+            writer->add("from_fs", 0);
+            writer->add("object_id", intParam("object_id"));
             std::shared_ptr<AutoscanDirectory> adir = storage->getAutoscanDirectory(intParam("object_id"));
-            autoscan2XML(adir, &autoscan);
+            writeAutoscan(adir, writer.get());
         }
+        writer->endObject();
     } else if (action == "as_edit_save") {
         std::string scan_mode_str = param("scan_mode");
         if (scan_mode_str == "none") {
@@ -136,37 +135,39 @@ void web::autoscan::process()
 
         // ---
 
-        auto autoscansEl = root.append_child("autoscans");
-        xml2JsonHints->setArrayName(autoscansEl, "autoscan");
+        writer->beginObject("autoscans");
+        writer->beginArray("autoscan");
         for (const auto& autoscanDir : autoscanList) {
-            auto autoscanEl = autoscansEl.append_child("autoscan");
-            autoscanEl.append_attribute("objectID") = autoscanDir->getObjectID();
-
-            autoscanEl.append_child("location").append_child(pugi::node_pcdata).set_value(autoscanDir->getLocation().c_str());
-            autoscanEl.append_child("scan_mode").append_child(pugi::node_pcdata).set_value(AutoscanDirectory::mapScanmode(autoscanDir->getScanMode()).c_str());
-            autoscanEl.append_child("from_config").append_child(pugi::node_pcdata).set_value(autoscanDir->persistent() ? "1" : "0");
-            //autoscanEl.append_child("scan_level").append_child(pugi::node_pcdata)
-            //    .set_value(AutoscanDirectory::mapScanlevel(autoscanDir->getScanLevel()).c_str());
+            writer->beginObject();
+            writer->add("objectID", autoscanDir->getObjectID());
+
+            writer->add("location", autoscanDir->getLocation());
+            writer->add("scan_mode", AutoscanDirectory::mapScanmode(autoscanDir->getScanMode()));
+            writer->add("from_config", autoscanDir->persistent() ? 1 : 0);
+            //writer->add("scan_level", AutoscanDirectory::mapScanlevel(autoscanDir->getScanLevel()));
+            writer->endObject();
         }
+        writer->endArray();
+        writer->endObject();
     } else
         throw std::runtime_error("web:autoscan called with illegal action");
 }
 
-void web::autoscan::autoscan2XML(const std::shared_ptr<AutoscanDirectory>& adir, pugi::xml_node* element)
+void web::autoscan::writeAutoscan(const std::shared_ptr<AutoscanDirectory>& adir, ResponseWriter* writer)
 {
     if (adir == nullptr) {
-        element->append_child("scan_mode").append_child(pugi::node_pcdata).set_value("none");
-        element->append_child("scan_level").append_child(pugi::node_pcdata).set_value("full");
-        element->append_child("recursive").append_child(pugi::node_pcdata).set_value("0");
-        element->append_child("hidden").append_child(pugi::node_pcdata).set_value("0");
-        element->append_child("interval").append_child(pugi::node_pcdata).set_value("1800");
-        element->append_child("persistent").append_child(pugi::node_pcdata).set_value("0");
+        writer->add("scan_mode", "none");
+        writer->add("scan_level", "full");
+        writer->add("recursive", 0);
+        writer->add("hidden", 0);
+        writer->add("interval", 1800);
+        writer->add("persistent", 0);
     } else {
-        element->append_child("scan_mode").append_child(pugi::node_pcdata).set_value(AutoscanDirectory::mapScanmode(adir->getScanMode()).c_str());
-        element->append_child("scan_level").append_child(pugi::node_pcdata).set_value(AutoscanDirectory::mapScanlevel(adir->getScanLevel()).c_str());
-        element->append_child("recursive").append_child(pugi::node_pcdata).set_value(adir->getRecursive() ? "1" : "0");
-        element->append_child("hidden").append_child(pugi::node_pcdata).set_value(adir->getHidden() ? "1" : "0");
-        element->append_child("interval").append_child(pugi::node_pcdata).set_value(std::to_string(adir->getInterval()).c_str());
-        element->append_child("persistent").append_child(pugi::node_pcdata).set_value(adir->persistent() ? "1" : "0");
+        writer->add("scan_mode", AutoscanDirectory::mapScanmode(adir->getScanMode()));
+        writer->add("scan_level", AutoscanDirectory::mapScanlevel(adir->getScanLevel()));
+        writer->add("recursive", adir->getRecursive() ? 1 : 0);
+        writer->add("hidden", adir->getHidden() ? 1 : 0);
+        writer->add("interval", static_cast<int>(adir->getInterval()));
+        writer->add("persistent", adir->persistent() ? 1 : 0);
     }
 }
@@ -134,6 +134,23 @@ std::unique_ptr<IOHandler> WebRequestHandler::open(enum UpnpOpenFileMode mode)
 
     xml2JsonHints = std::make_shared<Xml2Json::Hints>();
 
+    std::string returnType = param("return_type");
+    bool xmlRequested = string_ok(returnType) && returnType == "xml";
+    bool useXml = xmlRequested;
+    if (useXml)
+        writer = std::make_unique<XmlResponseWriter>(root, xml2JsonHints);
+    else
+        writer = std::make_unique<JsonResponseWriter>();
+
+    // pages which still populate xmlDoc directly get the rest of their
+    // response there as well and are converted by Xml2Json
+    auto switchToXmlDoc = [&]() {
+        if (!useXml && (root.first_child() || root.first_attribute())) {
+            useXml = true;
+            writer = std::make_unique<XmlResponseWriter>(root, xml2JsonHints);
+        }
+    };
+
     std::string error;
     int error_code = 0;
 
@@ -146,12 +163,13 @@ std::unique_ptr<IOHandler> WebRequestHandler::open(enum UpnpOpenFileMode mode)
             error_code = 900;
         } else {
             process();
+            switchToXmlDoc();
 
             if (checkRequestCalled) {
-                // add current task
-                appendTask(content->getCurrentTask(), &root);
-
                 handleUpdateIDs();
+
+                // add current task, after waiting for updates
+                appendTask(content->getCurrentTask(), writer.get());
             }
         }
     } catch (const LoginException& e) {
@@ -171,23 +189,28 @@ std::unique_ptr<IOHandler> WebRequestHandler::open(enum UpnpOpenFileMode mode)
         error_code = 800;
     }
 
+    switchToXmlDoc();
+    writer->endAll();
+
     if (!string_ok(error)) {
-        root.append_attribute("success") = true;
+        writer->add("success", true);
     } else {
-        root.append_attribute("success") = false;
+        writer->add("success", false);
 
-        auto errorEl = root.append_child("error");
-        errorEl.append_attribute("text") = error.c_str();
+        writer->beginObject("error");
+        writer->add("text", error);
 
         if (error_code == 0)
             error_code = 899;
-        errorEl.append_attribute("code") = error_code;
+        writer->add("code", error_code);
+        writer->endObject();
 
         log_warning("Web Error: {} {}", error_code, error);
     }
 
-    std::string returnType = param("return_type");
-    if (string_ok(returnType) && returnType == "xml") {
+    if (!useXml) {
+        output = static_cast<JsonResponseWriter*>(writer.get())->getJson();
+    } else if (xmlRequested) {
 #ifdef TOMBDEBUG
         try {
             // make sure we can generate JSON w/o exceptions
@@ -244,35 +267,49 @@ void WebRequestHandler::handleUpdateIDs()
     // session will be filled by check_request
     std::string updates = param("updates");
     if (string_ok(updates)) {
-        auto root = xmlDoc->document_element();
-        auto updateIDs = root.append_child("update_ids");
+        writer->beginObject("update_ids");
+        sessionManager->dispatchUIUpdates();
 
         if (updates == "check") {
-            updateIDs.append_attribute("pending") = session->hasUIUpdateIDs();
+            writer->add("pending", session->hasUIUpdateIDs());
         } else if (updates == "get") {
-            addUpdateIDs(session, &updateIDs);
+            addUpdateIDs(session, writer.get());
+        } else if (updates == "wait") {
+            // answered when a container changes, or right away if too
+            // many requests wait already
+            auto timeout = std::chrono::seconds(config->getIntOption(CFG_SERVER_UI_LONG_POLL_TIMEOUT));
+            if (timeout.count() > 0 && sessionManager->waitForUIUpdateIDs(session, timeout)) {
+                if (!addUpdateIDs(session, writer.get()))
+                    writer->add("updates", false);
+            } else {
+                writer->add("pending", session->hasUIUpdateIDs());
+            }
         }
+        writer->endObject();
     }
 }
 
-void WebRequestHandler::addUpdateIDs(const std::shared_ptr<Session>& session, pugi::xml_node* updateIDsEl)
+bool WebRequestHandler::addUpdateIDs(const std::shared_ptr<Session>& session, ResponseWriter* writer)
 {
     std::string updateIDs = session->getUIUpdateIDs();
-    if (string_ok(updateIDs)) {
-        log_debug("UI: sending update ids: {}", updateIDs.c_str());
-        updateIDsEl->append_attribute("ids") = updateIDs.c_str();
-        updateIDsEl->append_attribute("updates") = true;
-    }
+    if (!string_ok(updateIDs))
+        return false;
+
+    log_debug("UI: sending update ids: {}", updateIDs.c_str());
+    writer->add("ids", updateIDs);
+    writer->add("updates", true);
+    return true;
 }
 
-void WebRequestHandler::appendTask(const std::shared_ptr<GenericTask>& task, pugi::xml_node* parent)
+void WebRequestHandler::appendTask(const std::shared_ptr<GenericTask>& task, ResponseWriter* writer)
 {
-    if (task == nullptr || parent == nullptr)
+    if (task == nullptr || writer == nullptr)
         return;
-    auto taskEl = parent->append_child("task");
-    taskEl.append_attribute("id") = task->getID();
-    taskEl.append_attribute("cancellable") = task->isCancellable();
-    taskEl.append_attribute("text") = task->getDescription().c_str();
+    writer->beginObject("task");
+    writer->add("id", static_cast<int>(task->getID()));
+    writer->add("cancellable", task->isCancellable());
+    writer->add("text", task->getDescription());
+    writer->endObject();
 }
 
 std::string WebRequestHandler::mapAutoscanType(int type)
@@ -40,6 +40,7 @@
 #include "session_manager.h"
 #include "util/generic_task.h"
 #include "util/xml_to_json.h"
+#include "web/response_writer.h"
 
 // forward declaration
 class ContentManager;
@@ -88,6 +89,10 @@ protected:
     /// \brief Hints for Xml2Json, such that we know when to create an array
     std::shared_ptr<Xml2Json::Hints> xml2JsonHints;
 
+    /// \brief The response to be populated by process() method, streamed as
+    /// JSON unless xml is requested, then it writes to xmlDoc.
+    std::unique_ptr<ResponseWriter> writer;
+
     /// \brief The current session, used for this request; will be filled by
     /// check_request()
     std::shared_ptr<Session> session;
@@ -118,20 +123,21 @@ protected:
     /// \todo Genych, chto tut proishodit, ya tolkom che to ne wrubaus??
     std::unique_ptr<IOHandler> open(enum UpnpOpenFileMode mode);
 
-    /// \brief add the ui update ids from the given session as xml tags to the given root element
+    /// \brief add the ui update ids from the given session to the open update_ids object
     /// \param session the session from which the ui update ids should be taken
-    /// \param updateIDsEl the xml element to add the elements to
-    static void addUpdateIDs(const std::shared_ptr<Session>& session, pugi::xml_node* updateIDsEl);
+    /// \param writer the response to add the values to
+    /// \return false if there were no ui update ids
+    static bool addUpdateIDs(const std::shared_ptr<Session>& session, ResponseWriter* writer);
 
     /// \brief check if ui update ids should be added to the response and add
     /// them in that case.
     /// must only be called after check_request
     void handleUpdateIDs();
 
-    /// \brief add the content manager task to the given xml element as xml elements
-    /// \param task the task to add to the given xml element
-    /// \param parent the xml element to add the elements to
-    static void appendTask(const std::shared_ptr<GenericTask>& task, pugi::xml_node* parent);
+    /// \brief add the content manager task to the response as task object
+    /// \param task the task to add to the response
+    /// \param writer the response, the task is added to its open object or array
+    static void appendTask(const std::shared_ptr<GenericTask>& task, ResponseWriter* writer);
 
     /// \brief check if accounts are enabled in the config
     /// \return true if accounts are enabled, false if not
@@ -0,0 +1,196 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    web_callbacks.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file web_callbacks.cc
+
+#include "web_callbacks.h"
+
+#include "iohandler/io_handler.h"
+#include "request_handler.h"
+#include "util/tools.h"
+
+int WebCallbacks::getInfo(const char* filename, UpnpFileInfo* info, const void* cookie, const void** requestCookie)
+{
+    try {
+        auto factory = static_cast<const RequestHandlerFactory*>(cookie);
+        auto reqHandler = factory->createRequestHandler(filename);
+        reqHandler->getInfo(filename, info);
+        auto requestToken = factory->keepRequestState(filename, reqHandler.get());
+        if (requestCookie != nullptr)
+            *requestCookie = reinterpret_cast<const void*>(requestToken);
+    } catch (const ServerShutdownException& se) {
+        return -1;
+    } catch (const SubtitlesNotFoundException& sex) {
+        log_warning("{}", sex.what());
+        return -1;
+    } catch (const TranscodingBusyException& tbe) {
+        log_warning("{}", tbe.what());
+        return -1;
+    } catch (const std::runtime_error& e) {
+        log_error("{}", e.what());
+        return -1;
+    }
+    return 0;
+}
+
+UpnpWebFileHandle WebCallbacks::open(const char* filename, enum UpnpOpenFileMode mode, const void* cookie, const void* requestCookie)
+{
+    std::string link = urlUnescape(filename);
+
+    try {
+        auto requestToken = reinterpret_cast<std::uintptr_t>(requestCookie);
+        auto reqHandler = static_cast<const RequestHandlerFactory*>(cookie)->createRequestHandler(filename, requestToken, true);
+        auto ioHandler = reqHandler->open(link.c_str(), mode, "");
+        auto ioPtr = static_cast<UpnpWebFileHandle>(ioHandler.release());
+        //log_debug("%p open({})", ioPtr, filename);
+        return ioPtr;
+    } catch (const ServerShutdownException& se) {
+        return nullptr;
+    } catch (const SubtitlesNotFoundException& sex) {
+        log_info("SubtitlesNotFoundException: {}", sex.what());
+        return nullptr;
+    } catch (const TranscodingBusyException& tbe) {
+        log_warning("{}", tbe.what());
+        return nullptr;
+    } catch (const std::runtime_error& ex) {
+        log_error("Exception: {}", ex.what());
+        return nullptr;
+    }
+}
+
+int WebCallbacks::read(UpnpWebFileHandle f, char* buf, size_t length, const void* cookie)
+{
+    //log_debug("%p read({})", f, length);
+    if (static_cast<const RequestHandlerFactory*>(cookie)->getShutdownStatus())
+        return -1;
+
+    auto handler = static_cast<IOHandler*>(f);
+    return handler->read(buf, length);
+}
+
+int WebCallbacks::write(UpnpWebFileHandle f, char* buf, size_t length, const void* cookie)
+{
+    //log_debug("%p write({})", f, length);
+    return 0;
+}
+
+int WebCallbacks::seek(UpnpWebFileHandle f, off_t offset, int whence, const void* cookie)
+{
+    //log_debug("%p seek({}, {})", f, offset, whence);
+    try {
+        auto handler = static_cast<IOHandler*>(f);
+        handler->seek(offset, whence);
+    } catch (const std::runtime_error& e) {
+        log_error("Exception during seek: {}", e.what());
+        return -1;
+    }
+
+    return 0;
+}
+
+int WebCallbacks::close(UpnpWebFileHandle f, const void* cookie)
+{
+    int ret_close = 0;
+    //log_debug("%p close()", f);
+    auto handler = static_cast<IOHandler*>(f);
+    try {
+        handler->close();
+    } catch (const std::runtime_error& e) {
+        log_error("Exception during close: {}", e.what());
+        ret_close = -1;
+    }
+
+    delete handler;
+    handler = nullptr;
+
+    return ret_close;
+}
+
+int WebCallbacks::registerCallbacks()
+{
+    log_debug("Setting UpnpVirtualDir GetInfoCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    int ret = UpnpVirtualDir_set_GetInfoCallback(getInfo);
+#else
+    int ret = UpnpVirtualDir_set_GetInfoCallback([](const char* filename, UpnpFileInfo* info, const void* cookie) -> int {
+        return getInfo(filename, info, cookie, nullptr);
+    });
+#endif
+    if (ret != 0)
+        return ret;
+
+    log_debug("Setting UpnpVirtualDir OpenCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    ret = UpnpVirtualDir_set_OpenCallback(open);
+#else
+    ret = UpnpVirtualDir_set_OpenCallback([](const char* filename, enum UpnpOpenFileMode mode, const void* cookie) -> UpnpWebFileHandle {
+        return open(filename, mode, cookie, nullptr);
+    });
+#endif
+    if (ret != UPNP_E_SUCCESS)
+        return ret;
+
+    log_debug("Setting UpnpVirtualDir ReadCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    ret = UpnpVirtualDir_set_ReadCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie, const void* requestCookie) -> int {
+        return read(f, buf, length, cookie);
+    });
+#else
+    ret = UpnpVirtualDir_set_ReadCallback(read);
+#endif
+    if (ret != UPNP_E_SUCCESS)
+        return ret;
+
+    log_debug("Setting UpnpVirtualDir WriteCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    ret = UpnpVirtualDir_set_WriteCallback([](UpnpWebFileHandle f, char* buf, size_t length, const void* cookie, const void* requestCookie) -> int {
+        return write(f, buf, length, cookie);
+    });
+#else
+    ret = UpnpVirtualDir_set_WriteCallback(write);
+#endif
+    if (ret != UPNP_E_SUCCESS)
+        return ret;
+
+    log_debug("Setting UpnpVirtualDir SeekCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    ret = UpnpVirtualDir_set_SeekCallback([](UpnpWebFileHandle f, off_t offset, int whence, const void* cookie, const void* requestCookie) -> int {
+        return seek(f, offset, whence, cookie);
+    });
+#else
+    ret = UpnpVirtualDir_set_SeekCallback(seek);
+#endif
+    if (ret != UPNP_E_SUCCESS)
+        return ret;
+
+    log_debug("Setting UpnpVirtualDir CloseCallback");
+#ifdef UPNP_HAS_REQUEST_COOKIES
+    UpnpVirtualDir_set_CloseCallback([](UpnpWebFileHandle f, const void* cookie, const void* requestCookie) -> int {
+        return close(f, cookie);
+    });
+#else
+    UpnpVirtualDir_set_CloseCallback(close);
+#endif
+
+    return ret;
+}
@@ -0,0 +1,91 @@
+/*GRB*
+
+Gerbera - https://gerbera.io/
+
+    web_callbacks.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file web_callbacks.h
+/// \brief Definition of the WebCallbacks class.
+#ifndef __WEB_CALLBACKS_H__
+#define __WEB_CALLBACKS_H__
+
+#include <cstdint>
+#include <memory>
+#include <upnp.h>
+
+#include "common.h"
+
+// forward declaration
+class RequestHandler;
+
+/// \brief Creates the handlers for requests to the virtual directory of the
+/// web server.
+///
+/// Implemented by the Server, the benchmarks use a synthetic library instead.
+class RequestHandlerFactory {
+public:
+    virtual ~RequestHandlerFactory() = default;
+
+    /// \brief Creates the handler for a request.
+    /// \param filename Incoming filename.
+    /// \param requestToken Request cookie set by GetInfo, 0 if there is none.
+    /// \param reuseState Take over the state resolved by GetInfo for the request.
+    virtual std::unique_ptr<RequestHandler> createRequestHandler(const char* filename, std::uintptr_t requestToken = 0, bool reuseState = false) const = 0;
+
+    /// \brief Keeps the state resolved by handler->getInfo() for the following Open.
+    /// \return token to be stored in the request cookie, 0 if nothing was kept
+    virtual std::uintptr_t keepRequestState(const char* filename, RequestHandler* handler) const = 0;
+
+    /// \brief Tells if the server is about to be terminated.
+    virtual bool getShutdownStatus() const = 0;
+};
+
+/// \brief Callback functions of the internal web server.
+///
+/// The cookie of all callbacks is the RequestHandlerFactory passed to
+/// UpnpAddVirtualDir(). The request cookie carries the token of
+/// keepRequestState() from getInfo() to open(), it is always empty if
+/// libupnp does not support request cookies.
+class WebCallbacks {
+public:
+    /// \brief Query information on a file.
+    static int getInfo(const char* filename, UpnpFileInfo* info, const void* cookie, const void** requestCookie);
+
+    /// \brief Open a file.
+    static UpnpWebFileHandle open(const char* filename, enum UpnpOpenFileMode mode, const void* cookie, const void* requestCookie);
+
+    /// \brief Sequentially read from a file.
+    static int read(UpnpWebFileHandle f, char* buf, size_t length, const void* cookie);
+
+    /// \brief Sequentially write to a file (not supported).
+    static int write(UpnpWebFileHandle f, char* buf, size_t length, const void* cookie);
+
+    /// \brief Perform a seek on a file.
+    static int seek(UpnpWebFileHandle f, off_t offset, int whence, const void* cookie);
+
+    /// \brief Close file.
+    static int close(UpnpWebFileHandle f, const void* cookie);
+
+    /// \brief Registers the callback functions with the internal web server.
+    /// \return UPNP_E_SUCCESS Callbacks registered successfully, else error code.
+    static int registerCallbacks();
+};
+
+#endif // __WEB_CALLBACKS_H__
@@ -0,0 +1,41 @@
+#ifndef __TEST_TEMP_DIR_H__
+#define __TEST_TEMP_DIR_H__
+
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// unique directory in the system temp directory, removed with its contents
+class ScopedTempDir {
+public:
+    explicit ScopedTempDir(const std::string& prefix = "gerbera-test")
+    {
+        std::string name = (fs::temp_directory_path() / (prefix + "-XXXXXX")).string();
+        std::vector<char> buf(name.begin(), name.end());
+        buf.push_back('\0');
+        if (mkdtemp(buf.data()) == nullptr)
+            throw std::runtime_error("Failed to create temporary directory " + name);
+        dir = buf.data();
+    }
+
+    ~ScopedTempDir()
+    {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    ScopedTempDir(const ScopedTempDir&) = delete;
+    ScopedTempDir& operator=(const ScopedTempDir&) = delete;
+
+    const fs::path& path() const { return dir; }
+    fs::path operator/(const std::string& name) const { return dir / name; }
+
+private:
+    fs::path dir;
+};
+
+#endif // __TEST_TEMP_DIR_H__
@@ -0,0 +1,123 @@
+#ifndef __TEST_TEST_SERVER_H__
+#define __TEST_TEST_SERVER_H__
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <ExtraHeaders.h>
+#include <pugixml.hpp>
+#include <upnp.h>
+
+#include "config/config_generator.h"
+#include "config/config_manager.h"
+#include "content_manager.h"
+#include "server.h"
+#include "web_callbacks.h"
+
+#include "helpers/temp_dir.h"
+
+// Server with a generated configuration and its database in a temporary
+// directory. libupnp is not started, requests are made by calling the web
+// server callbacks the way libupnp does.
+class TestServer {
+public:
+    /// \param configure changes the generated configuration before it is loaded
+    explicit TestServer(const std::function<void(pugi::xml_node& root)>& configure = nullptr)
+        : home("gerbera-server")
+    {
+        fs::create_directory(home / "web");
+        fs::create_directory(home / "js");
+        for (auto name : { "common.js", "import.js", "playlists.js" })
+            std::ofstream(home.path() / "js" / name);
+        fs::create_directory(home / ".config");
+
+        ConfigGenerator generator;
+        pugi::xml_document doc;
+        doc.load_string(generator.generate(home.path(), ".config", home.path(), "").c_str());
+        if (configure) {
+            auto root = doc.document_element();
+            configure(root);
+        }
+        fs::path configFile = home.path() / ".config" / "config.xml";
+        std::ofstream file(configFile);
+        doc.save(file, "  ");
+        file.close();
+
+        config = std::make_shared<ConfigManager>(configFile, home.path(), ".config", home.path(), "", "", "", 0, false);
+        server = std::make_shared<Server>(config);
+        server->init();
+        server->getContent()->run();
+    }
+
+    ~TestServer()
+    {
+        server->shutdown();
+    }
+
+    TestServer(const TestServer&) = delete;
+    TestServer& operator=(const TestServer&) = delete;
+
+    const fs::path& getHome() const { return home.path(); }
+
+    std::shared_ptr<ConfigManager> getConfig() const { return config; }
+
+    /// \brief Imports a file like a scan does.
+    /// \return object id of the item
+    int addFile(const fs::path& path)
+    {
+        return server->getContent()->addFile(path, false, false);
+    }
+
+    /// \brief Cookie handed to the web server callbacks.
+    const void* getCookie() const { return static_cast<const RequestHandlerFactory*>(server.get()); }
+
+private:
+    ScopedTempDir home;
+    std::shared_ptr<ConfigManager> config;
+    std::shared_ptr<Server> server;
+};
+
+// headers of a web server request and the response header lines set by GetInfo
+class TestRequestInfo {
+public:
+    explicit TestRequestInfo(const std::map<std::string, std::string>& requestHeaders = {})
+        : info(UpnpFileInfo_new())
+    {
+        auto head = const_cast<UpnpListHead*>(UpnpFileInfo_get_ExtraHeadersList(info));
+        for (const auto& header : requestHeaders) {
+            UpnpExtraHeaders* extra = UpnpExtraHeaders_new();
+            UpnpExtraHeaders_strcpy_name(extra, header.first.c_str());
+            UpnpExtraHeaders_strcpy_value(extra, header.second.c_str());
+            UpnpListInsert(head, UpnpListEnd(head), const_cast<UpnpListHead*>(UpnpExtraHeaders_get_node(extra)));
+        }
+    }
+
+    ~TestRequestInfo() { UpnpFileInfo_delete(info); }
+
+    TestRequestInfo(const TestRequestInfo&) = delete;
+    TestRequestInfo& operator=(const TestRequestInfo&) = delete;
+
+    UpnpFileInfo* get() { return info; }
+
+    /// \brief Returns the value of a response header, empty if it was not set.
+    std::string getResponseHeader(const std::string& name) const
+    {
+        auto head = const_cast<UpnpListHead*>(UpnpFileInfo_get_ExtraHeadersList(info));
+        for (auto pos = UpnpListBegin(head); pos != UpnpListEnd(head); pos = UpnpListNext(head, pos)) {
+            auto extra = reinterpret_cast<UpnpExtraHeaders*>(pos);
+            const char* resp = UpnpExtraHeaders_get_resp(extra);
+            std::string line = resp != nullptr ? resp : "";
+            if (line.compare(0, name.length() + 2, name + ": ") == 0)
+                return line.substr(name.length() + 2);
+        }
+        return "";
+    }
+
+private:
+    UpnpFileInfo* info;
+};
+
+#endif // __TEST_TEST_SERVER_H__
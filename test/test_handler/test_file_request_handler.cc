@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+
+#include "request_handler.h"
+
+#include "helpers/test_server.h"
+
+using namespace ::testing;
+
+class FileRequestHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        media = server.getHome() / "media.bin";
+        for (int i = 0; i < 100000; i++)
+            data += static_cast<char>(i % 251);
+        std::ofstream(media, std::ios::binary) << data;
+
+        struct stat statbuf;
+        ASSERT_EQ(0, stat(media.c_str(), &statbuf));
+        mtime = statbuf.st_mtime;
+
+        objectId = server.addFile(media);
+        url = std::string(LINK_FILE_REQUEST_HANDLER) + URL_OBJECT_ID + "/" + std::to_string(objectId) + "/" + URL_RESOURCE_ID + "/0";
+    }
+
+    // GetInfo, Open and Read until the end, as the web server does for a GET
+    // request; returns what GetInfo returned, 0 is answered with 200
+    int get(TestRequestInfo& info, std::string* body)
+    {
+        const void* requestCookie = nullptr;
+        int ret = WebCallbacks::getInfo(url.c_str(), info.get(), server.getCookie(), &requestCookie);
+        if (ret != 0)
+            return ret;
+
+        UpnpWebFileHandle f = WebCallbacks::open(url.c_str(), UPNP_READ, server.getCookie(), requestCookie);
+        EXPECT_NE(nullptr, f);
+        if (f == nullptr)
+            return ret;
+
+        char buf[16384];
+        int got;
+        while ((got = WebCallbacks::read(f, buf, sizeof(buf), server.getCookie())) > 0)
+            body->append(buf, got);
+        EXPECT_EQ(0, WebCallbacks::close(f, server.getCookie()));
+        return ret;
+    }
+
+    TestServer server;
+    fs::path media;
+    std::string data;
+    time_t mtime;
+    int objectId;
+    std::string url;
+};
+
+TEST_F(FileRequestHandlerTest, ServesFileWithValidators)
+{
+    TestRequestInfo info;
+    std::string body;
+
+    EXPECT_EQ(0, get(info, &body));
+    EXPECT_EQ(data, body);
+    EXPECT_EQ(static_cast<off_t>(data.size()), UpnpFileInfo_get_FileLength(info.get()));
+    EXPECT_EQ(mtime, UpnpFileInfo_get_LastModified(info.get()));
+    EXPECT_EQ(RequestHandler::makeETag(objectId, 0, mtime, data.size()), info.getResponseHeader("ETag"));
+}
+
+// libupnp cannot answer 304 from the virtual directory callbacks, so a
+// conditional request gets the complete response like any other
+TEST_F(FileRequestHandlerTest, ConditionalRequestGetsFullResponse)
+{
+    std::string etag = RequestHandler::makeETag(objectId, 0, mtime, data.size());
+    TestRequestInfo info({ { "If-None-Match", etag }, { "If-Modified-Since", "Fri, 01 Jan 2100 00:00:00 GMT" } });
+    std::string body;
+
+    EXPECT_EQ(0, get(info, &body));
+    EXPECT_EQ(data, body);
+    EXPECT_EQ(static_cast<off_t>(data.size()), UpnpFileInfo_get_FileLength(info.get()));
+    EXPECT_EQ(etag, info.getResponseHeader("ETag"));
+}
+
+TEST_F(FileRequestHandlerTest, UnknownObjectIsNotFound)
+{
+    url = std::string(LINK_FILE_REQUEST_HANDLER) + URL_OBJECT_ID + "/" + std::to_string(objectId + 1000) + "/" + URL_RESOURCE_ID + "/0";
+    TestRequestInfo info;
+    std::string body;
+
+    // GetInfo failing is answered with 404
+    EXPECT_EQ(-1, get(info, &body));
+    EXPECT_TRUE(body.empty());
+}
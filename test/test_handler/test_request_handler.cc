@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include "request_handler.h"
+
+using namespace ::testing;
+
+TEST(RequestHandlerTest, ETagIsQuoted)
+{
+    EXPECT_EQ("\"2a-1-5f5e1000-400\"", RequestHandler::makeETag(42, 1, 0x5f5e1000, 1024));
+}
+
+TEST(RequestHandlerTest, ETagChangesWithEveryPart)
+{
+    auto etag = RequestHandler::makeETag(42, 1, 1600000000, 1024);
+
+    EXPECT_EQ(etag, RequestHandler::makeETag(42, 1, 1600000000, 1024));
+    EXPECT_NE(etag, RequestHandler::makeETag(43, 1, 1600000000, 1024));
+    EXPECT_NE(etag, RequestHandler::makeETag(42, 2, 1600000000, 1024));
+    EXPECT_NE(etag, RequestHandler::makeETag(42, 1, 1600000001, 1024));
+    EXPECT_NE(etag, RequestHandler::makeETag(42, 1, 1600000000, 1025));
+}
@@ -0,0 +1,157 @@
+#ifdef HAVE_LIBJPEG
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <jpeglib.h>
+#include <vector>
+
+#include "helpers/temp_dir.h"
+#include "metadata/image_scale_handler.h"
+
+using namespace ::testing;
+
+class ImageScaleHandlerTest : public ::testing::Test {
+public:
+    ImageScaleHandlerTest()
+        : dir("gerbera-scale")
+        , path(dir / "image.jpg")
+    {
+    }
+
+    void writeJpeg(int width, int height)
+    {
+        std::vector<unsigned char> pixels(width * height * 3);
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++) {
+                auto p = &pixels[(y * width + x) * 3];
+                p[0] = x * 255 / width;
+                p[1] = y * 255 / height;
+                p[2] = 128;
+            }
+
+        FILE* f = fopen(path.c_str(), "wb");
+        struct jpeg_compress_struct cinfo;
+        struct jpeg_error_mgr jerr;
+        cinfo.err = jpeg_std_error(&jerr);
+        jpeg_create_compress(&cinfo);
+        jpeg_stdio_dest(&cinfo, f);
+        cinfo.image_width = width;
+        cinfo.image_height = height;
+        cinfo.input_components = 3;
+        cinfo.in_color_space = JCS_RGB;
+        jpeg_set_defaults(&cinfo);
+        jpeg_start_compress(&cinfo, TRUE);
+        while (cinfo.next_scanline < cinfo.image_height) {
+            JSAMPROW row = &pixels[cinfo.next_scanline * width * 3];
+            jpeg_write_scanlines(&cinfo, &row, 1);
+        }
+        jpeg_finish_compress(&cinfo);
+        jpeg_destroy_compress(&cinfo);
+        fclose(f);
+    }
+
+    static void readSize(const std::string& jpeg, unsigned int& width, unsigned int& height)
+    {
+        struct jpeg_decompress_struct dinfo;
+        struct jpeg_error_mgr jerr;
+        dinfo.err = jpeg_std_error(&jerr);
+        jpeg_create_decompress(&dinfo);
+        jpeg_mem_src(&dinfo, reinterpret_cast<const unsigned char*>(jpeg.data()), jpeg.size());
+        jpeg_read_header(&dinfo, TRUE);
+        width = dinfo.image_width;
+        height = dinfo.image_height;
+        jpeg_destroy_decompress(&dinfo);
+    }
+
+protected:
+    ScopedTempDir dir;
+    fs::path path;
+};
+
+TEST_F(ImageScaleHandlerTest, FitsLandscapeAndPortrait)
+{
+    int width;
+    int height;
+    ImageScaleHandler::fitSize(4000, 3000, 640, 480, width, height);
+    EXPECT_EQ(640, width);
+    EXPECT_EQ(480, height);
+
+    ImageScaleHandler::fitSize(3000, 4000, 160, 160, width, height);
+    EXPECT_EQ(120, width);
+    EXPECT_EQ(160, height);
+
+    ImageScaleHandler::fitSize(100, 50, 160, 160, width, height);
+    EXPECT_EQ(100, width);
+    EXPECT_EQ(50, height);
+}
+
+TEST_F(ImageScaleHandlerTest, KnowsGeneratedProfilesOnly)
+{
+    int width;
+    int height;
+    EXPECT_TRUE(ImageScaleHandler::getProfileSize("JPEG_TN", width, height));
+    EXPECT_EQ(160, width);
+    EXPECT_FALSE(ImageScaleHandler::getProfileSize("PNG_LRG", width, height));
+}
+
+TEST_F(ImageScaleHandlerTest, ScalesIntoBoundingBox)
+{
+    writeJpeg(1000, 750);
+
+    auto result = ImageScaleHandler::scaleJpeg(path, 160, 160, 85);
+
+    unsigned int width;
+    unsigned int height;
+    readSize(result, width, height);
+    EXPECT_EQ(160u, width);
+    EXPECT_EQ(120u, height);
+}
+
+TEST_F(ImageScaleHandlerTest, ScalesByUnevenFactor)
+{
+    // decoded at 6/8 and then fitted
+    writeJpeg(1000, 750);
+
+    auto result = ImageScaleHandler::scaleJpeg(path, 700, 700, 85);
+
+    unsigned int width;
+    unsigned int height;
+    readSize(result, width, height);
+    EXPECT_EQ(700u, width);
+    EXPECT_EQ(525u, height);
+
+    // the gradient survives, the corners keep their colors
+    struct jpeg_decompress_struct dinfo;
+    struct jpeg_error_mgr jerr;
+    dinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&dinfo);
+    jpeg_mem_src(&dinfo, reinterpret_cast<const unsigned char*>(result.data()), result.size());
+    jpeg_read_header(&dinfo, TRUE);
+    jpeg_start_decompress(&dinfo);
+    std::vector<unsigned char> pixels(dinfo.output_width * dinfo.output_height * 3);
+    while (dinfo.output_scanline < dinfo.output_height) {
+        JSAMPROW row = &pixels[dinfo.output_scanline * dinfo.output_width * 3];
+        jpeg_read_scanlines(&dinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&dinfo);
+    jpeg_destroy_decompress(&dinfo);
+
+    auto last = (dinfo.output_height * dinfo.output_width - 1) * 3;
+    EXPECT_NEAR(0, pixels[0], 8);
+    EXPECT_NEAR(0, pixels[1], 8);
+    EXPECT_NEAR(255, pixels[last], 8);
+    EXPECT_NEAR(255, pixels[last + 1], 8);
+    EXPECT_NEAR(128, pixels[last + 2], 8);
+}
+
+TEST_F(ImageScaleHandlerTest, ThrowsOnInvalidImage)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    fputs("not a jpeg", f);
+    fclose(f);
+
+    EXPECT_THROW(ImageScaleHandler::scaleJpeg(path, 160, 160, 85), std::runtime_error);
+}
+
+#endif // HAVE_LIBJPEG
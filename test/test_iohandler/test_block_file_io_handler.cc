@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "helpers/temp_dir.h"
+#include "iohandler/block_file_io_handler.h"
+
+using namespace ::testing;
+
+#define FILE_SIZE (3 * 65536 + 1234)
+
+class BlockFileIOHandlerTest : public ::testing::Test {
+public:
+    BlockFileIOHandlerTest()
+        : dir("gerbera-blockio")
+        , path(dir / "media")
+    {
+        for (int i = 0; i < FILE_SIZE; i++)
+            content += static_cast<char>((i * 7 + i / 251) & 0xff);
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    std::string readAll(IOHandler& handler, size_t chunk)
+    {
+        std::string result;
+        std::vector<char> buf(chunk);
+        size_t ret;
+        while ((ret = handler.read(buf.data(), chunk)) > 0 && ret != static_cast<size_t>(-1))
+            result.append(buf.data(), ret);
+        return result;
+    }
+
+protected:
+    ScopedTempDir dir;
+    fs::path path;
+    std::string content;
+};
+
+TEST_F(BlockFileIOHandlerTest, ReadsWholeFileInSmallChunks)
+{
+    BlockFileIOHandler subject(path, 65536);
+    subject.open(UPNP_READ);
+
+    EXPECT_EQ(content, readAll(subject, 1000));
+    EXPECT_EQ(FILE_SIZE, subject.tell());
+    subject.close();
+}
+
+TEST_F(BlockFileIOHandlerTest, ReadsWholeFileInLargeChunks)
+{
+    BlockFileIOHandler subject(path, 65536);
+    subject.open(UPNP_READ);
+
+    EXPECT_EQ(content, readAll(subject, 2 * 65536 + 17));
+    subject.close();
+}
+
+TEST_F(BlockFileIOHandlerTest, RoundsBlockSizeToPages)
+{
+    BlockFileIOHandler subject(path, 1000);
+    subject.open(UPNP_READ);
+
+    EXPECT_EQ(content, readAll(subject, 4096));
+    subject.close();
+}
+
+TEST_F(BlockFileIOHandlerTest, SeeksWithinAndAcrossBlocks)
+{
+    BlockFileIOHandler subject(path, 65536);
+    subject.open(UPNP_READ);
+    char buf[100];
+
+    subject.seek(70000, SEEK_SET);
+    ASSERT_EQ(100, subject.read(buf, 100));
+    EXPECT_EQ(content.substr(70000, 100), std::string(buf, 100));
+
+    subject.seek(-50, SEEK_CUR);
+    ASSERT_EQ(100, subject.read(buf, 100));
+    EXPECT_EQ(content.substr(70050, 100), std::string(buf, 100));
+
+    subject.seek(10, SEEK_SET);
+    ASSERT_EQ(100, subject.read(buf, 100));
+    EXPECT_EQ(content.substr(10, 100), std::string(buf, 100));
+
+    subject.seek(-30, SEEK_END);
+    EXPECT_EQ(30, subject.read(buf, 100));
+    EXPECT_EQ(content.substr(FILE_SIZE - 30), std::string(buf, 30));
+    EXPECT_EQ(0, subject.read(buf, 100));
+    subject.close();
+}
+
+TEST_F(BlockFileIOHandlerTest, FailsOnMissingFile)
+{
+    BlockFileIOHandler subject(path / "missing", 65536);
+
+    EXPECT_THROW(subject.open(UPNP_READ), std::runtime_error);
+}
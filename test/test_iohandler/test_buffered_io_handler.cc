@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "iohandler/buffered_io_handler.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+// produces byte i as i % 251, optionally paced to a given rate
+class PatternIOHandler : public IOHandler {
+public:
+    PatternIOHandler(size_t size, double bytesPerSecond = 0)
+        : size(size)
+        , bytesPerSecond(bytesPerSecond)
+    {
+        for (size_t i = 0; i < pattern.size(); i++)
+            pattern[i] = static_cast<char>(i % 251);
+    }
+
+    void open(enum UpnpOpenFileMode mode) override { started = std::chrono::steady_clock::now(); }
+
+    size_t read(char* buf, size_t length) override
+    {
+        if (pos >= size)
+            return 0;
+        if (length > size - pos)
+            length = size - pos;
+        if (bytesPerSecond > 0)
+            std::this_thread::sleep_until(started + std::chrono::duration<double>((pos + length) / bytesPerSecond));
+        for (size_t done = 0; done < length;) {
+            size_t chunk = std::min(length - done, pattern.size() - 251);
+            memcpy(buf + done, pattern.data() + (pos + done) % 251, chunk);
+            done += chunk;
+        }
+        pos += length;
+        return length;
+    }
+
+    void seek(off_t offset, int whence) override
+    {
+        pos = (whence == SEEK_SET) ? offset : pos + offset;
+    }
+
+private:
+    size_t size;
+    size_t pos { 0 };
+    double bytesPerSecond;
+    std::chrono::steady_clock::time_point started;
+    std::array<char, 64 * 1024> pattern;
+};
+
+class SeekableBufferedIOHandler : public BufferedIOHandler {
+public:
+    SeekableBufferedIOHandler(std::unique_ptr<IOHandler>& underlyingHandler, size_t bufSize, size_t maxChunkSize, size_t initialFillSize)
+        : BufferedIOHandler(underlyingHandler, bufSize, maxChunkSize, initialFillSize)
+    {
+        seekEnabled = true;
+    }
+};
+
+static bool isPattern(const char* buf, size_t length, size_t pos)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (buf[i] != static_cast<char>((pos + i) % 251))
+            return false;
+    }
+    return true;
+}
+
+TEST(BufferedIOHandlerTest, ReadsEverythingInOrder)
+{
+    const size_t size = 5 * 1024 * 1024 + 17;
+    std::unique_ptr<IOHandler> source = std::make_unique<PatternIOHandler>(size);
+    BufferedIOHandler subject(source, 64 * 1024, 5000, 1024);
+    subject.open(UPNP_READ);
+
+    char buf[7000];
+    size_t pos = 0;
+    size_t bytesRead;
+    while ((bytesRead = subject.read(buf, sizeof(buf))) > 0) {
+        ASSERT_TRUE(isPattern(buf, bytesRead, pos)) << "at " << pos;
+        pos += bytesRead;
+    }
+    EXPECT_EQ(size, pos);
+    subject.close();
+}
+
+TEST(BufferedIOHandlerTest, SeeksWithinAndBeyondBuffer)
+{
+    std::unique_ptr<IOHandler> source = std::make_unique<PatternIOHandler>(1024 * 1024);
+    SeekableBufferedIOHandler subject(source, 16 * 1024, 4096, 8 * 1024);
+    subject.open(UPNP_READ);
+
+    char buf[100];
+    ASSERT_EQ(100u, subject.read(buf, sizeof(buf)));
+    EXPECT_TRUE(isPattern(buf, 100, 0));
+
+    // the initial fill size is in the buffer already
+    subject.seek(1000, SEEK_CUR);
+    ASSERT_EQ(100u, subject.read(buf, sizeof(buf)));
+    EXPECT_TRUE(isPattern(buf, 100, 1100));
+
+    subject.seek(500000, SEEK_SET);
+    ASSERT_EQ(100u, subject.read(buf, sizeof(buf)));
+    EXPECT_TRUE(isPattern(buf, 100, 500000));
+    subject.close();
+}
+
+// run with --gtest_also_run_disabled_tests, reports how often the reader and
+// the buffer thread had to wait for each other
+static void benchmark(double bytesPerSecond)
+{
+    const size_t size = 512 * 1024 * 1024;
+    std::unique_ptr<IOHandler> source = std::make_unique<PatternIOHandler>(size, bytesPerSecond);
+    BufferedIOHandler subject(source, 1024 * 1024, 128 * 1024, 256 * 1024);
+
+    auto started = std::chrono::steady_clock::now();
+    subject.open(UPNP_READ);
+    char buf[16 * 1024];
+    size_t total = 0;
+    size_t bytesRead;
+    while ((bytesRead = subject.read(buf, sizeof(buf))) > 0)
+        total += bytesRead;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    size_t waits = subject.getWaitCount();
+    subject.close();
+
+    EXPECT_EQ(size, total);
+    std::cout << total / (1024 * 1024) << " MiB in " << elapsed.count() << "s, "
+              << (total * 8 / elapsed.count() / 1e6) << " Mbit/s, "
+              << total / sizeof(buf) << " reads, " << waits << " waits" << std::endl;
+}
+
+TEST(BufferedIOHandlerTest, DISABLED_BenchmarkGigabitSource)
+{
+    benchmark(125e6);
+}
+
+TEST(BufferedIOHandlerTest, DISABLED_BenchmarkUnlimitedSource)
+{
+    benchmark(0);
+}
+
+// exposes the read end of a pipe, the test writes to the other end
+class PipeIOHandler : public IOHandler {
+public:
+    PipeIOHandler(int fd, bool cleanEnd = true)
+        : fd(fd)
+        , cleanEnd(cleanEnd)
+    {
+    }
+
+    size_t read(char* buf, size_t length) override { return ::read(fd, buf, length); }
+    void close() override { ::close(fd); }
+    int getFd() override { return fd; }
+    bool endedCleanly() override { return cleanEnd; }
+
+private:
+    int fd;
+    bool cleanEnd;
+};
+
+TEST(BufferedIOHandlerTest, StreamsShareReactorLoop)
+{
+    const size_t size = 3 * 1024 * 1024 + 5;
+    auto reactor = std::make_shared<StreamReactor>(1);
+
+    std::vector<std::unique_ptr<BufferedIOHandler>> subjects;
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++) {
+        int pipeFds[2];
+        ASSERT_EQ(0, pipe(pipeFds));
+        std::unique_ptr<IOHandler> source = std::make_unique<PipeIOHandler>(pipeFds[0]);
+        subjects.push_back(std::make_unique<BufferedIOHandler>(source, 64 * 1024, 4096, 1024, reactor));
+        subjects.back()->open(UPNP_READ);
+        writers.emplace_back([fd = pipeFds[1], size]() {
+            PatternIOHandler pattern(size);
+            char buf[10000];
+            size_t length;
+            while ((length = pattern.read(buf, sizeof(buf))) > 0)
+                ASSERT_EQ(static_cast<ssize_t>(length), ::write(fd, buf, length));
+            ::close(fd);
+        });
+    }
+
+    // read the streams in turns, so their buffers run full
+    char buf[3000];
+    std::vector<size_t> pos(subjects.size(), 0);
+    for (bool done = false; !done;) {
+        done = true;
+        for (size_t i = 0; i < subjects.size(); i++) {
+            size_t bytesRead = subjects[i]->read(buf, sizeof(buf));
+            if (bytesRead > 0 && bytesRead != static_cast<size_t>(CHECK_SOCKET)) {
+                ASSERT_TRUE(isPattern(buf, bytesRead, pos[i])) << "stream " << i << " at " << pos[i];
+                pos[i] += bytesRead;
+                done = false;
+            }
+        }
+    }
+
+    for (auto& writer : writers)
+        writer.join();
+    for (size_t i = 0; i < subjects.size(); i++) {
+        EXPECT_EQ(size, pos[i]);
+        subjects[i]->close();
+    }
+    reactor->shutdown();
+}
+
+// like a transcoder exiting with an error after its output
+TEST(BufferedIOHandlerTest, LoopReportsFailedSourceAtEnd)
+{
+    auto reactor = std::make_shared<StreamReactor>(1);
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe(pipeFds));
+    std::unique_ptr<IOHandler> source = std::make_unique<PipeIOHandler>(pipeFds[0], false);
+    BufferedIOHandler subject(source, 16 * 1024, 4096, 0, reactor);
+    subject.open(UPNP_READ);
+
+    ASSERT_EQ(3, ::write(pipeFds[1], "abc", 3));
+    ::close(pipeFds[1]);
+
+    char buf[100];
+    size_t bytesRead;
+    while ((bytesRead = subject.read(buf, sizeof(buf))) == static_cast<size_t>(CHECK_SOCKET))
+        ;
+    EXPECT_EQ(3u, bytesRead);
+    while ((bytesRead = subject.read(buf, sizeof(buf))) == static_cast<size_t>(CHECK_SOCKET))
+        ;
+    EXPECT_EQ(static_cast<size_t>(-1), bytesRead);
+    subject.close();
+    reactor->shutdown();
+}
+
+TEST(BufferedIOHandlerTest, UnpollableSourceUsesThread)
+{
+    auto reactor = std::make_shared<StreamReactor>(1);
+    std::unique_ptr<IOHandler> source = std::make_unique<PatternIOHandler>(100000);
+    BufferedIOHandler subject(source, 16 * 1024, 4096, 0, reactor);
+    subject.open(UPNP_READ);
+
+    char buf[5000];
+    size_t pos = 0;
+    size_t bytesRead;
+    while ((bytesRead = subject.read(buf, sizeof(buf))) > 0) {
+        ASSERT_TRUE(isPattern(buf, bytesRead, pos));
+        pos += bytesRead;
+    }
+    EXPECT_EQ(100000u, pos);
+    subject.close();
+}
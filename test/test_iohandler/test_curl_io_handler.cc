@@ -0,0 +1,208 @@
+#ifdef HAVE_CURL
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "iohandler/curl_io_handler.h"
+#include "url.h"
+#include "util/curl_handle_pool.h"
+
+using namespace ::testing;
+
+// HTTP/1.1 server on the loopback interface answering every request with
+// the same body, connections are kept alive
+class HttpFixtureServer {
+public:
+    explicit HttpFixtureServer(std::string body)
+        : body(std::move(body))
+    {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), len) != 0
+            || listen(listenFd, 16) != 0
+            || getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+            throw std::runtime_error("failed to listen");
+        port = ntohs(addr.sin_port);
+        acceptThread = std::thread(&HttpFixtureServer::acceptConnections, this);
+    }
+
+    ~HttpFixtureServer()
+    {
+        shutdown(listenFd, SHUT_RDWR);
+        acceptThread.join();
+        close(listenFd);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int fd : clientFds)
+                shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& thread : clientThreads)
+            thread.join();
+    }
+
+    std::string getURL() const { return "http://127.0.0.1:" + std::to_string(port) + "/stream"; }
+    int getConnectionCount() const { return connectionCount; }
+    int getRequestCount() const { return requestCount; }
+
+private:
+    void acceptConnections()
+    {
+        int fd;
+        while ((fd = accept(listenFd, nullptr, nullptr)) >= 0) {
+            connectionCount++;
+            std::lock_guard<std::mutex> lock(mutex);
+            clientFds.push_back(fd);
+            clientThreads.emplace_back(&HttpFixtureServer::serve, this, fd);
+        }
+    }
+
+    void serve(int fd)
+    {
+        std::string request;
+        char buf[4096];
+        ssize_t length;
+        while ((length = read(fd, buf, sizeof(buf))) > 0) {
+            request.append(buf, length);
+            size_t end;
+            while ((end = request.find("\r\n\r\n")) != std::string::npos) {
+                bool head = request.compare(0, 5, "HEAD ") == 0;
+                request.erase(0, end + 4);
+                requestCount++;
+
+                std::string response = "HTTP/1.1 200 OK\r\nContent-Type: video/mpeg\r\nContent-Length: "
+                    + std::to_string(body.size()) + "\r\n\r\n";
+                if (!head)
+                    response += body;
+                for (size_t done = 0; done < response.size();) {
+                    ssize_t written = write(fd, response.data() + done, response.size() - done);
+                    if (written <= 0)
+                        break;
+                    done += written;
+                }
+            }
+        }
+        close(fd);
+    }
+
+    std::string body;
+    int listenFd;
+    int port;
+    std::thread acceptThread;
+    std::mutex mutex;
+    std::vector<int> clientFds;
+    std::vector<std::thread> clientThreads;
+    std::atomic<int> connectionCount { 0 };
+    std::atomic<int> requestCount { 0 };
+};
+
+static std::string makeBody(size_t size)
+{
+    std::string body(size, '\0');
+    for (size_t i = 0; i < size; i++)
+        body[i] = static_cast<char>(i % 251);
+    return body;
+}
+
+static std::string readAll(IOHandler& handler)
+{
+    std::string data;
+    char buf[16 * 1024];
+    size_t length;
+    while ((length = handler.read(buf, sizeof(buf))) > 0)
+        data.append(buf, length);
+    return data;
+}
+
+TEST(CurlIOHandlerTest, PooledHandlesReuseConnection)
+{
+    auto body = makeBody(300000);
+    HttpFixtureServer server(body);
+    auto pool = std::make_shared<CurlHandlePool>();
+
+    for (int i = 0; i < 2; i++) {
+        auto curl_handle = pool->acquire();
+        auto st = URL::getInfo(server.getURL(), curl_handle.get());
+        EXPECT_EQ(static_cast<off_t>(body.size()), st->getSize());
+        EXPECT_EQ("video/mpeg", st->getMimeType());
+    }
+
+    for (int i = 0; i < 3; i++) {
+        CurlIOHandler handler(server.getURL(), nullptr, 1024 * 1024, 0, nullptr, pool);
+        handler.open(UPNP_READ);
+        EXPECT_EQ(body, readAll(handler));
+        handler.close();
+    }
+
+    EXPECT_EQ(5, server.getRequestCount());
+    EXPECT_EQ(1, server.getConnectionCount());
+    EXPECT_EQ(4u, pool->getReuseCount());
+}
+
+TEST(CurlIOHandlerTest, ExternalHandleIsNotCleanedUp)
+{
+    auto body = makeBody(1000);
+    HttpFixtureServer server(body);
+    CURL* curl_handle = curl_easy_init();
+
+    for (int i = 0; i < 2; i++) {
+        CurlIOHandler handler(server.getURL(), curl_handle, CURL_MAX_WRITE_SIZE, 0);
+        handler.open(UPNP_READ);
+        EXPECT_EQ(body, readAll(handler));
+        handler.close();
+    }
+
+    EXPECT_EQ(1, server.getConnectionCount());
+    curl_easy_cleanup(curl_handle);
+}
+
+// run with --gtest_also_run_disabled_tests, reports the time to the first
+// byte of repeated proxy requests with and without the pool
+static double timeToFirstByte(const std::string& url, const std::shared_ptr<CurlHandlePool>& pool, int requests)
+{
+    std::chrono::duration<double> total {};
+    for (int i = 0; i < requests; i++) {
+        auto started = std::chrono::steady_clock::now();
+        if (pool != nullptr) {
+            auto curl_handle = pool->acquire();
+            URL::getInfo(url, curl_handle.get());
+        } else {
+            URL::getInfo(url);
+        }
+        CurlIOHandler handler(url, nullptr, 1024 * 1024, 0, nullptr, pool);
+        handler.open(UPNP_READ);
+        char buf[1];
+        EXPECT_EQ(1u, handler.read(buf, sizeof(buf)));
+        total += std::chrono::steady_clock::now() - started;
+        // an aborted transfer closes the connection
+        readAll(handler);
+        handler.close();
+    }
+    return total.count() / requests;
+}
+
+TEST(CurlIOHandlerTest, DISABLED_BenchmarkTimeToFirstByte)
+{
+    HttpFixtureServer server(makeBody(64 * 1024));
+    const int requests = 500;
+
+    double unpooled = timeToFirstByte(server.getURL(), nullptr, requests);
+    int unpooledConnections = server.getConnectionCount();
+    double pooled = timeToFirstByte(server.getURL(), std::make_shared<CurlHandlePool>(), requests);
+
+    std::cout << "without pool: " << unpooled * 1e6 << "us, " << unpooledConnections << " connections" << std::endl
+              << "with pool: " << pooled * 1e6 << "us, " << server.getConnectionCount() - unpooledConnections << " connections" << std::endl;
+}
+
+#endif // HAVE_CURL
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "iohandler/io_handler_chainer.h"
+#include "iohandler/mem_io_handler.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+// collects everything written to it
+class StringIOHandler : public IOHandler {
+public:
+    explicit StringIOHandler(std::string& data)
+        : data(data)
+    {
+    }
+
+    size_t write(char* buf, size_t length) override
+    {
+        data.append(buf, length);
+        return length;
+    }
+
+private:
+    std::string& data;
+};
+
+// endless source which does not touch the buffer, limited by time only
+class GeneratorIOHandler : public IOHandler {
+public:
+    explicit GeneratorIOHandler(std::chrono::milliseconds duration)
+        : end(std::chrono::steady_clock::now() + duration)
+    {
+    }
+
+    size_t read(char* buf, size_t length) override
+    {
+        return std::chrono::steady_clock::now() < end ? length : 0;
+    }
+
+private:
+    std::chrono::steady_clock::time_point end;
+};
+
+class CountingIOHandler : public IOHandler {
+public:
+    size_t write(char* buf, size_t length) override { return length; }
+};
+
+// one end of a pipe
+class PipeIOHandler : public IOHandler {
+public:
+    explicit PipeIOHandler(int fd)
+        : fd(fd)
+    {
+    }
+
+    size_t read(char* buf, size_t length) override { return ::read(fd, buf, length); }
+    size_t write(char* buf, size_t length) override { return ::write(fd, buf, length); }
+    int getFd() override { return fd; }
+    void close() override { ::close(fd); }
+
+private:
+    int fd;
+};
+
+// the status is set when the chain is done, kill() joins the thread
+static void waitForChain(IOHandlerChainer& chain)
+{
+    auto end = std::chrono::steady_clock::now() + 10s;
+    while (chain.getStatus() == 0 && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(10ms);
+    chain.kill();
+}
+
+TEST(IOHandlerChainerTest, CopiesData)
+{
+    std::string source(100000, 'x');
+    std::string target;
+    std::unique_ptr<IOHandler> readFrom = std::make_unique<MemIOHandler>(source);
+    std::unique_ptr<IOHandler> writeTo = std::make_unique<StringIOHandler>(target);
+
+    IOHandlerChainer chain(readFrom, writeTo, 4096);
+    waitForChain(chain);
+
+    EXPECT_EQ(IOHC_NORMAL_SHUTDOWN, chain.getStatus());
+    EXPECT_EQ(source, target);
+    EXPECT_EQ(100000, chain.getBytesMoved());
+    EXPECT_FALSE(chain.isSpliced());
+}
+
+TEST(IOHandlerChainerTest, FastSourceGrowsChunks)
+{
+    std::unique_ptr<IOHandler> readFrom = std::make_unique<GeneratorIOHandler>(600ms);
+    std::unique_ptr<IOHandler> writeTo = std::make_unique<CountingIOHandler>();
+
+    IOHandlerChainer chain(readFrom, writeTo, 16384, 256 * 1024);
+    waitForChain(chain);
+
+    EXPECT_EQ(IOHC_NORMAL_SHUTDOWN, chain.getStatus());
+    EXPECT_EQ(256 * 1024, chain.getChunkSize());
+}
+
+TEST(IOHandlerChainerTest, SplicesPipes)
+{
+    int in[2], out[2];
+    ASSERT_EQ(0, pipe(in));
+    ASSERT_EQ(0, pipe(out));
+    fcntl(in[0], F_SETFL, O_NONBLOCK);
+    fcntl(out[1], F_SETFL, O_NONBLOCK);
+
+    std::string source(1024 * 1024, '\0');
+    for (size_t i = 0; i < source.size(); i++)
+        source[i] = static_cast<char>(i % 251);
+    std::thread writer([&]() {
+        for (size_t done = 0; done < source.size();) {
+            ssize_t written = write(in[1], source.data() + done, source.size() - done);
+            ASSERT_GT(written, 0);
+            done += written;
+        }
+        close(in[1]);
+    });
+
+    std::unique_ptr<IOHandler> readFrom = std::make_unique<PipeIOHandler>(in[0]);
+    std::unique_ptr<IOHandler> writeTo = std::make_unique<PipeIOHandler>(out[1]);
+    IOHandlerChainer chain(readFrom, writeTo, 4096);
+
+    // let the target pipe fill up before reading it
+    std::this_thread::sleep_for(100ms);
+    std::string target;
+    char buf[64 * 1024];
+    ssize_t length;
+    while ((length = read(out[0], buf, sizeof(buf))) > 0)
+        target.append(buf, length);
+    close(out[0]);
+    writer.join();
+    waitForChain(chain);
+
+    EXPECT_EQ(IOHC_NORMAL_SHUTDOWN, chain.getStatus());
+    EXPECT_EQ(source, target);
+    EXPECT_EQ(static_cast<off_t>(source.size()), chain.getBytesMoved());
+    EXPECT_GT(chain.getStalls(), 0);
+#ifdef __linux__
+    EXPECT_TRUE(chain.isSpliced());
+#endif
+}
+
+// refuses every chunk a few times before taking it
+class ReluctantIOHandler : public IOHandler {
+public:
+    size_t write(char* buf, size_t length) override
+    {
+        if (++refused <= 3)
+            return 0;
+        refused = 0;
+        return length;
+    }
+
+private:
+    int refused = 0;
+};
+
+TEST(IOHandlerChainerTest, CountsOneStallPerChunk)
+{
+    std::string source(4 * 4096, 'x');
+    std::unique_ptr<IOHandler> readFrom = std::make_unique<MemIOHandler>(source);
+    std::unique_ptr<IOHandler> writeTo = std::make_unique<ReluctantIOHandler>();
+
+    IOHandlerChainer chain(readFrom, writeTo, 4096);
+    waitForChain(chain);
+
+    EXPECT_EQ(IOHC_NORMAL_SHUTDOWN, chain.getStatus());
+    EXPECT_EQ(4, chain.getStalls());
+}
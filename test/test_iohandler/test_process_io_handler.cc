@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "iohandler/process_io_handler.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+// a live transcoder writes in small pieces and keeps the pipe open
+TEST(ProcessIOHandlerTest, ReturnsOutputWithoutFillingBuffer)
+{
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe(pipeFds));
+    fcntl(pipeFds[0], F_SETFL, O_NONBLOCK);
+
+    ProcessIOHandler subject(nullptr, pipeFds[0], nullptr);
+    subject.open(UPNP_READ);
+    ASSERT_EQ(5, write(pipeFds[1], "first", 5));
+
+    char buf[65536];
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(5u, subject.read(buf, sizeof(buf)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+    EXPECT_EQ("first", std::string(buf, 5));
+
+    ASSERT_EQ(6, write(pipeFds[1], "second", 6));
+    EXPECT_EQ(6u, subject.read(buf, sizeof(buf)));
+    EXPECT_EQ("second", std::string(buf, 6));
+
+    close(pipeFds[1]);
+    EXPECT_EQ(0u, subject.read(buf, sizeof(buf)));
+    subject.close();
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "iohandler/mem_io_handler.h"
+#include "iohandler/shaped_io_handler.h"
+
+using namespace ::testing;
+using namespace std::chrono;
+
+static std::unique_ptr<IOHandler> createSource(size_t size)
+{
+    auto handler = std::make_unique<MemIOHandler>(std::string(size, 'x'));
+    handler->open(UPNP_READ);
+    return handler;
+}
+
+// returns the seconds needed to read the whole stream
+static double readAll(IOHandler& handler)
+{
+    auto started = steady_clock::now();
+    char buf[16 * 1024];
+    while (handler.read(buf, sizeof(buf)) > 0) {
+    }
+    return duration<double>(steady_clock::now() - started).count();
+}
+
+TEST(ShapedIOHandlerTest, LimitsClientRate)
+{
+    auto shaper = std::make_shared<BandwidthShaper>(0, 200000, 0);
+    ShapedIOHandler subject(shaper, "10.0.0.1", "movie", createSource(100000));
+
+    double elapsed = readAll(subject);
+    subject.close();
+
+    EXPECT_GE(elapsed, 0.45);
+    EXPECT_LT(elapsed, 0.75);
+}
+
+TEST(ShapedIOHandlerTest, BurstIsSentAtOnce)
+{
+    auto shaper = std::make_shared<BandwidthShaper>(0, 10000, 100000);
+    ShapedIOHandler subject(shaper, "10.0.0.1", "movie", createSource(100000));
+
+    EXPECT_LT(readAll(subject), 0.2);
+    subject.close();
+}
+
+TEST(ShapedIOHandlerTest, SharesTotalRateBetweenStreams)
+{
+    auto shaper = std::make_shared<BandwidthShaper>(400000, 0, 0);
+    ShapedIOHandler small(shaper, "10.0.0.1", "small", createSource(100000));
+    ShapedIOHandler large(shaper, "10.0.0.2", "large", createSource(300000));
+
+    // both streams get 200000 bytes/s until the small one is done, then
+    // the large one gets everything
+    double smallElapsed = 0;
+    std::thread thread([&]() { smallElapsed = readAll(small); });
+    double largeElapsed = readAll(large);
+    thread.join();
+
+    EXPECT_GE(smallElapsed, 0.4);
+    EXPECT_LT(smallElapsed, 0.75);
+    EXPECT_GE(largeElapsed, 0.9);
+    EXPECT_LT(largeElapsed, 1.3);
+    small.close();
+    large.close();
+}
+
+TEST(ShapedIOHandlerTest, ReportsStreamStats)
+{
+    auto shaper = std::make_shared<BandwidthShaper>(0, 0, 0);
+    ShapedIOHandler subject(shaper, "10.0.0.1", "movie", createSource(5000));
+
+    char buf[1000];
+    EXPECT_EQ(1000u, subject.read(buf, sizeof(buf)));
+    EXPECT_EQ(1000u, subject.read(buf, sizeof(buf)));
+
+    auto stats = shaper->getStreamStats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ("10.0.0.1", stats[0].client);
+    EXPECT_EQ("movie", stats[0].name);
+    EXPECT_EQ(2000, stats[0].bytes);
+
+    subject.close();
+    EXPECT_TRUE(shaper->getStreamStats().empty());
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "iohandler/mem_io_handler.h"
+#include "iohandler/time_seek_io_handler.h"
+
+using namespace ::testing;
+
+class TimeSeekIOHandlerTest : public ::testing::Test {
+public:
+    // 8000 bit/s, the stream produced for start time s is "<s>:" repeated
+    TimeSeekIOHandler::Opener opener()
+    {
+        return [this](double start) {
+            starts.push_back(start);
+            std::string data;
+            for (int i = 0; i < 100; i++)
+                data += std::to_string(static_cast<int>(start)) + ":";
+            auto handler = std::make_unique<MemIOHandler>(data);
+            handler->open(UPNP_READ);
+            return handler;
+        };
+    }
+
+protected:
+    std::vector<double> starts;
+};
+
+TEST_F(TimeSeekIOHandlerTest, OpensAtStartTime)
+{
+    TimeSeekIOHandler subject(opener(), 8000, 12);
+    subject.open(UPNP_READ);
+
+    char buf[4] = {};
+    EXPECT_EQ(3u, subject.read(buf, 3));
+    EXPECT_STREQ("12:", buf);
+    EXPECT_EQ(3, subject.tell());
+    ASSERT_EQ(1u, starts.size());
+    EXPECT_EQ(12, starts[0]);
+    subject.close();
+}
+
+TEST_F(TimeSeekIOHandlerTest, SeekRestartsAtMappedTime)
+{
+    TimeSeekIOHandler subject(opener(), 8000, 0);
+    subject.open(UPNP_READ);
+
+    // 1000 bytes per second
+    subject.seek(30000, SEEK_SET);
+    EXPECT_EQ(30000, subject.tell());
+
+    char buf[4] = {};
+    EXPECT_EQ(3u, subject.read(buf, 3));
+    EXPECT_STREQ("30:", buf);
+
+    subject.seek(2000, SEEK_CUR);
+    ASSERT_EQ(3u, starts.size());
+    EXPECT_DOUBLE_EQ(32.003, starts[2]);
+    subject.close();
+}
+
+TEST_F(TimeSeekIOHandlerTest, SeekToCurrentPositionKeepsStream)
+{
+    TimeSeekIOHandler subject(opener(), 8000, 0);
+    subject.open(UPNP_READ);
+    subject.seek(0, SEEK_SET);
+    subject.seek(0, SEEK_CUR);
+    EXPECT_EQ(1u, starts.size());
+    EXPECT_THROW(subject.seek(0, SEEK_END), std::runtime_error);
+    subject.close();
+}
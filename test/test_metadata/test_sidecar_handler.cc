@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "cds_objects.h"
+#include "helpers/temp_dir.h"
+#include "metadata/fanart_handler.h"
+#include "metadata/sidecar_handler.h"
+
+using namespace ::testing;
+
+class SidecarHandlerTest : public ::testing::Test {
+public:
+    SidecarHandlerTest()
+        : tmp("gerbera-sidecar")
+        , dir(tmp.path())
+    {
+        touch("movie.mkv");
+        item = std::make_shared<CdsItem>(nullptr);
+        item->setLocation(dir / "movie.mkv");
+        item->setMimeType("video/x-matroska");
+        item->addResource(std::make_shared<CdsResource>(CH_DEFAULT));
+    }
+
+    void touch(const std::string& name)
+    {
+        std::ofstream(dir / name) << name;
+    }
+
+protected:
+    ScopedTempDir tmp;
+    fs::path dir;
+    std::shared_ptr<CdsItem> item;
+    SidecarHandler subject { nullptr };
+};
+
+TEST_F(SidecarHandlerTest, IndexesSubtitlesAndNfo)
+{
+    touch("movie.smi");
+    touch("movie.srt");
+    touch("movie.nfo");
+    touch("other.srt");
+
+    subject.fillMetadata(item);
+
+    ASSERT_EQ(4, item->getResourceCount());
+    EXPECT_EQ(CH_SIDECAR, item->getResource(1)->getHandlerType());
+    EXPECT_EQ((dir / "movie.srt").string(), item->getResource(1)->getOption(RESOURCE_OPTION_PATH));
+    EXPECT_EQ(SUBTITLE_FILE, item->getResource(1)->getParameter(RESOURCE_CONTENT_TYPE));
+    EXPECT_EQ((dir / "movie.smi").string(), item->getResource(2)->getOption(RESOURCE_OPTION_PATH));
+    EXPECT_EQ(NFO_FILE, item->getResource(3)->getParameter(RESOURCE_CONTENT_TYPE));
+
+    EXPECT_EQ(1, SidecarHandler::findSubtitle(item));
+    EXPECT_EQ(2, SidecarHandler::findSubtitle(item, ".smi"));
+    EXPECT_EQ(-1, SidecarHandler::findSubtitle(item, ".sub"));
+}
+
+TEST_F(SidecarHandlerTest, IgnoresSubtitlesOfAudio)
+{
+    touch("movie.srt");
+    item->setMimeType("audio/mpeg");
+
+    subject.fillMetadata(item);
+
+    EXPECT_EQ(1, item->getResourceCount());
+    EXPECT_EQ(-1, SidecarHandler::findSubtitle(item));
+}
+
+TEST_F(SidecarHandlerTest, RefreshReportsChanges)
+{
+    touch("movie.srt");
+    subject.fillMetadata(item);
+    EXPECT_FALSE(subject.refresh(item));
+
+    touch("poster.jpg");
+    fs::remove(dir / "movie.srt");
+    EXPECT_TRUE(subject.refresh(item));
+
+    ASSERT_EQ(2, item->getResourceCount());
+    EXPECT_EQ(CH_FANART, item->getResource(1)->getHandlerType());
+    EXPECT_EQ((dir / "poster.jpg").string(), item->getResource(1)->getOption(RESOURCE_OPTION_PATH));
+    EXPECT_EQ(-1, SidecarHandler::findSubtitle(item));
+}
+
+TEST_F(SidecarHandlerTest, ProbesSubtitlesOfUnindexedItems)
+{
+    touch("movie.ssa");
+    touch("movie.nfo");
+
+    // imported before sidecars were indexed
+    EXPECT_EQ(dir / "movie.ssa", SidecarHandler::getSubtitlePath(item));
+    EXPECT_EQ(dir / "movie.ssa", SidecarHandler::getSubtitlePath(item, ".ssa"));
+    EXPECT_TRUE(SidecarHandler::getSubtitlePath(item, ".srt").empty());
+
+    // the index is trusted once it exists
+    subject.fillMetadata(item);
+    fs::remove(dir / "movie.ssa");
+    touch("movie.srt");
+    EXPECT_EQ(dir / "movie.ssa", SidecarHandler::getSubtitlePath(item));
+    EXPECT_TRUE(SidecarHandler::getSubtitlePath(item, ".srt").empty());
+}
+
+TEST_F(SidecarHandlerTest, ServesSidecarFromIndex)
+{
+    touch("movie.srt");
+    subject.fillMetadata(item);
+
+    auto handler = subject.serveContent(item, 1);
+    handler->open(UPNP_READ);
+    char buf[32];
+    auto length = handler->read(buf, sizeof(buf));
+    handler->close();
+    EXPECT_EQ("movie.srt", std::string(buf, length));
+}
+
+TEST_F(SidecarHandlerTest, MatchesSidecarsToItems)
+{
+    EXPECT_TRUE(SidecarHandler::isSidecar(dir / "movie.ssa"));
+    EXPECT_TRUE(SidecarHandler::isSidecar(dir / "folder.jpg"));
+    EXPECT_FALSE(SidecarHandler::isSidecar(dir / "movie.mkv"));
+
+    EXPECT_TRUE(SidecarHandler::isSidecarOf(dir / "movie.srt", dir / "movie.mkv"));
+    EXPECT_TRUE(SidecarHandler::isSidecarOf(dir / "poster.jpg", dir / "movie.mkv"));
+    EXPECT_FALSE(SidecarHandler::isSidecarOf(dir / "other.srt", dir / "movie.mkv"));
+    EXPECT_FALSE(SidecarHandler::isSidecarOf(dir / "sub" / "movie.srt", dir / "movie.mkv"));
+}
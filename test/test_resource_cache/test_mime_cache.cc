@@ -0,0 +1,125 @@
+#ifdef HAVE_MAGIC
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <sys/stat.h>
+#include <vector>
+
+#include "helpers/temp_dir.h"
+#include "util/mime_cache.h"
+#include "util/tools.h"
+
+using namespace ::testing;
+
+class MimeCacheTest : public ::testing::Test {
+public:
+    MimeCacheTest()
+        : tmp("gerbera-mimecache")
+        , dir(tmp.path())
+    {
+    }
+
+    fs::path write(const std::string& name, const std::string& content)
+    {
+        auto path = dir / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    static std::string getMimeType(MimeCache& cache, const fs::path& path)
+    {
+        struct stat statbuf;
+        stat(path.c_str(), &statbuf);
+        return cache.getMimeType(path, statbuf.st_mtime, statbuf.st_size);
+    }
+
+protected:
+    ScopedTempDir tmp;
+    fs::path dir;
+};
+
+static const std::string pngHeader("\x89PNG\r\n\x1a\n\0\0\0\x0dIHDR\0\0\0\x01\0\0\0\x01\x08\x02\0\0\0", 29);
+
+TEST_F(MimeCacheTest, ClassifiesFiles)
+{
+    MimeCache subject(10);
+    EXPECT_EQ("text/plain", getMimeType(subject, write("a", "just some text\n")));
+    EXPECT_EQ("image/png", getMimeType(subject, write("b", pngHeader)));
+    EXPECT_EQ(2u, subject.getMissCount());
+}
+
+TEST_F(MimeCacheTest, ReclassifiesChangedFiles)
+{
+    MimeCache subject(10);
+    auto path = write("a", "just some text\n");
+    EXPECT_EQ("text/plain", getMimeType(subject, path));
+    EXPECT_EQ("text/plain", getMimeType(subject, path));
+    EXPECT_EQ(1u, subject.getHitCount());
+
+    write("a", pngHeader);
+    EXPECT_EQ("image/png", getMimeType(subject, path));
+    EXPECT_EQ(2u, subject.getMissCount());
+}
+
+TEST_F(MimeCacheTest, DropsLeastRecentlyUsed)
+{
+    MimeCache subject(2);
+    auto a = write("a", "a\n");
+    auto b = write("b", "b\n");
+    auto c = write("c", "c\n");
+
+    getMimeType(subject, a);
+    getMimeType(subject, b);
+    getMimeType(subject, a);
+    getMimeType(subject, c);
+    EXPECT_EQ(3u, subject.getMissCount());
+
+    getMimeType(subject, a);
+    EXPECT_EQ(2u, subject.getHitCount());
+    getMimeType(subject, b);
+    EXPECT_EQ(4u, subject.getMissCount());
+}
+
+// run with --gtest_also_run_disabled_tests, reports the time to classify
+// 10000 files with a new libmagic handle per file (as before the handles
+// were kept per thread), with the thread handle and with the cache
+static std::string classifyWithNewHandle(const fs::path& path)
+{
+    magic_t cookie = magic_open(MAGIC_MIME_TYPE);
+    magic_load(cookie, nullptr);
+    std::string mime = magic_file(cookie, path.c_str());
+    magic_close(cookie);
+    return mime;
+}
+
+TEST_F(MimeCacheTest, DISABLED_BenchmarkClassify10kFiles)
+{
+    const int count = 10000;
+    std::vector<fs::path> files;
+    for (int i = 0; i < count; i++)
+        files.push_back(write(std::to_string(i), (i % 2) ? pngHeader : "text file " + std::to_string(i) + "\n"));
+
+    auto time = [&](const std::function<std::string(const fs::path&)>& classify, int n) {
+        auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++)
+            EXPECT_FALSE(classify(files[i]).empty());
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count() / n;
+    };
+
+    // loading the database for every file takes too long for all of them
+    double newHandle = time(classifyWithNewHandle, 200);
+    double threadHandle = time([](const fs::path& path) { return getMIMETypeFromFile(path); }, count);
+    MimeCache cache(count);
+    double cold = time([&](const fs::path& path) { return getMimeType(cache, path); }, count);
+    double warm = time([&](const fs::path& path) { return getMimeType(cache, path); }, count);
+
+    std::cout << "new handle per file: " << newHandle * 1e6 << "us/file, " << newHandle * count << "s for " << count << " files" << std::endl
+              << "thread handle: " << threadHandle * 1e6 << "us/file, " << threadHandle * count << "s" << std::endl
+              << "cache, cold: " << cold * 1e6 << "us/file, " << cold * count << "s" << std::endl
+              << "cache, warm: " << warm * 1e6 << "us/file, " << warm * count << "s" << std::endl;
+}
+
+#endif // HAVE_MAGIC
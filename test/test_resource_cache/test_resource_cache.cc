@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include "helpers/temp_dir.h"
+#include "iohandler/mem_io_handler.h"
+#include "util/resource_cache.h"
+
+using namespace ::testing;
+
+class ResourceCacheTest : public ::testing::Test {
+public:
+    ResourceCacheTest()
+        : tmp("gerbera-rescache")
+        , dir(tmp.path())
+    {
+    }
+
+    std::function<std::unique_ptr<IOHandler>()> generator(const std::string& data)
+    {
+        return [this, data]() {
+            generated++;
+            return std::make_unique<MemIOHandler>(data);
+        };
+    }
+
+protected:
+    ScopedTempDir tmp;
+    fs::path dir;
+    int generated = 0;
+};
+
+TEST_F(ResourceCacheTest, GeneratesResourceOnlyOnce)
+{
+    ResourceCache subject(1024, "", 0);
+    auto key = ResourceCache::makeKey("/media/photo.jpg", 1000, "small");
+
+    EXPECT_EQ("thumbnail", *subject.getOrCreate(key, generator("thumbnail")));
+    EXPECT_EQ("thumbnail", *subject.getOrCreate(key, generator("thumbnail")));
+    EXPECT_EQ(1, generated);
+}
+
+TEST_F(ResourceCacheTest, ModifiedSourceMissesCache)
+{
+    ResourceCache subject(1024, "", 0);
+
+    subject.getOrCreate(ResourceCache::makeKey("/media/photo.jpg", 1000, "small"), generator("old"));
+    EXPECT_EQ("new", *subject.getOrCreate(ResourceCache::makeKey("/media/photo.jpg", 1001, "small"), generator("new")));
+    EXPECT_EQ(2, generated);
+}
+
+TEST_F(ResourceCacheTest, OtherSourceOrSettingsMissCache)
+{
+    ResourceCache subject(1024, "", 0);
+
+    subject.getOrCreate(ResourceCache::makeKey("/media/photo.jpg", 1000, "small"), generator("small"));
+    EXPECT_EQ("large", *subject.getOrCreate(ResourceCache::makeKey("/media/photo.jpg", 1000, "large"), generator("large")));
+    EXPECT_EQ("other", *subject.getOrCreate(ResourceCache::makeKey("/media/other.jpg", 1000, "small"), generator("other")));
+    EXPECT_EQ(3, generated);
+}
+
+TEST_F(ResourceCacheTest, DropsLeastRecentlyUsedFromMemory)
+{
+    ResourceCache subject(400, "", 0);
+    std::string data(100, 'x');
+
+    subject.put("a", std::make_shared<const std::string>(data));
+    subject.put("b", std::make_shared<const std::string>(data));
+    subject.put("c", std::make_shared<const std::string>(data));
+    subject.put("d", std::make_shared<const std::string>(data));
+    EXPECT_NE(nullptr, subject.get("a"));
+
+    subject.put("e", std::make_shared<const std::string>(data));
+    EXPECT_NE(nullptr, subject.get("a"));
+    EXPECT_EQ(nullptr, subject.get("b"));
+    EXPECT_NE(nullptr, subject.get("e"));
+}
+
+TEST_F(ResourceCacheTest, ServesFromDiskAfterRestart)
+{
+    auto key = ResourceCache::makeKey("/media/photo.jpg", 42, "small");
+    {
+        ResourceCache subject(1024, dir, 4096);
+        subject.getOrCreate(key, generator("artwork"));
+    }
+
+    ResourceCache subject(1024, dir, 4096);
+    EXPECT_EQ("artwork", *subject.getOrCreate(key, generator("artwork")));
+    EXPECT_EQ(1, generated);
+}
+
+TEST_F(ResourceCacheTest, KeepsDiskCacheWithinSize)
+{
+    ResourceCache subject(0, dir, 250);
+    std::string data(100, 'x');
+
+    for (int i = 0; i < 5; i++)
+        subject.put(ResourceCache::makeKey("/media/" + std::to_string(i), 0, "small"), std::make_shared<const std::string>(data));
+
+    uintmax_t total = 0;
+    for (const auto& entry : fs::directory_iterator(dir))
+        total += entry.file_size();
+    EXPECT_LE(total, 250u);
+    EXPECT_NE(nullptr, subject.get(ResourceCache::makeKey("/media/4", 0, "small")));
+}
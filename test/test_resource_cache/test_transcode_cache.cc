@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "helpers/temp_dir.h"
+#include "iohandler/mem_io_handler.h"
+#include "transcoding/transcode_cache.h"
+
+using namespace ::testing;
+
+class TranscodeCacheTest : public ::testing::Test {
+public:
+    TranscodeCacheTest()
+        : tmp("gerbera-trcache")
+        , dir(tmp.path())
+    {
+    }
+
+    static std::unique_ptr<IOHandler> transcoder(const std::string& data)
+    {
+        auto handler = std::make_unique<MemIOHandler>(data);
+        handler->open(UPNP_READ);
+        return handler;
+    }
+
+    static std::string readAll(IOHandler& handler, size_t chunk)
+    {
+        std::string result;
+        std::vector<char> buf(chunk);
+        size_t ret;
+        while ((ret = handler.read(buf.data(), chunk)) > 0 && ret != static_cast<size_t>(-1))
+            result.append(buf.data(), ret);
+        return result;
+    }
+
+protected:
+    ScopedTempDir tmp;
+    fs::path dir;
+};
+
+TEST_F(TranscodeCacheTest, KeyContainsProfileAndMtime)
+{
+    auto key = TranscodeCache::makeKey("video/mpeg 720p", "/media/a.mkv", 1000);
+    EXPECT_EQ(0u, key.find("video_mpeg_720p_"));
+    EXPECT_NE(key, TranscodeCache::makeKey("video/mpeg 720p", "/media/a.mkv", 1001));
+    EXPECT_NE(key, TranscodeCache::makeKey("audio", "/media/a.mkv", 1000));
+    EXPECT_EQ(std::string::npos, key.find('/'));
+}
+
+TEST_F(TranscodeCacheTest, CompleteStreamIsStored)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 1024);
+    auto key = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+    EXPECT_TRUE(subject->lookup(key).empty());
+
+    auto handler = subject->record(key, transcoder("transcoded data"));
+    EXPECT_EQ("transcoded data", readAll(*handler, 4));
+    handler->close();
+
+    auto path = subject->lookup(key);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(15u, fs::file_size(path));
+}
+
+TEST_F(TranscodeCacheTest, AbortedStreamIsDropped)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 1024);
+    auto key = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+
+    auto handler = subject->record(key, transcoder("transcoded data"));
+    char buf[4];
+    handler->read(buf, sizeof(buf));
+    handler->close();
+
+    EXPECT_TRUE(subject->lookup(key).empty());
+    EXPECT_TRUE(fs::is_empty(dir));
+}
+
+TEST_F(TranscodeCacheTest, StreamServedToAnnouncedLengthIsStored)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 1024);
+    auto key = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+
+    // the client got all it was promised, the rest is stored on close
+    auto handler = subject->record(key, transcoder("transcoded data"), 12);
+    char buf[12];
+    EXPECT_EQ(sizeof(buf), handler->read(buf, sizeof(buf)));
+    handler->close();
+
+    auto path = subject->lookup(key);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(15u, fs::file_size(path));
+
+    // a client leaving early does not make the stream complete
+    key = TranscodeCache::makeKey("pcm", "/media/b.flac", 1000);
+    handler = subject->record(key, transcoder("transcoded data"), 12);
+    EXPECT_EQ(4u, handler->read(buf, 4));
+    handler->close();
+    EXPECT_TRUE(subject->lookup(key).empty());
+}
+
+TEST_F(TranscodeCacheTest, StreamFarLongerThanAnnouncedIsDropped)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 1024);
+    auto key = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+
+    auto handler = subject->record(key, transcoder("transcoded data"), 8);
+    char buf[8];
+    EXPECT_EQ(sizeof(buf), handler->read(buf, sizeof(buf)));
+    handler->close();
+
+    EXPECT_TRUE(subject->lookup(key).empty());
+    EXPECT_TRUE(fs::is_empty(dir));
+}
+
+TEST_F(TranscodeCacheTest, RecordsOnlyOnce)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 1024);
+    auto key = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+
+    auto first = subject->record(key, transcoder("data"));
+    auto second = subject->record(key, transcoder("data"));
+    EXPECT_EQ(nullptr, dynamic_cast<MemIOHandler*>(first.get()));
+    EXPECT_NE(nullptr, dynamic_cast<MemIOHandler*>(second.get()));
+    first->close();
+    second->close();
+}
+
+TEST_F(TranscodeCacheTest, EvictsLeastRecentlyUsed)
+{
+    auto subject = std::make_shared<TranscodeCache>(dir, 20);
+    auto keyA = TranscodeCache::makeKey("pcm", "/media/a.flac", 1000);
+    auto keyB = TranscodeCache::makeKey("pcm", "/media/b.flac", 1000);
+    auto keyC = TranscodeCache::makeKey("pcm", "/media/c.flac", 1000);
+
+    for (const auto& key : { keyA, keyB }) {
+        auto handler = subject->record(key, transcoder("0123456789"));
+        readAll(*handler, 64);
+        handler->close();
+    }
+    // make A the most recently used entry
+    fs::last_write_time(dir / keyB, fs::file_time_type::clock::now() - std::chrono::hours(1));
+    ASSERT_FALSE(subject->lookup(keyA).empty());
+
+    auto handler = subject->record(keyC, transcoder("0123456789"));
+    readAll(*handler, 64);
+    handler->close();
+
+    EXPECT_FALSE(subject->lookup(keyA).empty());
+    EXPECT_TRUE(subject->lookup(keyB).empty());
+    EXPECT_FALSE(subject->lookup(keyC).empty());
+}
@@ -379,3 +379,76 @@ TEST(SearchParser, SearchCriteriaWithExtendsOperator)
     // derivedFromOpExpr and (containsOpExpr or containsOpExpr)
     EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "upnp:class derivedFrom \"object.item.audioItem\" and (dc:title contains \"britain\" or dc:creator contains \"britain\"", "c.upnp_class like lower('object.item.audioItem.%') and ((m.property_name='dc:title' and lower(m.property_value) like lower('%britain%') and c.upnp_class is not null) or (m.property_name='dc:creator' and lower(m.property_value) like lower('%britain%') and c.upnp_class is not null))"));
 }
+
+TEST(SearchParser, SearchCriteriaUsingNotEqualsOperator)
+{
+    DefaultSQLEmitter sqlEmitter;
+    // notEqualsOpExpr
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "upnp:album!=\"Scraps At Midnight\"",
+        "(m.property_name='upnp:album' and lower(m.property_value)!=lower('Scraps At Midnight') and c.upnp_class is not null)"));
+}
+
+TEST(SearchParser, SearchCriteriaUsingRangeOperators)
+{
+    DefaultSQLEmitter sqlEmitter;
+    // greaterThanOpExpr on a day excludes the whole day
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:date > \"2019-05-01\"",
+        "(m.property_name='dc:date' and m.property_sort_key>20190501235959 and c.upnp_class is not null)"));
+
+    // lessOrEqualOpExpr on a year covers the whole year
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:date <= \"2019\"",
+        "(m.property_name='dc:date' and m.property_sort_key<=20191231235959 and c.upnp_class is not null)"));
+
+    // greaterThanOpExpr on a month excludes the whole month
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:date > \"2019-05\"",
+        "(m.property_name='dc:date' and m.property_sort_key>20190531235959 and c.upnp_class is not null)"));
+
+    // greaterOrEqualOpExpr on a month includes the whole month
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:date >= \"2019-05\"",
+        "(m.property_name='dc:date' and m.property_sort_key>=20190500000000 and c.upnp_class is not null)"));
+
+    // greaterOrEqualOpExpr and lessThanOpExpr on a number
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "upnp:originalTrackNumber >= \"3\" and upnp:originalTrackNumber < \"10\"",
+        "(m.property_name='upnp:originalTrackNumber' and m.property_sort_key>=3 and c.upnp_class is not null) and (m.property_name='upnp:originalTrackNumber' and m.property_sort_key<10 and c.upnp_class is not null)"));
+
+    // lessThanOpExpr on a duration
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "upnp:lastPlaybackPosition < \"0:03:25.500\"",
+        "(m.property_name='upnp:lastPlaybackPosition' and m.property_sort_key<205500 and c.upnp_class is not null)"));
+
+    // greaterThanOpExpr on text
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:title > \"M\"",
+        "(m.property_name='dc:title' and lower(m.property_value)>lower('M') and c.upnp_class is not null)"));
+
+    // greaterThanOpExpr on a number in a text property stays text
+    EXPECT_TRUE(executeSearchParserTest(sqlEmitter, "dc:title > \"2019\"",
+        "(m.property_name='dc:title' and lower(m.property_value)>lower('2019') and c.upnp_class is not null)"));
+}
+
+TEST(SearchParser, MetadataSortKeys)
+{
+    int64_t sortKey;
+    EXPECT_TRUE(getMetadataSortKey("dc:date", "2019-05-01T12:30:15+02:00", sortKey));
+    EXPECT_EQ(20190501123015, sortKey);
+    EXPECT_TRUE(getMetadataSortKey("dc:date", "2019-05", sortKey));
+    EXPECT_EQ(20190500000000, sortKey);
+    EXPECT_TRUE(getMetadataSortKey("dc:date", "2019", sortKey));
+    EXPECT_EQ(20190000000000, sortKey);
+    EXPECT_TRUE(getMetadataSortKey("dc:date", "2019", sortKey, true));
+    EXPECT_EQ(20191231235959, sortKey);
+    EXPECT_TRUE(getMetadataSortKey("upnp:date", "2019-05-01T12:30", sortKey, true));
+    EXPECT_EQ(20190501123059, sortKey);
+    EXPECT_FALSE(getMetadataSortKey("dc:date", "May 2019", sortKey));
+    EXPECT_FALSE(getMetadataSortKey("dc:date", "12", sortKey));
+
+    EXPECT_TRUE(getMetadataSortKey("upnp:originalTrackNumber", "07", sortKey));
+    EXPECT_EQ(7, sortKey);
+    EXPECT_FALSE(getMetadataSortKey("upnp:originalTrackNumber", "2019-05", sortKey));
+    EXPECT_TRUE(getMetadataSortKey("upnp:lastPlaybackPosition", "1:02:03.4", sortKey));
+    EXPECT_EQ(3723400, sortKey);
+
+    EXPECT_FALSE(getMetadataSortKey("dc:title", "2 Fast", sortKey));
+    EXPECT_FALSE(getMetadataSortKey("dc:title", "2019", sortKey));
+    EXPECT_FALSE(getMetadataSortKey("dc:title", "2019-05-01", sortKey));
+    EXPECT_FALSE(getMetadataSortKey("upnp:album", "1:02:03", sortKey));
+    EXPECT_FALSE(getMetadataSortKey("dc:date", "", sortKey));
+}
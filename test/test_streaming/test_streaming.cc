@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <sys/resource.h>
+
+#include "helpers/test_server.h"
+
+using namespace ::testing;
+
+// Drives the callbacks of the internal web server the way libupnp calls them
+// for a request, against a Server with a media file imported into its
+// database. The requests go through Server, which hands the state resolved
+// in GetInfo over to Open, and FileRequestHandler with the IOHandlers it
+// picks from the configuration. Runs a small workload in every test run and
+// reports the numbers.
+
+#define MEDIA_SIZE (8 * 1024 * 1024)
+#define REQUESTS 20
+#define RANGE_REQUESTS 200
+#define RANGE_LENGTH (256 * 1024)
+/// \brief Buffer the web server reads into
+#define READ_SIZE (64 * 1024)
+
+// allocations done with new by the whole process
+static std::atomic<long> allocations { 0 };
+
+void* operator new(size_t size)
+{
+    allocations++;
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+// user and system CPU time of this process
+static double cpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// read and write system calls of this process, -1 without /proc/self/io
+static long long countSyscalls()
+{
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    long long value;
+    long long total = -1;
+    while (io >> key >> value) {
+        if (key == "syscr:" || key == "syscw:")
+            total = std::max(total, 0LL) + value;
+    }
+    return total;
+}
+
+// reads media files in blocks, see FileRequestHandler::createFileIOHandler()
+static void enableBlockIO(pugi::xml_node& root)
+{
+    auto blockIO = root.child("server").append_child("block-io");
+    blockIO.append_attribute("enabled") = "yes";
+    blockIO.append_attribute("min-size") = 0;
+}
+
+// profile "copy" passes the file through dd like a transcoder
+static void enableCopyProfile(pugi::xml_node& root)
+{
+    auto transcoding = root.child("transcoding");
+    transcoding.attribute("enabled") = "yes";
+
+    auto mapping = transcoding.child("mimetype-profile-mappings").append_child("transcode");
+    mapping.append_attribute("mimetype") = "application/octet-stream";
+    mapping.append_attribute("using") = "copy";
+
+    auto profile = transcoding.child("profiles").append_child("profile");
+    profile.append_attribute("name") = "copy";
+    profile.append_attribute("enabled") = "yes";
+    profile.append_attribute("type") = "external";
+    profile.append_child("mimetype").append_child(pugi::node_pcdata).set_value("application/octet-stream");
+    profile.append_child("accept-url").append_child(pugi::node_pcdata).set_value("no");
+    profile.append_child("first-resource").append_child(pugi::node_pcdata).set_value("yes");
+
+    auto agent = profile.append_child("agent");
+    agent.append_attribute("command") = "dd";
+    agent.append_attribute("arguments") = "if=%in of=%out bs=65536 status=none";
+
+    auto buffer = profile.append_child("buffer");
+    buffer.append_attribute("size") = 1024 * 1024;
+    buffer.append_attribute("chunk-size") = READ_SIZE;
+    buffer.append_attribute("fill-size") = 0;
+}
+
+// a media file imported into a TestServer
+class MediaLibrary {
+public:
+    explicit MediaLibrary(const std::function<void(pugi::xml_node& root)>& configure = nullptr)
+        : server(configure)
+    {
+        std::string media(MEDIA_SIZE, '\0');
+        for (size_t i = 0; i < media.size(); i++)
+            media[i] = static_cast<char>(i % 251);
+        data = std::move(media);
+
+        fs::path path = server.getHome() / "media.bin";
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+        file.close();
+
+        objectId = server.addFile(path);
+    }
+
+    const void* getCookie() const { return server.getCookie(); }
+    const std::string& getData() const { return data; }
+
+    std::string getUrl() const
+    {
+        return std::string(LINK_FILE_REQUEST_HANDLER) + URL_OBJECT_ID + "/" + std::to_string(objectId) + "/" + URL_RESOURCE_ID + "/0";
+    }
+
+    std::string getTranscodeUrl(const std::string& profile) const
+    {
+        return std::string(LINK_FILE_REQUEST_HANDLER) + URL_OBJECT_ID + "/" + std::to_string(objectId) + "/" + URL_RESOURCE_ID + "/" + URL_VALUE_TRANSCODE_NO_RES_ID
+            + "/" + URL_PARAM_TRANSCODE_PROFILE_NAME + "/" + profile + "/" + URL_PARAM_TRANSCODE + "/" + URL_VALUE_TRANSCODE;
+    }
+
+private:
+    TestServer server;
+    std::string data;
+    int objectId;
+};
+
+struct StreamStats {
+    off_t bytes = 0;
+    std::chrono::duration<double> elapsed {};
+    long long syscalls = 0;
+    double cpu = 0;
+    long allocations = 0;
+    std::vector<double> firstByte;
+
+    void print(const std::string& name) const
+    {
+        double mib = bytes / (1024.0 * 1024.0);
+        auto sorted = firstByte;
+        std::sort(sorted.begin(), sorted.end());
+        double p99 = sorted.empty() ? 0 : sorted[static_cast<size_t>(std::ceil(sorted.size() * 0.99)) - 1];
+
+        std::cout << std::fixed << std::setprecision(1) << name << ": "
+                  << firstByte.size() << " requests, " << mib << " MiB, "
+                  << mib / elapsed.count() << " MiB/s, ";
+        if (syscalls >= 0)
+            std::cout << syscalls / mib << " syscalls/MiB, ";
+        std::cout << cpu * 1e3 / mib << "ms CPU/MiB, ";
+        std::cout << static_cast<double>(allocations) / firstByte.size() << " allocations/request, "
+                  << "p99 time to first byte " << p99 * 1e6 << "us" << std::endl;
+    }
+};
+
+// one request as done by the web server: GetInfo, Open, Seek for a range,
+// Read until the range or the stream ends, Close
+static off_t request(const MediaLibrary& library, const std::string& url, off_t start, off_t length,
+    std::vector<char>& buf, std::string* body, double* firstByte)
+{
+    auto cookie = library.getCookie();
+    auto started = std::chrono::steady_clock::now();
+
+    UpnpFileInfo* info = UpnpFileInfo_new();
+    const void* requestCookie = nullptr;
+    EXPECT_EQ(0, WebCallbacks::getInfo(url.c_str(), info, cookie, &requestCookie));
+    UpnpFileInfo_delete(info);
+
+    UpnpWebFileHandle f = WebCallbacks::open(url.c_str(), UPNP_READ, cookie, requestCookie);
+    EXPECT_NE(nullptr, f);
+    if (f == nullptr)
+        return 0;
+    if (start > 0) {
+        EXPECT_EQ(0, WebCallbacks::seek(f, start, SEEK_SET, cookie));
+    }
+
+    off_t total = 0;
+    while (length < 0 || total < length) {
+        size_t wanted = length < 0 ? buf.size() : std::min<off_t>(buf.size(), length - total);
+        int got = WebCallbacks::read(f, buf.data(), wanted, cookie);
+        if (got <= 0)
+            break;
+        if (total == 0 && firstByte != nullptr)
+            *firstByte = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (body != nullptr)
+            body->append(buf.data(), got);
+        total += got;
+    }
+    EXPECT_EQ(0, WebCallbacks::close(f, cookie));
+    return total;
+}
+
+static std::string fetch(const MediaLibrary& library, const std::string& url, off_t start = 0, off_t length = -1)
+{
+    std::vector<char> buf(READ_SIZE);
+    std::string body;
+    request(library, url, start, length, buf, &body, nullptr);
+    return body;
+}
+
+// rangeLength -1 requests the whole stream
+static StreamStats run(const MediaLibrary& library, const std::string& url, int requests, off_t rangeLength = -1)
+{
+    std::mt19937 random(requests);
+    std::vector<char> buf(READ_SIZE);
+    StreamStats stats;
+    stats.firstByte.resize(requests);
+
+    long allocationsBefore = allocations;
+    long long syscallsBefore = countSyscalls();
+    double cpuBefore = cpuSeconds();
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; i++) {
+        off_t start = rangeLength < 0 ? 0 : random() % (MEDIA_SIZE - rangeLength);
+        stats.bytes += request(library, url, start, rangeLength, buf, nullptr, &stats.firstByte[i]);
+    }
+    stats.elapsed = std::chrono::steady_clock::now() - started;
+    stats.cpu = cpuSeconds() - cpuBefore;
+    stats.allocations = allocations - allocationsBefore;
+    long long syscallsAfter = countSyscalls();
+    stats.syscalls = syscallsBefore < 0 ? -1 : syscallsAfter - syscallsBefore;
+    return stats;
+}
+
+TEST(StreamingTest, File)
+{
+    MediaLibrary library;
+    EXPECT_EQ(library.getData(), fetch(library, library.getUrl()));
+
+    auto stats = run(library, library.getUrl(), REQUESTS);
+    stats.print("file");
+    EXPECT_EQ(static_cast<off_t>(REQUESTS) * MEDIA_SIZE, stats.bytes);
+}
+
+TEST(StreamingTest, BlockFile)
+{
+    MediaLibrary library(enableBlockIO);
+    EXPECT_EQ(library.getData(), fetch(library, library.getUrl()));
+
+    auto stats = run(library, library.getUrl(), REQUESTS);
+    stats.print("block file");
+    EXPECT_EQ(static_cast<off_t>(REQUESTS) * MEDIA_SIZE, stats.bytes);
+}
+
+TEST(StreamingTest, Transcoded)
+{
+    MediaLibrary library(enableCopyProfile);
+    std::string url = library.getTranscodeUrl("copy");
+    EXPECT_EQ(library.getData(), fetch(library, url));
+
+    // the syscalls of the transcoder itself are not counted
+    auto stats = run(library, url, REQUESTS);
+    stats.print("transcoded");
+    EXPECT_EQ(static_cast<off_t>(REQUESTS) * MEDIA_SIZE, stats.bytes);
+}
+
+TEST(StreamingTest, FileRanges)
+{
+    MediaLibrary library;
+    EXPECT_EQ(library.getData().substr(1000000, RANGE_LENGTH), fetch(library, library.getUrl(), 1000000, RANGE_LENGTH));
+
+    auto stats = run(library, library.getUrl(), RANGE_REQUESTS, RANGE_LENGTH);
+    stats.print("file ranges");
+    EXPECT_EQ(static_cast<off_t>(RANGE_REQUESTS) * RANGE_LENGTH, stats.bytes);
+}
+
+TEST(StreamingTest, BlockFileRanges)
+{
+    MediaLibrary library(enableBlockIO);
+    EXPECT_EQ(library.getData().substr(1000000, RANGE_LENGTH), fetch(library, library.getUrl(), 1000000, RANGE_LENGTH));
+
+    auto stats = run(library, library.getUrl(), RANGE_REQUESTS, RANGE_LENGTH);
+    stats.print("block file ranges");
+    EXPECT_EQ(static_cast<off_t>(RANGE_REQUESTS) * RANGE_LENGTH, stats.bytes);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "util/tools.h"
+
+using namespace ::testing;
+
+TEST(NptTest, ParsesSeconds)
+{
+    double seconds = -1;
+    EXPECT_TRUE(parseNptTime("0", seconds));
+    EXPECT_DOUBLE_EQ(0, seconds);
+    EXPECT_TRUE(parseNptTime("125", seconds));
+    EXPECT_DOUBLE_EQ(125, seconds);
+    EXPECT_TRUE(parseNptTime("10.5", seconds));
+    EXPECT_DOUBLE_EQ(10.5, seconds);
+    EXPECT_TRUE(parseNptTime("7.", seconds));
+    EXPECT_DOUBLE_EQ(7, seconds);
+}
+
+TEST(NptTest, ParsesHoursMinutesSeconds)
+{
+    double seconds = -1;
+    EXPECT_TRUE(parseNptTime("0:01:10", seconds));
+    EXPECT_DOUBLE_EQ(70, seconds);
+    EXPECT_TRUE(parseNptTime("1:02:03.250", seconds));
+    EXPECT_DOUBLE_EQ(3723.25, seconds);
+    EXPECT_TRUE(parseNptTime("100:00:00", seconds));
+    EXPECT_DOUBLE_EQ(360000, seconds);
+}
+
+TEST(NptTest, RejectsMalformedTime)
+{
+    double seconds = 0;
+    for (const auto& time : { "", ".", ".5", "-1", "1e3", "abc", "1..2", "1.2.3", "1:2", "1:02", ":01:02", "1::02", "1:2:3", "1:02:03:04", "1:60:00", "1:00:60", "1:02:03.x", " 1" }) {
+        EXPECT_FALSE(parseNptTime(time, seconds)) << time;
+    }
+}
+
+TEST(NptTest, ParsesOpenRange)
+{
+    double start = -1;
+    double end = 0;
+    EXPECT_TRUE(parseNptRange("npt=10.5-", start, end));
+    EXPECT_DOUBLE_EQ(10.5, start);
+    EXPECT_DOUBLE_EQ(-1, end);
+
+    EXPECT_TRUE(parseNptRange(" npt=0:00:30 - ", start, end));
+    EXPECT_DOUBLE_EQ(30, start);
+    EXPECT_DOUBLE_EQ(-1, end);
+}
+
+TEST(NptTest, ParsesClosedRange)
+{
+    double start = -1;
+    double end = -1;
+    EXPECT_TRUE(parseNptRange("npt=0:01:10.500-0:02:00", start, end));
+    EXPECT_DOUBLE_EQ(70.5, start);
+    EXPECT_DOUBLE_EQ(120, end);
+
+    EXPECT_TRUE(parseNptRange("npt=5-5", start, end));
+    EXPECT_DOUBLE_EQ(5, start);
+    EXPECT_DOUBLE_EQ(5, end);
+}
+
+TEST(NptTest, RejectsMalformedRange)
+{
+    double start = 0;
+    double end = 0;
+    for (const auto& range : { "", "npt=", "npt=-", "npt=-10", "npt=10", "npt=20-10", "npt=a-", "npt=1-b", "npt=1:2-", "bytes=0-100", "npt=now-", "10-20" }) {
+        EXPECT_FALSE(parseNptRange(range, start, end)) << range;
+    }
+}
+
+TEST(NptTest, FormatsSeconds)
+{
+    EXPECT_EQ("0.000", secondsToNpt(0));
+    EXPECT_EQ("10.500", secondsToNpt(10.5));
+    EXPECT_EQ("3723.250", secondsToNpt(3723.25));
+
+    double seconds = 0;
+    EXPECT_TRUE(parseNptTime(secondsToNpt(61.125), seconds));
+    EXPECT_DOUBLE_EQ(61.125, seconds);
+}
+
+TEST(NptTest, SubstitutesStartTime)
+{
+    auto args = populateCommandLine("ffmpeg -ss %start -i %in -f mp3 %out", "in.flac", "out.fifo", "", secondsToNpt(12.5));
+    std::vector<std::string> expected = { "ffmpeg", "-ss", "12.500", "-i", "in.flac", "-f", "mp3", "out.fifo" };
+    EXPECT_EQ(expected, args);
+
+    args = populateCommandLine("vlc --start-time=%start %in --sout=%out", "in.mkv", "out.fifo", "");
+    expected = { "vlc", "--start-time=0", "in.mkv", "--sout=out.fifo" };
+    EXPECT_EQ(expected, args);
+
+    args = populateCommandLine("cat %in %range", "in", "out", "100-", "12.500");
+    expected = { "cat", "in", "100-" };
+    EXPECT_EQ(expected, args);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <fstream>
+#include <thread>
+
+#include "exceptions.h"
+#include "helpers/temp_dir.h"
+#include "iohandler/mem_io_handler.h"
+#include "transcoding/transcode_scheduler.h"
+#include "transcoding/transcoding_process_executor.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+TEST(TranscodeSchedulerTest, AdmitsUpToGlobalLimit)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(2, 0, 0ms);
+
+    auto first = subject->admit("pcm", 0);
+    auto second = subject->admit("mp3", 0);
+    EXPECT_THROW(subject->admit("pcm", 0), TranscodingBusyException);
+    EXPECT_EQ(2u, subject->getJobs().size());
+
+    first = nullptr;
+    EXPECT_NO_THROW(subject->admit("pcm", 0));
+}
+
+TEST(TranscodeSchedulerTest, AdmitsUpToProfileLimit)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(0, 0, 0ms);
+
+    auto first = subject->admit("video", 1);
+    EXPECT_THROW(subject->admit("video", 1), TranscodingBusyException);
+    EXPECT_NO_THROW(subject->admit("audio", 1));
+}
+
+TEST(TranscodeSchedulerTest, QueuedRequestGetsFreedSlot)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(1, 1, 5000ms);
+    auto running = subject->admit("pcm", 0);
+
+    std::shared_ptr<TranscodeJob> queued;
+    std::thread waiter([&]() { queued = subject->admit("pcm", 0); });
+    while (subject->getQueueDepth() == 0)
+        std::this_thread::sleep_for(1ms);
+
+    // the queue is full
+    EXPECT_THROW(subject->admit("pcm", 0), TranscodingBusyException);
+
+    running = nullptr;
+    waiter.join();
+    EXPECT_NE(nullptr, queued);
+    EXPECT_EQ(0, subject->getQueueDepth());
+}
+
+TEST(TranscodeSchedulerTest, CanAdmitWhileQueueHasRoom)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(1, 1, 5000ms);
+    EXPECT_TRUE(subject->canAdmit("pcm", 0));
+    auto running = subject->admit("pcm", 0);
+    EXPECT_TRUE(subject->canAdmit("pcm", 0));
+
+    std::shared_ptr<TranscodeJob> queued;
+    std::thread waiter([&]() { queued = subject->admit("pcm", 0); });
+    while (subject->getQueueDepth() == 0)
+        std::this_thread::sleep_for(1ms);
+    EXPECT_FALSE(subject->canAdmit("pcm", 0));
+    // checking does not take a slot
+    EXPECT_EQ(1u, subject->getJobs().size());
+
+    running = nullptr;
+    waiter.join();
+    EXPECT_TRUE(subject->canAdmit("pcm", 0));
+}
+
+TEST(TranscodeSchedulerTest, QueuedRequestTimesOut)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(1, 1, 20ms);
+    auto running = subject->admit("pcm", 0);
+    EXPECT_THROW(subject->admit("pcm", 0), TranscodingBusyException);
+}
+
+TEST(TranscodeSchedulerTest, HandlerCountsBytesAndReleasesJob)
+{
+    auto subject = std::make_shared<TranscodeScheduler>(1, 0, 0ms);
+    auto source = std::make_unique<MemIOHandler>(std::string("transcoded"));
+    source->open(UPNP_READ);
+    TranscodeJobIOHandler handler(subject->admit("pcm", 0), std::move(source));
+
+    char buf[64];
+    EXPECT_EQ(10u, handler.read(buf, sizeof(buf)));
+    ASSERT_EQ(1u, subject->getJobs().size());
+    EXPECT_EQ(10, subject->getJobs()[0]->getBytes());
+
+    handler.close();
+    EXPECT_TRUE(subject->getJobs().empty());
+}
+
+// a dummy transcoder reporting the priority it runs with
+TEST(TranscodeSchedulerTest, TranscoderRunsWithConfiguredNiceness)
+{
+    ScopedTempDir dir("gerbera-nice");
+    auto path = dir / "niceness";
+
+    {
+        TranscodingProcessExecutor transcoder("/bin/sh", { "-c", "nice > " + path.string() }, 10);
+        for (int i = 0; i < 500 && transcoder.isAlive(); i++)
+            std::this_thread::sleep_for(10ms);
+    }
+
+    std::ifstream in(path);
+    int niceness = -1;
+    in >> niceness;
+    EXPECT_EQ(10, niceness);
+}
+
+// output handed to the transcoder as /dev/fd/N instead of a fifo
+TEST(TranscodeSchedulerTest, TranscoderWritesToInheritedPipe)
+{
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe2(pipeFds, O_CLOEXEC));
+
+    std::string output = "/dev/fd/" + std::to_string(pipeFds[1]);
+    TranscodingProcessExecutor transcoder("/bin/sh", { "-c", "printf transcoded > " + output }, 0, IO_CLASS_NONE, { pipeFds[1] });
+    close(pipeFds[1]);
+
+    std::string result;
+    char buf[64];
+    ssize_t bytesRead;
+    while ((bytesRead = read(pipeFds[0], buf, sizeof(buf))) > 0)
+        result.append(buf, bytesRead);
+    close(pipeFds[0]);
+
+    EXPECT_EQ("transcoded", result);
+}
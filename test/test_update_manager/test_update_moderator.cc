@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "update_manager.h"
+
+using namespace ::testing;
+
+#define MAX_EVENT_BYTES 16384
+
+/// \brief Synthetic source of container changes.
+///
+/// Produces idsPerSecond changes per second in steps of tick milliseconds
+/// and feeds them to the moderator, like an import would do.
+class ChangeGenerator {
+public:
+    ChangeGenerator(UpdateModerator& moderator, long start)
+        : moderator(moderator)
+        , now(start)
+    {
+    }
+
+    long run(double idsPerSecond, long duration, long tick = 100)
+    {
+        for (long elapsed = 0; elapsed < duration; elapsed += tick) {
+            pending += idsPerSecond * tick / 1000.0;
+            auto count = static_cast<size_t>(pending);
+            pending -= count;
+            now += tick;
+            if (count > 0)
+                moderator.recordChanges(count, now);
+        }
+        return now;
+    }
+
+    long idle(long duration)
+    {
+        now += duration;
+        return now;
+    }
+
+protected:
+    UpdateModerator& moderator;
+    long now;
+    double pending = 0;
+};
+
+class UpdateModeratorTest : public ::testing::Test {
+public:
+    UpdateModeratorTest()
+        : subject(MAX_EVENT_BYTES)
+        , generator(subject, 1000000)
+    {
+        subject.setSubscriberCount(1);
+    }
+
+    static std::string updateString(int ids)
+    {
+        std::string result;
+        for (int id = 1; id <= ids; id++) {
+            if (!result.empty())
+                result += ",";
+            result += std::to_string(id) + "," + std::to_string(id * 7);
+        }
+        return result;
+    }
+
+protected:
+    UpdateModerator subject;
+    ChangeGenerator generator;
+};
+
+TEST_F(UpdateModeratorTest, KeepsSpecIntervalWhenIdle)
+{
+    long now = generator.idle(5000);
+
+    EXPECT_EQ(subject.getFlushInterval(now), 2000);
+    EXPECT_FALSE(subject.shouldCollapse(updateString(10), now));
+}
+
+TEST_F(UpdateModeratorTest, KeepsSpecIntervalForSlowChanges)
+{
+    long now = generator.run(5, 10000);
+
+    EXPECT_NEAR(subject.getChangeRate(now), 5, 1);
+    EXPECT_EQ(subject.getFlushInterval(now), 2000);
+    EXPECT_FALSE(subject.shouldCollapse(updateString(20), now));
+}
+
+TEST_F(UpdateModeratorTest, StretchesIntervalWithChangeRate)
+{
+    long now = generator.run(100, 10000);
+
+    long interval = subject.getFlushInterval(now);
+    EXPECT_GT(interval, 2000);
+    EXPECT_LT(interval, 10000);
+    EXPECT_FALSE(subject.shouldCollapse(updateString(100), now));
+}
+
+TEST_F(UpdateModeratorTest, CollapsesUnderChurn)
+{
+    long now = generator.run(1000, 5000);
+
+    EXPECT_EQ(subject.getFlushInterval(now), 10000);
+    EXPECT_TRUE(subject.shouldCollapse(updateString(10), now));
+}
+
+TEST_F(UpdateModeratorTest, DetectsBurstWithinFirstWindow)
+{
+    long now = generator.run(5000, 200);
+
+    EXPECT_TRUE(subject.shouldCollapse(updateString(10), now));
+}
+
+TEST_F(UpdateModeratorTest, RecoversAfterChurn)
+{
+    generator.run(1000, 5000);
+    long now = generator.idle(15000);
+
+    EXPECT_LT(subject.getChangeRate(now), 1);
+    EXPECT_EQ(subject.getFlushInterval(now), 2000);
+    EXPECT_FALSE(subject.shouldCollapse(updateString(10), now));
+}
+
+TEST_F(UpdateModeratorTest, CollapsesOversizedEvents)
+{
+    long now = generator.idle(5000);
+    std::string update = updateString(2000);
+    ASSERT_GT(update.length(), MAX_EVENT_BYTES);
+
+    EXPECT_TRUE(subject.shouldCollapse(update, now));
+}
+
+TEST_F(UpdateModeratorTest, LimitsPendingIDsBySizeCap)
+{
+    size_t maxIDs = subject.getMaxObjectIDs();
+
+    EXPECT_GT(maxIDs, 0);
+    EXPECT_LE(maxIDs * 2, MAX_EVENT_BYTES);
+}
+
+TEST_F(UpdateModeratorTest, StretchesIntervalWithSubscribers)
+{
+    long now = generator.idle(5000);
+    long single = subject.getFlushInterval(now);
+
+    subject.setSubscriberCount(8);
+    long many = subject.getFlushInterval(now);
+    EXPECT_GT(many, single);
+
+    subject.setSubscriberCount(1000);
+    EXPECT_EQ(subject.getFlushInterval(now), 10000);
+}
+
+TEST_F(UpdateModeratorTest, AccountsEvents)
+{
+    subject.eventSent(10, 40, false);
+    subject.eventSent(0, 0, true);
+    subject.idsCoalesced(5);
+
+    auto stats = subject.getStats();
+    EXPECT_EQ(stats.eventsSent, 2);
+    EXPECT_EQ(stats.eventsCollapsed, 1);
+    EXPECT_EQ(stats.idsSent, 10);
+    EXPECT_EQ(stats.idsCoalesced, 5);
+    EXPECT_EQ(stats.bytesSent, 40);
+}
@@ -90,7 +90,7 @@ TEST_F(UpnpXmlTest, CreatesSecCaptionInfoElement)
 {
     pugi::xml_document doc;
     auto container = doc.append_child("container");
-    subject->renderCaptionInfo("file.srt", &container);
+    subject->renderCaptionInfo("file.avi", ".srt", &container);
     auto result = container.first_child();
 
     EXPECT_NE(result, nullptr);
@@ -99,6 +99,17 @@ TEST_F(UpnpXmlTest, CreatesSecCaptionInfoElement)
     EXPECT_STREQ(result.attribute("sec:type").as_string(), "srt");
 }
 
+TEST_F(UpnpXmlTest, CreatesSecCaptionInfoElementForSubtitleType)
+{
+    pugi::xml_document doc;
+    auto container = doc.append_child("container");
+    subject->renderCaptionInfo("file.mkv", ".smi", &container);
+    auto result = container.first_child();
+
+    EXPECT_STREQ(result.text().as_string(), "file.smi");
+    EXPECT_STREQ(result.attribute("sec:type").as_string(), "smi");
+}
+
 TEST_F(UpnpXmlTest, CreatesEventPropertySet)
 {
     auto result = subject->createEventPropertySet();
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+
+#include "web/response_writer.h"
+
+using namespace ::testing;
+using namespace web;
+
+// same calls as web::items::process() for a listing of count items
+static void writeItems(ResponseWriter* writer, int count)
+{
+    writer->beginObject("items");
+    writer->add("parent_id", 7443);
+    writer->add("location", "/Video/Directories/video/Test");
+    writer->add("virtual", true);
+    writer->add("start", 0);
+    writer->add("total_matches", count);
+    writer->add("autoscan_mode", "none");
+    writer->add("protect_items", false);
+    writer->beginArray("item");
+    for (int id = 0; id < count; id++) {
+        writer->beginObject();
+        writer->add("id", id);
+        writer->add("title", "Test" + std::to_string(id) + ".mp4");
+        writer->add("res", "http://localhost:49152/content/media/object_id/" + std::to_string(id) + "/res_id/0");
+        writer->endObject();
+    }
+    writer->endArray();
+    writer->endObject();
+}
+
+static std::string viaXml2Json(const std::function<void(ResponseWriter*)>& write)
+{
+    pugi::xml_document doc;
+    auto root = doc.append_child("root");
+    auto hints = std::make_shared<Xml2Json::Hints>();
+    XmlResponseWriter writer(root, hints);
+    write(&writer);
+    return Xml2Json::getJson(root, hints.get());
+}
+
+static std::string viaJsonWriter(const std::function<void(ResponseWriter*)>& write)
+{
+    JsonResponseWriter writer;
+    write(&writer);
+    return writer.getJson();
+}
+
+TEST(ResponseWriterTest, JsonMatchesXml2Json)
+{
+    auto write = [](ResponseWriter* writer) {
+        writer->add("success", true);
+        writeItems(writer, 3);
+        writer->beginObject("update_ids");
+        writer->add("pending", false);
+        writer->endObject();
+    };
+
+    EXPECT_EQ(viaXml2Json(write), viaJsonWriter(write));
+    EXPECT_EQ(R"({"success":true,"items":{"parent_id":7443,"location":"/Video/Directories/video/Test","virtual":true,)"
+              R"("start":0,"total_matches":3,"autoscan_mode":"none","protect_items":false,"item":[)"
+              R"({"id":0,"title":"Test0.mp4","res":"http://localhost:49152/content/media/object_id/0/res_id/0"},)"
+              R"({"id":1,"title":"Test1.mp4","res":"http://localhost:49152/content/media/object_id/1/res_id/0"},)"
+              R"({"id":2,"title":"Test2.mp4","res":"http://localhost:49152/content/media/object_id/2/res_id/0"}]},)"
+              R"("update_ids":{"pending":false}})",
+        viaJsonWriter(write));
+}
+
+TEST(ResponseWriterTest, EmptyArray)
+{
+    auto write = [](ResponseWriter* writer) { writeItems(writer, 0); };
+
+    EXPECT_EQ(viaXml2Json(write), viaJsonWriter(write));
+}
+
+TEST(ResponseWriterTest, TypesStringValuesLikeXml2Json)
+{
+    auto write = [](ResponseWriter* writer) {
+        writer->add("id", std::string("42"));
+        writer->add("offset", "-7");
+        writer->add("enabled", std::string("true"));
+        writer->add("hidden", "false");
+        writer->add("minus", "-");
+        writer->add("empty", "");
+        writer->add("version", "1.2");
+        writer->add("title", "True");
+    };
+
+    EXPECT_EQ(viaXml2Json(write), viaJsonWriter(write));
+    EXPECT_EQ(R"({"id":42,"offset":-7,"enabled":true,"hidden":false,"minus":"-","empty":"","version":"1.2","title":"True"})",
+        viaJsonWriter(write));
+}
+
+TEST(ResponseWriterTest, EscapesStrings)
+{
+    JsonResponseWriter writer;
+    writer.add("title", "say \"hi\"\\\n\t\x01");
+
+    EXPECT_EQ(R"({"title":"say \"hi\"\\\n\t\u0001"})", writer.getJson());
+}
+
+TEST(ResponseWriterTest, EndAllClosesOpenScopes)
+{
+    JsonResponseWriter writer;
+    writer.beginObject("items");
+    writer.beginArray("item");
+    writer.beginObject();
+    writer.add("id", 1);
+
+    writer.endAll();
+    writer.add("success", false);
+
+    EXPECT_EQ(R"({"items":{"item":[{"id":1}]},"success":false})", writer.getJson());
+}
+
+TEST(ResponseWriterTest, ThrowsOnUnbalancedScopes)
+{
+    JsonResponseWriter writer;
+    writer.beginArray("item");
+
+    EXPECT_THROW(writer.endObject(), std::runtime_error);
+}
+
+// run with --gtest_also_run_disabled_tests, compares building a listing as
+// xml document converted by Xml2Json with writing the JSON directly
+TEST(ResponseWriterTest, DISABLED_BenchmarkItemListing)
+{
+    const int count = 5000;
+    const int runs = 20;
+    auto write = [count](ResponseWriter* writer) { writeItems(writer, count); };
+
+    size_t length = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+        length += viaXml2Json(write).length();
+    std::chrono::duration<double> xml = std::chrono::steady_clock::now() - started;
+
+    started = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+        length -= viaJsonWriter(write).length();
+    std::chrono::duration<double> json = std::chrono::steady_clock::now() - started;
+
+    EXPECT_EQ(0u, length);
+    std::cout << count << " items, xml and Xml2Json: " << xml.count() * 1e3 / runs << "ms, "
+              << "JsonResponseWriter: " << json.count() * 1e3 / runs << "ms" << std::endl;
+}
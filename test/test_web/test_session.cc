@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <thread>
+
+#include "util/lock_free_queue.h"
+#include "web/session_manager.h"
+
+#include "helpers/test_server.h"
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class TestSession : public web::Session {
+public:
+    TestSession()
+        : web::Session(60)
+    {
+    }
+
+    using web::Session::containerChangedUI;
+    using web::Session::MAX_UI_UPDATE_IDS;
+};
+
+TEST(SessionTest, RemembersEachContainerOnce)
+{
+    TestSession subject;
+    subject.containerChangedUI(std::vector<int> { 3, 5, 3 });
+    subject.containerChangedUI(5);
+
+    EXPECT_EQ("3,5", subject.getUIUpdateIDs());
+    EXPECT_FALSE(subject.hasUIUpdateIDs());
+    EXPECT_EQ("", subject.getUIUpdateIDs());
+}
+
+TEST(SessionTest, TooManyChangesUpdateAll)
+{
+    TestSession subject;
+    for (int id = 0; id <= static_cast<int>(TestSession::MAX_UI_UPDATE_IDS); id++)
+        subject.containerChangedUI(id);
+    subject.containerChangedUI(42);
+
+    EXPECT_EQ("all", subject.getUIUpdateIDs());
+    EXPECT_FALSE(subject.hasUIUpdateIDs());
+}
+
+// at most two requests wait for ui update ids at the same time
+static void limitLongPolls(pugi::xml_node& root)
+{
+    root.child("server").child("ui").append_attribute("max-long-polls") = 2;
+}
+
+class TestSessionManager : public web::SessionManager {
+public:
+    using web::SessionManager::SessionManager;
+
+    using web::SessionManager::getShard;
+    using web::SessionManager::SESSION_SHARDS;
+
+    int getWaitingRequests() const { return waitingRequests; }
+};
+
+class SessionManagerTest : public ::testing::Test {
+protected:
+    SessionManagerTest()
+        : server(limitLongPolls)
+        , subject(server.getConfig(), std::make_shared<Timer>())
+    {
+    }
+
+    std::shared_ptr<web::Session> createSession()
+    {
+        auto session = subject.createSession(60);
+        session->logIn();
+        return session;
+    }
+
+    // waits for the session in another thread, join() returns what
+    // waitForUIUpdateIDs() returned
+    class Waiter {
+    public:
+        Waiter(TestSessionManager& manager, std::shared_ptr<web::Session> session)
+            : started(std::chrono::steady_clock::now())
+            , thread([this, &manager, session]() { waited = manager.waitForUIUpdateIDs(session, 10s); })
+        {
+        }
+
+        bool join()
+        {
+            thread.join();
+            EXPECT_LT(std::chrono::steady_clock::now() - started, 5s);
+            return waited;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point started;
+        bool waited = false;
+        std::thread thread;
+    };
+
+    // blocks until the given number of requests is waiting
+    void awaitWaitingRequests(int count)
+    {
+        while (subject.getWaitingRequests() < count)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    TestServer server;
+    TestSessionManager subject;
+};
+
+TEST_F(SessionManagerTest, DispatchesToSessionsInAllShards)
+{
+    std::set<const void*> shards;
+    std::vector<std::shared_ptr<web::Session>> sessions;
+    while (shards.size() < TestSessionManager::SESSION_SHARDS) {
+        sessions.push_back(createSession());
+        shards.insert(&subject.getShard(sessions.back()->getID()));
+    }
+    auto loggedOut = subject.createSession(60);
+
+    subject.containerChangedUI(std::vector<int> { 3, 5 });
+    subject.containerChangedUI(3);
+    subject.dispatchUIUpdates();
+
+    for (const auto& session : sessions)
+        EXPECT_EQ("3,5", session->getUIUpdateIDs());
+    EXPECT_FALSE(loggedOut->hasUIUpdateIDs());
+
+    // the queue is empty after dispatching
+    subject.dispatchUIUpdates();
+    EXPECT_FALSE(sessions.front()->hasUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, TooManyChangesUpdateAll)
+{
+    auto session = createSession();
+    for (int id = 1; id <= static_cast<int>(TestSession::MAX_UI_UPDATE_IDS) + 1; id++)
+        subject.containerChangedUI(id);
+    subject.dispatchUIUpdates();
+
+    EXPECT_EQ("all", session->getUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, QueueOverflowUpdatesAll)
+{
+    auto session = createSession();
+    // more changes than the queue holds until the next request
+    for (int i = 0; i < 10000; i++)
+        subject.containerChangedUI(i % 5 + 1);
+    subject.dispatchUIUpdates();
+
+    EXPECT_EQ("all", session->getUIUpdateIDs());
+
+    // the next changes are dispatched one by one again
+    subject.containerChangedUI(7);
+    subject.dispatchUIUpdates();
+    EXPECT_EQ("7", session->getUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, WaitTimesOutWithoutChanges)
+{
+    auto session = createSession();
+
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_TRUE(subject.waitForUIUpdateIDs(session, 100ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - started, 100ms);
+    EXPECT_FALSE(session->hasUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, ContainerChangeWakesWaitingRequest)
+{
+    auto session = createSession();
+
+    Waiter waiter(subject, session);
+    awaitWaitingRequests(1);
+    subject.containerChangedUI(42);
+
+    EXPECT_TRUE(waiter.join());
+    EXPECT_EQ("42", session->getUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, PendingChangesReturnRightAway)
+{
+    auto session = createSession();
+    subject.containerChangedUI(std::vector<int> { 1, 2 });
+
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_TRUE(subject.waitForUIUpdateIDs(session, 10s));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 5s);
+    EXPECT_EQ("1,2", session->getUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, RemovingSessionWakesWaitingRequest)
+{
+    auto session = createSession();
+    auto other = createSession();
+
+    Waiter waiter(subject, session);
+    Waiter otherWaiter(subject, other);
+    awaitWaitingRequests(2);
+    subject.removeSession(session->getID());
+
+    EXPECT_TRUE(waiter.join());
+    EXPECT_TRUE(session->isInterrupted());
+    EXPECT_EQ(nullptr, subject.getSession(session->getID()));
+
+    // the other session keeps waiting
+    EXPECT_EQ(1, subject.getWaitingRequests());
+    subject.containerChangedUI(42);
+    EXPECT_TRUE(otherWaiter.join());
+    EXPECT_EQ("42", other->getUIUpdateIDs());
+}
+
+TEST_F(SessionManagerTest, ShutdownWakesWaitingRequests)
+{
+    auto session = createSession();
+    auto other = createSession();
+
+    Waiter waiter(subject, session);
+    Waiter otherWaiter(subject, other);
+    awaitWaitingRequests(2);
+    subject.shutdown();
+
+    EXPECT_TRUE(waiter.join());
+    EXPECT_TRUE(otherWaiter.join());
+
+    // later requests do not wait at all
+    EXPECT_FALSE(subject.waitForUIUpdateIDs(session, 10s));
+}
+
+TEST_F(SessionManagerTest, LimitsWaitingRequests)
+{
+    auto session = createSession();
+
+    Waiter first(subject, session);
+    Waiter second(subject, session);
+    awaitWaitingRequests(2);
+
+    // the limit is reached, the request is answered right away
+    EXPECT_FALSE(subject.waitForUIUpdateIDs(session, 10s));
+    EXPECT_EQ(2, subject.getWaitingRequests());
+
+    subject.containerChangedUI(42);
+    EXPECT_TRUE(first.join());
+    EXPECT_TRUE(second.join());
+    EXPECT_EQ(0, subject.getWaitingRequests());
+
+    // waiting is possible again
+    EXPECT_TRUE(subject.waitForUIUpdateIDs(session, 10ms));
+}
+
+TEST(LockFreeQueueTest, RejectsPushWhenFull)
+{
+    LockFreeQueue<int> subject(4);
+    for (int i = 0; i < 4; i++)
+        EXPECT_TRUE(subject.push(i));
+    EXPECT_FALSE(subject.push(4));
+
+    int value;
+    EXPECT_TRUE(subject.pop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(subject.push(4));
+    for (int i = 1; i <= 4; i++) {
+        EXPECT_TRUE(subject.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(subject.pop(value));
+}
+
+TEST(LockFreeQueueTest, ConcurrentProducers)
+{
+    const int producers = 4;
+    const int count = 50000;
+    LockFreeQueue<int> subject(1024);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&subject, p]() {
+            for (int i = 0; i < count; i++) {
+                while (!subject.push(p * count + i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // values of each producer arrive in order
+    std::vector<int> last(producers, -1);
+    std::set<int> seen;
+    int value;
+    while (seen.size() < static_cast<size_t>(producers * count)) {
+        if (!subject.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_GT(value % count, last[value / count]);
+        last[value / count] = value % count;
+        seen.insert(value);
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_FALSE(subject.pop(value));
+}
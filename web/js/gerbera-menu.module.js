@@ -22,11 +22,13 @@
 */
 
 import {Items} from "./gerbera-items.module.js";
+import {Streams} from "./gerbera-streams.module.js";
 import {GerberaApp} from "./gerbera-app.module.js";
 import {Trail} from "./gerbera-trail.module.js";
 import {Tree} from "./gerbera-tree.module.js";
 
 const disable = () => {
+  Streams.stop();
   const allLinks = $('nav li a');
   $('.nav li').removeClass('active');
   allLinks.addClass('disabled');
@@ -69,6 +71,7 @@ const initialize = () => {
 };
 
 const selectType = (menuItem) => {
+  Streams.stop();
   $('#home').hide();
   $('#content').show();
   const type = menuItem.data('gerbera-type');
@@ -102,6 +105,7 @@ var home = function () {
   Tree.destroy();
   Trail.destroy();
   Items.destroy();
+  Streams.start();
 };
 
 
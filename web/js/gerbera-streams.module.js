@@ -0,0 +1,97 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    gerbera-streams.module.js - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+import {Auth} from './gerbera-auth.module.js';
+import {GerberaApp} from './gerbera-app.module.js';
+
+let STREAMS_INTERVAL;
+
+const formatRate = (bytesPerSecond) => {
+  return (bytesPerSecond * 8 / 1000000).toFixed(1) + ' Mbit/s';
+};
+
+const formatBytes = (bytes) => {
+  return (bytes / (1024 * 1024)).toFixed(1) + ' MiB';
+};
+
+const loadStreams = () => {
+  if (GerberaApp.isLoggedIn()) {
+    return $.ajax({
+      url: GerberaApp.clientConfig.api,
+      type: 'get',
+      data: {
+        req_type: 'streams',
+        sid: Auth.getSessionId()
+      }
+    })
+      .then((response) => Streams.showStreams(response))
+      .catch((err) => GerberaApp.error(err));
+  } else {
+    return Promise.resolve();
+  }
+};
+
+const showStreams = (response) => {
+  const streamsEl = $('#streams');
+  const rows = streamsEl.find('tbody');
+  rows.empty();
+
+  const streams = (response.success && response.streams) ? response.streams.stream : [];
+  if (streams && streams.length > 0) {
+    for (let i = 0; i < streams.length; i++) {
+      const stream = streams[i];
+      const row = $('<tr></tr>');
+      row.append($('<td></td>').text(stream.client));
+      row.append($('<td></td>').text(stream.name));
+      row.append($('<td></td>').text(formatBytes(stream.bytes)));
+      row.append($('<td></td>').text(formatRate(stream.rate)));
+      rows.append(row);
+    }
+    streamsEl.show();
+  } else {
+    streamsEl.hide();
+  }
+  return Promise.resolve(response);
+};
+
+const start = () => {
+  if (!STREAMS_INTERVAL) {
+    Streams.loadStreams();
+    STREAMS_INTERVAL = window.setInterval(() => {
+      Streams.loadStreams();
+    }, GerberaApp.serverConfig['poll-interval']);
+  }
+};
+
+const stop = () => {
+  if (STREAMS_INTERVAL) {
+    window.clearInterval(STREAMS_INTERVAL);
+    STREAMS_INTERVAL = false;
+  }
+};
+
+export const Streams = {
+  loadStreams,
+  showStreams,
+  start,
+  stop,
+};
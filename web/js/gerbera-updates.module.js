@@ -26,10 +26,12 @@ import {Tree} from "./gerbera-tree.module.js";
 
 let POLLING_INTERVAL;
 let UI_TIMEOUT;
+let LONG_POLL;
 
 const initialize = () => {
   $('#toast').toast();
   $(document).ajaxComplete(errorCheck);
+  Updates.waitForUpdates();
   return Promise.resolve();
 };
 
@@ -93,6 +95,43 @@ const getUpdates = (force) => {
   }
 };
 
+// keeps one request open, the server answers it when a container changes
+const waitForUpdates = () => {
+  const timeout = GerberaApp.serverConfig ? GerberaApp.serverConfig['long-poll-timeout'] : 0;
+  if (!timeout || LONG_POLL || !GerberaApp.isLoggedIn()) {
+    return Promise.resolve();
+  }
+
+  LONG_POLL = true;
+  return $.ajax({
+    url: GerberaApp.clientConfig.api,
+    type: 'get',
+    timeout: (timeout + 10) * 1000,
+    data: {
+      req_type: 'void',
+      sid: Auth.getSessionId(),
+      updates: 'wait'
+    }
+  })
+    .then((response) => {
+      LONG_POLL = false;
+      if (response.success) {
+        if (GerberaApp.getType() === 'db') {
+          Updates.updateTreeByIds(response);
+        }
+        // answered right away when too many requests wait on the server
+        const busy = response.update_ids && response.update_ids.pending !== undefined;
+        window.setTimeout(Updates.waitForUpdates, busy ? GerberaApp.serverConfig['poll-interval'] : 0);
+      }
+      return response;
+    })
+    .catch((response) => {
+      LONG_POLL = false;
+      window.setTimeout(Updates.waitForUpdates, GerberaApp.serverConfig['poll-interval']);
+      return response;
+    });
+};
+
 const updateTask = (response) => {
   let promise;
   if (response.success) {
@@ -215,6 +254,7 @@ export const Updates = {
   updateTask,
   updateTreeByIds,
   updateUi,
+  waitForUpdates,
   POLLING_INTERVAL,
   UI_TIMEOUT
 };